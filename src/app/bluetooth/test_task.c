@@ -17,6 +17,15 @@ History:
 Date           Author       Notes
 ----------     -------      -------------------------
 2015-3-15      deeve        Create
+2026-10-19     deeve        Add semaphore vs message benchmark
+2026-10-19     deeve        Add seqlock vs critical section benchmark
+2026-10-19     deeve        Add malloc per block size benchmark
+2026-10-19     deeve        Compare buddy pool with fixed block size pool
+2026-10-19     deeve        Add ipc nested donation test
+2026-10-19     deeve        Scale seqlock benchmark to timestamp resolution
+2026-10-19     deeve        Measure malloc fallback with smaller block sizes held
+2026-10-19     deeve        Measure semaphore and message wakeup of a pending task
+2026-10-19     deeve        Measure malloc of the block size selected to buddy pool
 
 *******************************************************************************/
 
@@ -30,6 +39,20 @@ Date           Author       Notes
 /******************************************************************************
  *                                 Defines                                    *
  ******************************************************************************/
+#define TEST_BENCH_FAST_LOOPS   (100000)  /*timestamp is about 25KHz, sub-us operations need many loops*/
+#define TEST_BENCH_WAKE_LOOPS   (10000)   /*each loop wakes up two tasks and switches twice*/
+#define TEST_BENCH_WAKE_PRIORITY (31)     /*helper task which is woken up by benchmark*/
+#define TEST_BENCH_WAKE_STACK_LEN (1024)
+#define TEST_BENCH_MIN_BLK_SIZE (8)       /*the smallest block size of memory pool in main.c*/
+#define TEST_BENCH_MAX_BLK_SIZE (4096)    /*the largest block size of memory pool in main.c*/
+#define TEST_BENCH_DRAIN_BLK_SIZE (2048)  /*the smaller block sizes are held to measure fallback*/
+#define TEST_BENCH_BURST_NUM    (64)
+
+/*ipc server and two clients, higher than all the other tasks*/
+#define TEST_IPC_SERVER_PRIORITY   (28)
+#define TEST_IPC_CLIENT_A_PRIORITY (29)
+#define TEST_IPC_CLIENT_B_PRIORITY (30)
+#define TEST_IPC_STACK_LEN         (1024)
 
 /******************************************************************************
  *                                 Global Variables                           *
@@ -39,10 +62,138 @@ extern void count_to_delay(u32 val);
  *                                 Local Variables                            *
  ******************************************************************************/
 
+/*two word state read by benchmark*/
+static volatile u32 _test_bench_lo;
+static volatile u32 _test_bench_hi;
+static etos_seqlock_t _test_bench_seqlock = ETOS_SEQLOCK_INITIALIZER;
+
+/*buffers of buddy pool burst*/
+static void *_test_bench_bufs[TEST_BENCH_BURST_NUM];
+
+/*ping is given by benchmark and taken by helper task, pong is the way back*/
+static etos_sem_handle _test_bench_sem_ping;
+static etos_sem_handle _test_bench_sem_pong;
+static etos_msg_handle _test_bench_msgq_ping;
+static etos_msg_handle _test_bench_msgq_pong;
+
+static etos_ipc_handle _test_ipc_handle;
+static u32 _test_ipc_err_cnt;
+
 /******************************************************************************
  *                                 Local Functions                            *
  ******************************************************************************/
 
+/*cost of one operation in ns, loops is a multiple of 1000*/
+static u32 _test_bench_ns_per_op(u32 ts, u32 loops)
+{
+    return etos_sched_timestamp_to_us(ts) / (loops / 1000);
+}
+
+
+/*pending in take/recv until the benchmark wakes it up, then wake the benchmark up*/
+static void *_test_bench_wake_main(void *arg)
+{
+    u32 i;
+    u8 *msg_buf;
+    arg = arg;
+
+    for (i = 0; i < TEST_BENCH_WAKE_LOOPS; i++) {
+        etos_sem_take(_test_bench_sem_ping, ETOS_WAIT_FOREVER);
+        etos_sem_give(_test_bench_sem_pong);
+    }
+
+    for (i = 0; i < TEST_BENCH_WAKE_LOOPS; i++) {
+        etos_msgq_recv(_test_bench_msgq_ping, &msg_buf, NULL);
+        etos_msgq_release_buf(_test_bench_msgq_ping, msg_buf);
+        msg_buf = etos_msgq_get_buf(_test_bench_msgq_pong, 4);
+        etos_msgq_send(_test_bench_msgq_pong, msg_buf);
+    }
+
+    return (void *)0;
+}
+
+
+/*the task must be back at its own priority when the ipc is finished*/
+static void _test_ipc_check_priority(const char *who)
+{
+    etos_tcb_t *pt_os_task_tcb = (etos_tcb_t *)etos_sched_get_current_task();
+
+    if (pt_os_task_tcb->priority != pt_os_task_tcb->base_priority) {
+        _test_ipc_err_cnt++;
+        xloge(LOG_MODULE_T_TASK, "ipc: %s priority:%d base:%d\r\n",
+              who, pt_os_task_tcb->priority, pt_os_task_tcb->base_priority);
+    }
+}
+
+
+static void *_test_ipc_client_main(void *arg)
+{
+    s32 ret;
+    u32 req = (u32)arg;
+
+    ret = etos_ipc_call(_test_ipc_handle, &req, sizeof(req), NULL, NULL);
+    if (ret != ETOS_RET_OK) {
+        _test_ipc_err_cnt++;
+        xloge(LOG_MODULE_T_TASK, "ipc: client %d call err:%d\r\n", req, ret);
+    }
+
+    _test_ipc_check_priority((req == TEST_IPC_CLIENT_A_PRIORITY) ? "client A" : "client B");
+
+    return (void *)0;
+}
+
+
+/*
+ * receive A then B, so B is donated on top of A, and reply A first.
+ * the clients run at higher priority once they are replied, so they finish before the server reports
+ */
+static void *_test_ipc_server_main(void *arg)
+{
+    s32 ret;
+    const void *req;
+    etos_task_handle task_handle;
+    etos_task_handle client_a = 0;
+    etos_task_handle client_b = 0;
+    arg = arg;
+
+    ret = etos_task_create("IPCA", TEST_IPC_CLIENT_A_PRIORITY, _test_ipc_client_main,
+                           (void *)TEST_IPC_CLIENT_A_PRIORITY, TEST_IPC_STACK_LEN, &task_handle);
+    if (ret == ETOS_RET_OK) {
+        ret = etos_ipc_receive(_test_ipc_handle, &client_a, &req, NULL, ETOS_WAIT_FOREVER);
+    }
+
+    if (ret == ETOS_RET_OK) {
+        ret = etos_task_create("IPCB", TEST_IPC_CLIENT_B_PRIORITY, _test_ipc_client_main,
+                               (void *)TEST_IPC_CLIENT_B_PRIORITY, TEST_IPC_STACK_LEN, &task_handle);
+    }
+
+    if (ret == ETOS_RET_OK) {
+        ret = etos_ipc_receive(_test_ipc_handle, &client_b, &req, NULL, ETOS_WAIT_FOREVER);
+    }
+
+    if (ret == ETOS_RET_OK) {
+        ret = etos_ipc_reply(_test_ipc_handle, client_a, ETOS_RET_OK, NULL, 0);
+    }
+
+    if (ret == ETOS_RET_OK) {
+        ret = etos_ipc_reply(_test_ipc_handle, client_b, ETOS_RET_OK, NULL, 0);
+    }
+
+    if (ret != ETOS_RET_OK) {
+        _test_ipc_err_cnt++;
+        xloge(LOG_MODULE_T_TASK, "ipc: server err:%d\r\n", ret);
+    }
+
+    _test_ipc_check_priority("server");
+
+    etos_ipc_destroy(_test_ipc_handle);
+    _test_ipc_handle = 0;
+
+    xlogt(LOG_MODULE_T_TASK, "ipc donate test: %s\r\n", _test_ipc_err_cnt ? "FAIL" : "PASS");
+
+    return (void *)0;
+}
+
 /******************************************************************************
  *                                 Global Functions                           *
  ******************************************************************************/
@@ -78,5 +229,286 @@ void *task_test_main(void *arg)
 }
 
 
+
+/*
+ * signal path cost: ISR side (give/send in disable interrupt context) + task side (take/recv)
+ * no task is woken up first, so the context switch is not included.
+ * then a helper task is pending in take/recv, each loop gives it in disable interrupt context,
+ * and waits its answer, so the cost includes waking up the pending task and the context switch
+ */
+void task_test_sem_bench(void)
+{
+    s32 ret;
+    u32 i, ts_begin, ts_msgq, ts_sem, ts_msgq_wake, ts_sem_wake, freq;
+    u8 *msg_buf;
+    etos_msg_handle msg_handle;
+    etos_sem_handle sem_handle;
+    etos_task_handle task_handle;
+    etos_init_critical();
+
+    if (etos_msgq_create(0, &msg_handle)) {
+        xloge(LOG_MODULE_T_TASK, "bench: create msgq fail\r\n");
+        return;
+    }
+
+    if (etos_sem_create(0, 1, &sem_handle)) {
+        etos_msgq_destroy(msg_handle);
+        xloge(LOG_MODULE_T_TASK, "bench: create sem fail\r\n");
+        return;
+    }
+
+    ts_begin = etos_sched_get_timestamp();
+    for (i = 0; i < TEST_BENCH_FAST_LOOPS; i++) {
+        msg_buf = etos_msgq_get_buf(msg_handle, 4);
+        etos_enter_critical();
+        etos_msgq_send_idic(msg_handle, msg_buf);
+        etos_exit_critical();
+        etos_msgq_recv_no_block(msg_handle, &msg_buf, NULL);
+        etos_msgq_release_buf(msg_handle, msg_buf);
+    }
+    ts_msgq = etos_sched_get_timestamp() - ts_begin;
+
+    ts_begin = etos_sched_get_timestamp();
+    for (i = 0; i < TEST_BENCH_FAST_LOOPS; i++) {
+        etos_enter_critical();
+        etos_sem_give_idic(sem_handle);
+        etos_exit_critical();
+        etos_sem_take(sem_handle, 0);
+    }
+    ts_sem = etos_sched_get_timestamp() - ts_begin;
+
+    etos_sem_destroy(sem_handle);
+    etos_msgq_destroy(msg_handle);
+
+    freq = etos_sched_get_timestamp_freq();
+    xlogt(LOG_MODULE_T_TASK, "bench %d loops: msgq:%d sem:%d (timestamp %dHz) msgq/sem:%d per op(ns) msgq:%d sem:%d\r\n",
+          TEST_BENCH_FAST_LOOPS, ts_msgq, ts_sem, freq, ts_sem ? (ts_msgq / ts_sem) : 0,
+          _test_bench_ns_per_op(ts_msgq, TEST_BENCH_FAST_LOOPS),
+          _test_bench_ns_per_op(ts_sem, TEST_BENCH_FAST_LOOPS));
+
+    ret = etos_sem_create(0, 1, &_test_bench_sem_ping);
+    ret += etos_sem_create(0, 1, &_test_bench_sem_pong);
+    ret += etos_msgq_create(0, &_test_bench_msgq_ping);
+    ret += etos_msgq_create(0, &_test_bench_msgq_pong);
+    if (ret == ETOS_RET_OK) {
+        /*it runs when the benchmark pending first time, and pends in take*/
+        ret = etos_task_create("WAKE", TEST_BENCH_WAKE_PRIORITY, _test_bench_wake_main, NULL,
+                               TEST_BENCH_WAKE_STACK_LEN, &task_handle);
+    }
+
+    if (ret == ETOS_RET_OK) {
+        ts_begin = etos_sched_get_timestamp();
+        for (i = 0; i < TEST_BENCH_WAKE_LOOPS; i++) {
+            etos_enter_critical();
+            etos_sem_give_idic(_test_bench_sem_ping);
+            etos_exit_critical();
+            etos_sem_take(_test_bench_sem_pong, ETOS_WAIT_FOREVER);
+        }
+        ts_sem_wake = etos_sched_get_timestamp() - ts_begin;
+
+        ts_begin = etos_sched_get_timestamp();
+        for (i = 0; i < TEST_BENCH_WAKE_LOOPS; i++) {
+            msg_buf = etos_msgq_get_buf(_test_bench_msgq_ping, 4);
+            etos_enter_critical();
+            etos_msgq_send_idic(_test_bench_msgq_ping, msg_buf);
+            etos_exit_critical();
+            etos_msgq_recv(_test_bench_msgq_pong, &msg_buf, NULL);
+            etos_msgq_release_buf(_test_bench_msgq_pong, msg_buf);
+        }
+        ts_msgq_wake = etos_sched_get_timestamp() - ts_begin;
+
+        /*the helper is higher priority, it has returned after its last answer*/
+        xlogt(LOG_MODULE_T_TASK, "bench %d wakeup loops: msgq:%d sem:%d (timestamp %dHz) per round trip(ns) msgq:%d sem:%d\r\n",
+              TEST_BENCH_WAKE_LOOPS, ts_msgq_wake, ts_sem_wake, freq,
+              _test_bench_ns_per_op(ts_msgq_wake, TEST_BENCH_WAKE_LOOPS),
+              _test_bench_ns_per_op(ts_sem_wake, TEST_BENCH_WAKE_LOOPS));
+    } else {
+        xloge(LOG_MODULE_T_TASK, "bench: create wakeup helper err:%d\r\n", ret);
+    }
+
+    etos_sem_destroy(_test_bench_sem_ping);
+    etos_sem_destroy(_test_bench_sem_pong);
+    etos_msgq_destroy(_test_bench_msgq_ping);
+    etos_msgq_destroy(_test_bench_msgq_pong);
+    _test_bench_sem_ping = 0;
+    _test_bench_sem_pong = 0;
+    _test_bench_msgq_ping = 0;
+    _test_bench_msgq_pong = 0;
+}
+
+
+/*
+ * reader cost of a two word state: seqlock read vs disable/enable interrupt
+ * the 64 bit tick reader is measured too, it is the seqlock reader of the system tick
+ */
+void task_test_seqlock_bench(void)
+{
+    u32 i, sequence, lo, hi, sum, ts_begin, ts_seqlock, ts_critical, ts_tick64, freq;
+    u64 tick64 = 0;
+    etos_init_critical();
+
+    sum = 0;
+    ts_begin = etos_sched_get_timestamp();
+    for (i = 0; i < TEST_BENCH_FAST_LOOPS; i++) {
+        do {
+            sequence = etos_seqlock_read_begin(&_test_bench_seqlock);
+            lo = _test_bench_lo;
+            hi = _test_bench_hi;
+        } while (etos_seqlock_read_retry(&_test_bench_seqlock, sequence));
+        sum += lo + hi;
+    }
+    ts_seqlock = etos_sched_get_timestamp() - ts_begin;
+
+    ts_begin = etos_sched_get_timestamp();
+    for (i = 0; i < TEST_BENCH_FAST_LOOPS; i++) {
+        etos_enter_critical();
+        lo = _test_bench_lo;
+        hi = _test_bench_hi;
+        etos_exit_critical();
+        sum += lo + hi;
+    }
+    ts_critical = etos_sched_get_timestamp() - ts_begin;
+
+    ts_begin = etos_sched_get_timestamp();
+    for (i = 0; i < TEST_BENCH_FAST_LOOPS; i++) {
+        tick64 = etos_sched_get_tick64();
+    }
+    ts_tick64 = etos_sched_get_timestamp() - ts_begin;
+
+    freq = etos_sched_get_timestamp_freq();
+    xlogt(LOG_MODULE_T_TASK, "bench %d loops: seqlock:%d critical:%d tick64:%d (timestamp %dHz) tick:%u sum:%u\r\n",
+          TEST_BENCH_FAST_LOOPS, ts_seqlock, ts_critical, ts_tick64, freq, (u32)tick64, sum);
+    xlogt(LOG_MODULE_T_TASK, "bench per read(ns): seqlock:%d critical:%d tick64:%d\r\n",
+          _test_bench_ns_per_op(ts_seqlock, TEST_BENCH_FAST_LOOPS),
+          _test_bench_ns_per_op(ts_critical, TEST_BENCH_FAST_LOOPS),
+          _test_bench_ns_per_op(ts_tick64, TEST_BENCH_FAST_LOOPS));
+}
+
+
+/*
+ * malloc + free cost of each block size, it should be the same for all block sizes,
+ * the block size is found by a bit scan of non-empty block sizes.
+ * then all blocks smaller than TEST_BENCH_DRAIN_BLK_SIZE are held, malloc of a small length
+ * has to skip the empty block sizes, it should cost the same too.
+ * buddy pool cost is measured for the same length by malloc() after the block size is selected to buddy pool,
+ * then a mixed length burst shows its fragmentation
+ */
+void task_test_mem_bench(void)
+{
+    u32 i, size, blk_size, held_num, ts_begin, ts_mem, ts_buddy, freq;
+    void *ptr;
+    void *held = NULL;
+
+    freq = etos_sched_get_timestamp_freq();
+
+    for (size = TEST_BENCH_MIN_BLK_SIZE; size <= TEST_BENCH_MAX_BLK_SIZE; size *= 2) {
+        ts_begin = etos_sched_get_timestamp();
+        for (i = 0; i < TEST_BENCH_FAST_LOOPS; i++) {
+            ptr = malloc(size);
+            free(ptr);
+        }
+        ts_mem = etos_sched_get_timestamp() - ts_begin;
+
+        etos_mem_buddy_select(size, TRUE);
+        ts_begin = etos_sched_get_timestamp();
+        for (i = 0; i < TEST_BENCH_FAST_LOOPS; i++) {
+            ptr = malloc(size);
+            free(ptr);
+        }
+        ts_buddy = etos_sched_get_timestamp() - ts_begin;
+        etos_mem_buddy_select(size, FALSE);
+
+        xlogt(LOG_MODULE_T_TASK, "bench %d loops: malloc/free size:%4d pool:%d buddy:%d (timestamp %dHz) per op(ns) pool:%d buddy:%d\r\n",
+              TEST_BENCH_FAST_LOOPS, size, ts_mem, ts_buddy, freq,
+              _test_bench_ns_per_op(ts_mem, TEST_BENCH_FAST_LOOPS),
+              _test_bench_ns_per_op(ts_buddy, TEST_BENCH_FAST_LOOPS));
+    }
+
+    /*hold blocks from the smallest size until malloc falls back to TEST_BENCH_DRAIN_BLK_SIZE, link them in themselves*/
+    held_num = 0;
+    while ((ptr = malloc(TEST_BENCH_MIN_BLK_SIZE)) != NULL) {
+        if (etos_mem_get_block_size(ptr) >= TEST_BENCH_DRAIN_BLK_SIZE) {
+            free(ptr);
+            break;
+        }
+        *(void **)ptr = held;
+        held = ptr;
+        held_num++;
+    }
+
+    for (size = TEST_BENCH_MIN_BLK_SIZE; size < TEST_BENCH_DRAIN_BLK_SIZE; size *= 2) {
+        ptr = malloc(size);
+        blk_size = etos_mem_get_block_size(ptr);
+        free(ptr);
+
+        ts_begin = etos_sched_get_timestamp();
+        for (i = 0; i < TEST_BENCH_FAST_LOOPS; i++) {
+            ptr = malloc(size);
+            free(ptr);
+        }
+        ts_mem = etos_sched_get_timestamp() - ts_begin;
+
+        xlogt(LOG_MODULE_T_TASK, "bench %d loops: malloc/free size:%4d held:%d fallback block:%d pool:%d per op(ns):%d\r\n",
+              TEST_BENCH_FAST_LOOPS, size, held_num, blk_size, ts_mem,
+              _test_bench_ns_per_op(ts_mem, TEST_BENCH_FAST_LOOPS));
+    }
+
+    while (held) {
+        ptr = held;
+        held = *(void **)ptr;
+        free(ptr);
+    }
+
+    for (i = 0; i < TEST_BENCH_BURST_NUM; i++) {
+        _test_bench_bufs[i] = etos_mem_buddy_malloc(TEST_BENCH_MIN_BLK_SIZE << (etos_random_sys_get() % 10));
+    }
+
+    /*free every other buffer, the free memory is fragmented*/
+    for (i = 0; i < TEST_BENCH_BURST_NUM; i += 2) {
+        free(_test_bench_bufs[i]);
+        _test_bench_bufs[i] = NULL;
+    }
+
+    etos_mem_report("bench");
+
+    for (i = 1; i < TEST_BENCH_BURST_NUM; i += 2) {
+        free(_test_bench_bufs[i]);
+        _test_bench_bufs[i] = NULL;
+    }
+}
+
+
+
+/*
+ * a server receives two clients and replies them out of order,
+ * every task must be back at its own priority
+ */
+void task_test_ipc_donate(void)
+{
+    s32 ret;
+    etos_task_handle task_handle;
+
+    if (_test_ipc_handle) {
+        xloge(LOG_MODULE_T_TASK, "ipc: test is running\r\n");
+        return;
+    }
+
+    if (etos_ipc_create(&_test_ipc_handle)) {
+        xloge(LOG_MODULE_T_TASK, "ipc: create fail\r\n");
+        return;
+    }
+
+    _test_ipc_err_cnt = 0;
+
+    ret = etos_task_create("IPCS", TEST_IPC_SERVER_PRIORITY, _test_ipc_server_main, NULL,
+                           TEST_IPC_STACK_LEN, &task_handle);
+    if (ret) {
+        etos_ipc_destroy(_test_ipc_handle);
+        _test_ipc_handle = 0;
+        xloge(LOG_MODULE_T_TASK, "ipc: create server err:%d\r\n", ret);
+    }
+}
+
+
 /* EOF */
 
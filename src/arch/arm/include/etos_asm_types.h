@@ -18,6 +18,7 @@ History:
 Date           Author       Notes
 ----------     -------      -------------------------
 2013-10-12     deeve        Create
+2026-10-19     deeve        Add 64 bit integer type
 
 *******************************************************************************/
 #ifndef __ETOS_ASM_TYPES_H__
@@ -39,6 +40,8 @@ typedef unsigned short    u16;          /*无符号16位整型类型      */
 typedef short             s16;          /*有符号16位整型类型      */
 typedef unsigned long     u32;          /*无符号32位整型类型      */
 typedef long              s32;          /*有符号32位整型类型      */
+typedef unsigned long long u64;         /*无符号64位整型类型      */
+typedef long long         s64;          /*有符号64位整型类型      */
 
 /*ETOS 不会用到浮点数，所以不要定义*/
 
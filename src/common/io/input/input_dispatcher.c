@@ -17,6 +17,18 @@ History:
 Date           Author       Notes
 ----------     -------      -------------------------
 2015-3-8       deeve        Create
+2026-10-19     deeve        Add trace:dump command
+2026-10-19     deeve        Add prof commands
+2026-10-19     deeve        Set execution budget for test task
+2026-10-19     deeve        Add mutex:report command
+2026-10-19     deeve        Add sem:bench command
+2026-10-19     deeve        Add msgq:report command
+2026-10-19     deeve        Publish uart rx on bus
+2026-10-19     deeve        Dispatch commands by actor handler table
+2026-10-19     deeve        Add seqlock:bench command
+2026-10-19     deeve        Add mem:bench command
+2026-10-19     deeve        Add ipc:donate command
+2026-10-19     deeve        Demote only the busy odd test tasks
 
 *******************************************************************************/
 
@@ -24,23 +36,75 @@ Date           Author       Notes
  *                                 Includes                                   *
  ******************************************************************************/
 #include "etos_includes.h"
+#include "drivers.h"
 
 /******************************************************************************
  *                                 Defines                                    *
  ******************************************************************************/
+#define TEST_TASK_BUDGET_TICKS        (8)    /*~128ms*/
+#define DISPATCH_BUS_QUEUE_LEN        (8)    /*commands queued before dropping*/
+
+
+/*message types of command actor, index of _cmd_handlers*/
+typedef enum _cmd_msg_type_e {
+    CMD_MSG_CREATE = 0,
+    CMD_MSG_TASK_REPORT,
+    CMD_MSG_MUTEX_REPORT,
+    CMD_MSG_MSGQ_REPORT,
+    CMD_MSG_ACTOR_REPORT,
+    CMD_MSG_SEM_BENCH,
+    CMD_MSG_SEQLOCK_BENCH,
+    CMD_MSG_MEM_BENCH,
+    CMD_MSG_IPC_DONATE,
+    CMD_MSG_TRACE_DUMP,
+    CMD_MSG_TRACE_RESET,
+    CMD_MSG_PROF_START,
+    CMD_MSG_PROF_STOP,
+    CMD_MSG_PROF_DUMP,
+    CMD_MSG_PROF_RESET,
+    CMD_MSG_MAX
+} cmd_msg_type_e;
+
+
+typedef struct _dispatch_cmd {
+    const char        *cmd;             /*command prefix, the rest of the line is the argument*/
+    u32               type;             /*cmd_msg_type_e*/
+} dispatch_cmd_t;
 
 /******************************************************************************
  *                                 Global Variables                           *
  ******************************************************************************/
 
-extern etos_msg_handle g_msg_handle_dispatcher;
-
 extern void *task_test_main(void *arg);
+extern void task_test_sem_bench(void);
+extern void task_test_seqlock_bench(void);
+extern void task_test_mem_bench(void);
+extern void task_test_ipc_donate(void);
 
 /******************************************************************************
  *                                 Local Variables                            *
  ******************************************************************************/
 
+static etos_actor_handle _cmd_actor;
+
+static const dispatch_cmd_t _dispatch_cmds[] = {
+    {"create:",      CMD_MSG_CREATE},
+    {"task:report",  CMD_MSG_TASK_REPORT},
+    {"mutex:report", CMD_MSG_MUTEX_REPORT},
+    {"msgq:report",  CMD_MSG_MSGQ_REPORT},
+    {"actor:report", CMD_MSG_ACTOR_REPORT},
+    {"sem:bench",    CMD_MSG_SEM_BENCH},
+    {"seqlock:bench", CMD_MSG_SEQLOCK_BENCH},
+    {"mem:bench",    CMD_MSG_MEM_BENCH},
+    {"ipc:donate",   CMD_MSG_IPC_DONATE},
+    {"trace:dump",   CMD_MSG_TRACE_DUMP},
+    {"trace:reset",  CMD_MSG_TRACE_RESET},
+    {"prof:start",   CMD_MSG_PROF_START},
+    {"prof:stop",    CMD_MSG_PROF_STOP},
+    {"prof:dump",    CMD_MSG_PROF_DUMP},
+    {"prof:reset",   CMD_MSG_PROF_RESET},
+};
+
 /******************************************************************************
  *                                 Local Functions                            *
  ******************************************************************************/
@@ -64,11 +128,15 @@ s32 input_dispatcher_entry(u32 port, gioi_rx_nfy_e type, u32 len)
     if ((port < MAX_GIOI_DRVIER_NUM) && (type < RX_NOTIFY_MAX)) {
         if (len > 0) {
             ret = etos_gioi_rx_buf_length(input_dispatcher_get_handle(), &recv_len);
-            rx_buf = etos_msgq_get_buf(g_msg_handle_dispatcher, recv_len);
+            rx_buf = etos_bus_get_buf(recv_len + 1);
             if (rx_buf) {
                 etos_gioi_get_bytes(input_dispatcher_get_handle(), rx_buf, recv_len);
                 rx_buf[recv_len] = '\0';
-                ret += etos_msgq_send_idic(g_msg_handle_dispatcher, rx_buf);
+                if (etos_bus_publish(ETOS_BUS_TOPIC_UART_RX, rx_buf) != ETOS_RET_OK) {
+                    /*the buffer is still owned by publisher when publish fails*/
+                    etos_bus_release_buf(rx_buf);
+                    ret = ETOS_RET_FAIL;
+                }
                 if (ret) {
                     xlogt(LOG_MODULE_DISPATCH, "INTR: uart(r) send msg err:%d\r\n", ret);
                 } else {
@@ -81,6 +149,222 @@ s32 input_dispatcher_entry(u32 port, gioi_rx_nfy_e type, u32 len)
     return ETOS_RET_OK;
 }
 
+
+/*create:N, create test task TESTN at priority N*3*/
+static s32 _cmd_on_create(etos_actor_handle actor_handle, etos_actor_msg_t *msg)
+{
+    s32 ret;
+    u32 sleep_s;
+    etos_task_handle test_task_handle;
+    char task_name[ETOS_MAX_TASK_NAME_LEN];
+    actor_handle = actor_handle;
+
+    sleep_s = msg->data[0] - '0';
+    strcpy(task_name, "TEST");
+    task_name[4] = msg->data[0];
+    task_name[5] = 0;
+
+    ret = etos_task_create((const char *)task_name,
+                           sleep_s * 3,
+                           task_test_main,
+                           (void *)sleep_s,
+                           2048,
+                           &test_task_handle);
+    if (ret) {
+        xloge(LOG_MODULE_DISPATCH, "create task err:%d\r\n", ret);
+    } else {
+        /*test task with odd number is busy, do not let it starve lower priority tasks*/
+        etos_task_set_budget(test_task_handle, TEST_TASK_BUDGET_TICKS,
+                             (sleep_s & 1) ? ETOS_BUDGET_ACTION_DEMOTE : ETOS_BUDGET_ACTION_LOG,
+                             0, NULL);
+    }
+
+    return ret;
+}
+
+
+static s32 _cmd_on_task_report(etos_actor_handle actor_handle, etos_actor_msg_t *msg)
+{
+    actor_handle = actor_handle;
+    msg = msg;
+    return etos_task_report(NULL);
+}
+
+
+static s32 _cmd_on_mutex_report(etos_actor_handle actor_handle, etos_actor_msg_t *msg)
+{
+    actor_handle = actor_handle;
+    msg = msg;
+    return etos_mutex_report(NULL);
+}
+
+
+static s32 _cmd_on_msgq_report(etos_actor_handle actor_handle, etos_actor_msg_t *msg)
+{
+    actor_handle = actor_handle;
+    msg = msg;
+    return etos_msgq_report(NULL);
+}
+
+
+static s32 _cmd_on_actor_report(etos_actor_handle actor_handle, etos_actor_msg_t *msg)
+{
+    actor_handle = actor_handle;
+    msg = msg;
+    return etos_actor_report(NULL);
+}
+
+
+static s32 _cmd_on_sem_bench(etos_actor_handle actor_handle, etos_actor_msg_t *msg)
+{
+    actor_handle = actor_handle;
+    msg = msg;
+    task_test_sem_bench();
+    return ETOS_RET_OK;
+}
+
+
+static s32 _cmd_on_seqlock_bench(etos_actor_handle actor_handle, etos_actor_msg_t *msg)
+{
+    actor_handle = actor_handle;
+    msg = msg;
+    task_test_seqlock_bench();
+    return ETOS_RET_OK;
+}
+
+
+static s32 _cmd_on_mem_bench(etos_actor_handle actor_handle, etos_actor_msg_t *msg)
+{
+    actor_handle = actor_handle;
+    msg = msg;
+    task_test_mem_bench();
+    return ETOS_RET_OK;
+}
+
+
+static s32 _cmd_on_ipc_donate(etos_actor_handle actor_handle, etos_actor_msg_t *msg)
+{
+    actor_handle = actor_handle;
+    msg = msg;
+    task_test_ipc_donate();
+    return ETOS_RET_OK;
+}
+
+
+static s32 _cmd_on_trace_dump(etos_actor_handle actor_handle, etos_actor_msg_t *msg)
+{
+    actor_handle = actor_handle;
+    msg = msg;
+    etos_trace_dump(xlog_get_output_handle());
+    return ETOS_RET_OK;
+}
+
+
+static s32 _cmd_on_trace_reset(etos_actor_handle actor_handle, etos_actor_msg_t *msg)
+{
+    actor_handle = actor_handle;
+    msg = msg;
+    etos_trace_reset();
+    return ETOS_RET_OK;
+}
+
+
+/*prof:start = sample in tick, prof:start:0 = sample in timer0*/
+static s32 _cmd_on_prof_start(etos_actor_handle actor_handle, etos_actor_msg_t *msg)
+{
+    s32 ret;
+    actor_handle = actor_handle;
+
+    ret = timer_hw_start_profiler((msg->data[0] == ':') ? (msg->data[1] - '0') : 4);
+    if (ret) {
+        xloge(LOG_MODULE_DISPATCH, "start profiler err:%d\r\n", ret);
+    }
+
+    return ret;
+}
+
+
+static s32 _cmd_on_prof_stop(etos_actor_handle actor_handle, etos_actor_msg_t *msg)
+{
+    actor_handle = actor_handle;
+    msg = msg;
+    timer_hw_stop_profiler();
+    return ETOS_RET_OK;
+}
+
+
+static s32 _cmd_on_prof_dump(etos_actor_handle actor_handle, etos_actor_msg_t *msg)
+{
+    actor_handle = actor_handle;
+    msg = msg;
+    etos_prof_dump(xlog_get_output_handle());
+    return ETOS_RET_OK;
+}
+
+
+static s32 _cmd_on_prof_reset(etos_actor_handle actor_handle, etos_actor_msg_t *msg)
+{
+    actor_handle = actor_handle;
+    msg = msg;
+    etos_prof_reset();
+    return ETOS_RET_OK;
+}
+
+
+/*indexed by cmd_msg_type_e*/
+static const etos_actor_handler_t _cmd_handlers[CMD_MSG_MAX] = {
+    {_cmd_on_create,       "create"},
+    {_cmd_on_task_report,  "task:report"},
+    {_cmd_on_mutex_report, "mutex:report"},
+    {_cmd_on_msgq_report,  "msgq:report"},
+    {_cmd_on_actor_report, "actor:report"},
+    {_cmd_on_sem_bench,    "sem:bench"},
+    {_cmd_on_seqlock_bench, "seqlock:bench"},
+    {_cmd_on_mem_bench,    "mem:bench"},
+    {_cmd_on_ipc_donate,   "ipc:donate"},
+    {_cmd_on_trace_dump,   "trace:dump"},
+    {_cmd_on_trace_reset,  "trace:reset"},
+    {_cmd_on_prof_start,   "prof:start"},
+    {_cmd_on_prof_stop,    "prof:stop"},
+    {_cmd_on_prof_dump,    "prof:dump"},
+    {_cmd_on_prof_reset,   "prof:reset"},
+};
+
+
+/*parse a command line to a typed message and post it to command actor, the argument is the payload*/
+static s32 _dispatch_post_cmd(const char *line)
+{
+    s32 ret;
+    u32 i, cmd_len, arg_len;
+    etos_actor_msg_t *msg;
+
+    for (i = 0; i < sizeof(_dispatch_cmds) / sizeof(_dispatch_cmds[0]); i++) {
+        cmd_len = strlen(_dispatch_cmds[i].cmd);
+        if (strncmp(_dispatch_cmds[i].cmd, line, cmd_len) == 0) {
+            break;
+        }
+    }
+
+    if (i == sizeof(_dispatch_cmds) / sizeof(_dispatch_cmds[0])) {
+        return ETOS_NOT_SUPPORT;
+    }
+
+    arg_len = strlen(line + cmd_len) + 1;
+    msg = etos_actor_alloc_msg(_cmd_actor, _dispatch_cmds[i].type, arg_len);
+    if (msg == NULL) {
+        return ETOS_NO_MEM;
+    }
+
+    memcpy(msg->data, line + cmd_len, arg_len);
+
+    ret = etos_actor_send(_cmd_actor, msg);
+    if (ret) {
+        etos_actor_free_msg(_cmd_actor, msg);
+    }
+
+    return ret;
+}
+
 /******************************************************************************
  *                                 Global Functions                           *
  ******************************************************************************/
@@ -91,40 +375,55 @@ s32 input_dispatcher_reg_rx_notifier(void)
 }
 
 
+/*create command actor, it must be called before dispatcher and command task run*/
+s32 input_dispatcher_init(void)
+{
+    return etos_actor_create("CMD", _cmd_handlers, CMD_MSG_MAX, &_cmd_actor);
+}
+
+
+/*command actor task, handle the typed commands posted by dispatcher*/
+void *input_task_cmd_main(void *arg)
+{
+    arg = arg;
+
+    etos_actor_run(_cmd_actor);
+
+    return (void *)0;
+}
+
+
 void *input_task_dispatcher_main(void *arg)
 {
     s32 ret;
-    etos_task_handle test_task_handle;
-    u32 sleep_s;
     u8 *pc_msg_buf;
-    char task_name[ETOS_MAX_TASK_NAME_LEN];
+    etos_bus_sub_handle sub_handle;
     arg = arg;
 
-    input_dispatcher_reg_rx_notifier();
+    ret = etos_bus_sub_create(DISPATCH_BUS_QUEUE_LEN, &sub_handle);
+    if (ret == ETOS_RET_OK) {
+        ret = etos_bus_subscribe(sub_handle, ETOS_BUS_TOPIC_UART_RX);
+    }
 
-    strcpy(task_name, "TEST");
+    if (ret) {
+        xloge(LOG_MODULE_DISPATCH, "subscribe uart rx err:%d\r\n", ret);
+        return (void *)0;
+    }
+
+    input_dispatcher_reg_rx_notifier();
 
     xlogt(LOG_MODULE_DRV, "task dispatcher: can be accept command now\r\n");
 
     while (1) {
-        if (etos_msgq_recv(g_msg_handle_dispatcher, &pc_msg_buf, NULL) == ETOS_RET_OK) {
+        if (etos_bus_recv(sub_handle, NULL, &pc_msg_buf, NULL, ETOS_WAIT_FOREVER) == ETOS_RET_OK) {
             xlogt(LOG_MODULE_DISPATCH, "task dispatcher RECV:%s\r\n", pc_msg_buf);
 
-            if (strncmp("create:", (const char *)(pc_msg_buf), 7) == 0) {
-                sleep_s = pc_msg_buf[7] - '0';
-                task_name[4] = pc_msg_buf[7];
-                task_name[5] = 0;
-                ret = etos_task_create((const char *)task_name,
-                                       sleep_s * 3,
-                                       task_test_main,
-                                       (void *)sleep_s,
-                                       2048,
-                                       &test_task_handle);
-                if (ret) {
-                    xloge(LOG_MODULE_DISPATCH, "create task err:%d\r\n", ret);
-                }
+            ret = _dispatch_post_cmd((const char *)pc_msg_buf);
+            if (ret) {
+                xlogw(LOG_MODULE_DISPATCH, "post command err:%d\r\n", ret);
             }
-            etos_msgq_release_buf(g_msg_handle_dispatcher, pc_msg_buf);
+
+            etos_bus_release_buf(pc_msg_buf);
         }
     }
 
@@ -133,4 +432,3 @@ void *input_task_dispatcher_main(void *arg)
 
 
 /* EOF */
-
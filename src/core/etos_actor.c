@@ -0,0 +1,572 @@
+/******************************************************************************
+File    :  etos_actor.c
+
+This file is part of the ETOS distribution
+Copyright (c) 2026, ETOS Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+(version 2) as published by the Free Software Foundation. See
+the LICENSE file in the top-level directory for more details.
+
+Description:
+		actor, a task owning a message queue and a handler table
+
+History:
+
+Date           Author       Notes
+----------     -------      -------------------------
+2026-10-19     deeve        Create
+2026-10-19     deeve        Report handler time in us
+
+*******************************************************************************/
+
+/******************************************************************************
+ *                                 Includes                                   *
+ ******************************************************************************/
+#include "etos_includes.h"
+
+/******************************************************************************
+ *                                 Defines                                    *
+ ******************************************************************************/
+#define DEFAULT_ACTOR_NAME             "ACTOR"
+#define ACTOR_TIME_AVG_SHIFT           (3)    /*weight of new sample in running average is 1/8*/
+
+/******************************************************************************
+ *                                 Global Variables                           *
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                 Local Variables                            *
+ ******************************************************************************/
+#if (ETOS_ACTOR_ENABLE)
+static struct list_head _os_actor_list_head = {&_os_actor_list_head, &_os_actor_list_head};
+
+static u32 _os_actor_corr_id;
+#endif
+
+/******************************************************************************
+ *                                 Local Functions                            *
+ ******************************************************************************/
+
+#if (ETOS_ACTOR_ENABLE)
+
+static BOOL _etos_actor_is_valid(etos_actor_t *actor)
+{
+    return (actor && (actor->actor_check_flag == ETOS_ACTOR_CHECK_FLAG)) ? TRUE : FALSE;
+}
+
+
+/*a new correlation id, 0 is not used*/
+static u32 _etos_actor_new_corr_id(void)
+{
+    u32 corr_id;
+    etos_init_critical();
+
+    etos_enter_critical();
+    if (++_os_actor_corr_id == 0) {
+        _os_actor_corr_id = 1;
+    }
+    corr_id = _os_actor_corr_id;
+    etos_exit_critical();
+
+    return corr_id;
+}
+
+
+/*look up the handler table by message type and measure the handler*/
+static void _etos_actor_dispatch(etos_actor_t *actor, etos_actor_msg_t *msg)
+{
+    u32 begin, used;
+    etos_actor_stat_t *stat;
+
+    if ((msg->type >= actor->handler_num) || (actor->handlers[msg->type].handler == NULL)) {
+        actor->unknown_cnt++;
+        xlogw(LOG_MODULE_ETOS, "actor %s: no handler for type %d\r\n", actor->name, msg->type);
+        return;
+    }
+
+    begin = etos_sched_get_timestamp();
+    actor->handlers[msg->type].handler((etos_actor_handle)actor, msg);
+    used = etos_sched_get_timestamp() - begin;
+
+    stat = &actor->stat[msg->type];
+    if (stat->call_cnt == 0) {
+        stat->avg_time = used;
+    } else {
+        stat->avg_time = stat->avg_time - (stat->avg_time >> ACTOR_TIME_AVG_SHIFT) + (used >> ACTOR_TIME_AVG_SHIFT);
+    }
+
+    if (used > stat->max_time) {
+        stat->max_time = used;
+    }
+
+    stat->call_cnt++;
+}
+
+#endif
+
+/******************************************************************************
+ *                                 Global Functions                           *
+ ******************************************************************************/
+
+/**
+ * create an actor.
+ * the message queue of the actor is created, the caller runs it in a task by etos_actor_run()
+ *
+ * @param[in]    name          actor name
+ * @param[in]    handlers      handler table indexed by message type, it must be kept valid
+ * @param[in]    handler_num   number of entries of handlers
+ * @param[out]   actor_handle  output handle for other actor API
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @see        etos_actor_destroy()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_actor_create(const char *name, const etos_actor_handler_t *handlers, u32 handler_num,
+                      etos_actor_handle *actor_handle)
+{
+#if (ETOS_ACTOR_ENABLE)
+    s32 ret;
+    etos_actor_t *actor;
+    etos_init_critical();
+
+    if ((handlers == NULL) || (handler_num == 0) || (actor_handle == NULL)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    actor = (etos_actor_t *)malloc(sizeof(etos_actor_t) + handler_num * sizeof(etos_actor_stat_t));
+    if (actor == NULL) {
+        return ETOS_NO_MEM;
+    }
+
+    memset(actor, 0, sizeof(etos_actor_t) + handler_num * sizeof(etos_actor_stat_t));
+
+    /*the message type is in message header, the queue type is the number of types*/
+    ret = etos_msgq_create(handler_num, &actor->msg_handle);
+    if (ret) {
+        free(actor);
+        return ret;
+    }
+
+    actor->handlers = handlers;
+    actor->handler_num = handler_num;
+    actor->stat = (etos_actor_stat_t *)(actor + 1);
+
+    if (name) {
+        strncpy(actor->name, name, ETOS_MAX_TASK_NAME_LEN);
+    } else {
+        strncpy(actor->name, DEFAULT_ACTOR_NAME, ETOS_MAX_TASK_NAME_LEN);
+    }
+
+    actor->actor_check_flag = ETOS_ACTOR_CHECK_FLAG;
+
+    etos_enter_critical();
+    list_add_tail(&actor->list, &_os_actor_list_head);
+    etos_exit_critical();
+
+    *actor_handle = (etos_actor_handle)actor;
+
+    return ETOS_RET_OK;
+#else
+    name = name;
+    handlers = handlers;
+    handler_num = handler_num;
+    actor_handle = actor_handle;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+
+/**
+ * destroy an actor.
+ *
+ * @param[in]    actor_handle
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail, the actor task is waiting for message
+ *
+ * @see        etos_actor_create()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_actor_destroy(etos_actor_handle actor_handle)
+{
+#if (ETOS_ACTOR_ENABLE)
+    s32 ret;
+    etos_actor_t *actor = (etos_actor_t *)actor_handle;
+    etos_init_critical();
+
+    if (!_etos_actor_is_valid(actor)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    ret = etos_msgq_destroy(actor->msg_handle);
+    if (ret) {
+        return ret;
+    }
+
+    etos_enter_critical();
+    list_del(&actor->list);
+    actor->actor_check_flag = 0;
+    etos_exit_critical();
+
+    free(actor);
+
+    return ETOS_RET_OK;
+#else
+    actor_handle = actor_handle;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+
+/**
+ * allocate a message for an actor.
+ *
+ * @param[in]    actor_handle    the receiver
+ * @param[in]    type            message type
+ * @param[in]    len             length of data
+ *
+ * @return   the message, NULL if it fails
+ *
+ * @note       it can be called in ISR
+ * @see        etos_actor_send()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+etos_actor_msg_t *etos_actor_alloc_msg(etos_actor_handle actor_handle, u32 type, u32 len)
+{
+#if (ETOS_ACTOR_ENABLE)
+    etos_actor_msg_t *msg;
+    etos_actor_t *actor = (etos_actor_t *)actor_handle;
+
+    if (!_etos_actor_is_valid(actor)) {
+        return NULL;
+    }
+
+    msg = (etos_actor_msg_t *)etos_msgq_get_buf(actor->msg_handle, sizeof(etos_actor_msg_t) + len);
+    if (msg == NULL) {
+        return NULL;
+    }
+
+    msg->type = type;
+    msg->corr_id = 0;
+    msg->reply_to = 0;
+    msg->len = len;
+
+    return msg;
+#else
+    actor_handle = actor_handle;
+    type = type;
+    len = len;
+    return NULL;
+#endif
+}
+
+
+
+/**
+ * free a message which is not sent.
+ *
+ * @param[in]    actor_handle    the actor the message is allocated for
+ * @param[in]    msg
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @see        etos_actor_alloc_msg()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_actor_free_msg(etos_actor_handle actor_handle, etos_actor_msg_t *msg)
+{
+#if (ETOS_ACTOR_ENABLE)
+    etos_actor_t *actor = (etos_actor_t *)actor_handle;
+
+    if (!_etos_actor_is_valid(actor)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    return etos_msgq_release_buf(actor->msg_handle, (u8 *)msg);
+#else
+    actor_handle = actor_handle;
+    msg = msg;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+
+/**
+ * send a message to an actor.
+ *
+ * @param[in]    actor_handle    the receiver
+ * @param[in]    msg             which is returned by etos_actor_alloc_msg()
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail, the caller still owns the message
+ *
+ * @note       it can be called in ISR
+ * @see        etos_actor_request()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_actor_send(etos_actor_handle actor_handle, etos_actor_msg_t *msg)
+{
+#if (ETOS_ACTOR_ENABLE)
+    etos_actor_t *actor = (etos_actor_t *)actor_handle;
+
+    if (!_etos_actor_is_valid(actor)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    return etos_msgq_send(actor->msg_handle, (u8 *)msg);
+#else
+    actor_handle = actor_handle;
+    msg = msg;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+
+/**
+ * send a request to an actor.
+ * the response comes to reply_to with the same correlation id
+ *
+ * @param[in]    actor_handle    the receiver
+ * @param[in]    msg             which is returned by etos_actor_alloc_msg()
+ * @param[in]    reply_to        the actor receiving the response
+ * @param[out]   corr_id         correlation id of the request, can be NULL
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail, the caller still owns the message
+ *
+ * @see        etos_actor_reply()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_actor_request(etos_actor_handle actor_handle, etos_actor_msg_t *msg, etos_actor_handle reply_to,
+                       u32 *corr_id)
+{
+#if (ETOS_ACTOR_ENABLE)
+    if ((msg == NULL) || !_etos_actor_is_valid((etos_actor_t *)reply_to)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    msg->corr_id = _etos_actor_new_corr_id();
+    msg->reply_to = reply_to;
+
+    if (corr_id) {
+        *corr_id = msg->corr_id;
+    }
+
+    return etos_actor_send(actor_handle, msg);
+#else
+    actor_handle = actor_handle;
+    msg = msg;
+    reply_to = reply_to;
+    corr_id = corr_id;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+
+/**
+ * send the response of a request.
+ * it is called in the handler of the request
+ *
+ * @param[in]    request    the request being handled
+ * @param[in]    type       message type of the response
+ * @param[in]    data       response data, can be NULL
+ * @param[in]    len        length of data
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @see        etos_actor_request()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_actor_reply(etos_actor_msg_t *request, u32 type, const u8 *data, u32 len)
+{
+#if (ETOS_ACTOR_ENABLE)
+    s32 ret;
+    etos_actor_msg_t *resp;
+
+    if ((request == NULL) || (request->reply_to == 0)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    resp = etos_actor_alloc_msg(request->reply_to, type, len);
+    if (resp == NULL) {
+        return ETOS_NO_MEM;
+    }
+
+    if (data && len) {
+        memcpy(resp->data, data, len);
+    }
+
+    resp->corr_id = request->corr_id;
+
+    ret = etos_actor_send(request->reply_to, resp);
+    if (ret) {
+        etos_actor_free_msg(request->reply_to, resp);
+    }
+
+    return ret;
+#else
+    request = request;
+    type = type;
+    data = data;
+    len = len;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+
+/**
+ * run an actor.
+ * receive messages and call the handler of their type, it is the loop of the actor task
+ *
+ * @param[in]    actor_handle
+ *
+ * @return   it returns only when it fails
+ *
+ * @note       do not call this API in an interrupt context
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_actor_run(etos_actor_handle actor_handle)
+{
+#if (ETOS_ACTOR_ENABLE)
+    s32 ret;
+    u8 *msg_buf;
+    etos_actor_t *actor = (etos_actor_t *)actor_handle;
+
+    if (!_etos_actor_is_valid(actor)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    while (1) {
+        ret = etos_msgq_recv(actor->msg_handle, &msg_buf, NULL);
+        if (ret) {
+            xloge(LOG_MODULE_ETOS, "actor %s: recv err:%d\r\n", actor->name, ret);
+            return ret;
+        }
+
+        _etos_actor_dispatch(actor, (etos_actor_msg_t *)msg_buf);
+
+        etos_msgq_release_buf(actor->msg_handle, msg_buf);
+    }
+#else
+    actor_handle = actor_handle;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+
+/**
+ * get handler statistics.
+ *
+ * @param[in]    actor_handle
+ * @param[in]    type            message type
+ * @param[out]   stat
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_actor_get_stat(etos_actor_handle actor_handle, u32 type, etos_actor_stat_t *stat)
+{
+#if (ETOS_ACTOR_ENABLE)
+    etos_actor_t *actor = (etos_actor_t *)actor_handle;
+    etos_init_critical();
+
+    if (!_etos_actor_is_valid(actor) || (type >= actor->handler_num) || (stat == NULL)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    etos_enter_critical();
+    *stat = actor->stat[type];
+    etos_exit_critical();
+
+    return ETOS_RET_OK;
+#else
+    actor_handle = actor_handle;
+    type = type;
+    stat = stat;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+
+/**
+ * report actor statistics.
+ * print call count and execution time of every handler of all actors
+ *
+ * @param[in]    prompt   print header
+ *
+ * @return 0
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_actor_report(const char *prompt)
+{
+#if (ETOS_ACTOR_ENABLE)
+    u32 type;
+    list_t *pt_entry;
+    etos_actor_t *actor;
+    etos_actor_stat_t *stat;
+    const char *header;
+
+    if (prompt) {
+        header = prompt;
+    } else {
+        header = "etos actor";
+    }
+
+    list_for_each(pt_entry, &_os_actor_list_head) {
+        actor = list_entry(pt_entry, etos_actor_t, list);
+        xlogt(LOG_MODULE_ETOS, "%s: %-8s unknown:%d\r\n", header, actor->name, actor->unknown_cnt);
+
+        for (type = 0; type < actor->handler_num; type++) {
+            stat = &actor->stat[type];
+            if (actor->handlers[type].handler == NULL) {
+                continue;
+            }
+            xlogt(LOG_MODULE_ETOS, "%s:   %-12s call:%d time(us) avg:%d max:%d\r\n", header,
+                  actor->handlers[type].name ? actor->handlers[type].name : "-",
+                  stat->call_cnt, etos_sched_timestamp_to_us(stat->avg_time),
+                  etos_sched_timestamp_to_us(stat->max_time));
+        }
+    }
+#else
+    prompt = prompt;
+#endif
+
+    return ETOS_RET_OK;
+}
+
+
+/* EOF */
@@ -0,0 +1,578 @@
+/******************************************************************************
+File    :  etos_bus.c
+
+This file is part of the ETOS distribution
+Copyright (c) 2026, ETOS Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+(version 2) as published by the Free Software Foundation. See
+the LICENSE file in the top-level directory for more details.
+
+Description:
+		topic based publish/subscribe bus
+
+History:
+
+Date           Author       Notes
+----------     -------      -------------------------
+2026-10-19     deeve        Create
+2026-10-19     deeve        Fix topic mask of topic 31
+
+*******************************************************************************/
+
+/******************************************************************************
+ *                                 Includes                                   *
+ ******************************************************************************/
+#include "etos_includes.h"
+
+/******************************************************************************
+ *                                 Defines                                    *
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                 Global Variables                           *
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                 Local Variables                            *
+ ******************************************************************************/
+#if (ETOS_BUS_ENABLE)
+static struct list_head _os_bus_sub_list_head = {&_os_bus_sub_list_head, &_os_bus_sub_list_head};
+#endif
+
+/******************************************************************************
+ *                                 Local Functions                            *
+ ******************************************************************************/
+
+#if (ETOS_BUS_ENABLE)
+
+static BOOL _etos_bus_sub_is_valid(etos_bus_sub_t *sub)
+{
+    return (sub && (sub->bus_check_flag == ETOS_BUS_CHECK_FLAG)) ? TRUE : FALSE;
+}
+
+
+/*the buffer header of a payload, NULL if it is not a bus buffer*/
+static etos_bus_buf_t *_etos_bus_get_buf_head(u8 *buf)
+{
+    etos_bus_buf_t *bus_buf;
+
+    if (buf == NULL) {
+        return NULL;
+    }
+
+    bus_buf = list_entry(buf, etos_bus_buf_t, data);
+    if (bus_buf->bus_check_flag != ETOS_BUS_CHECK_FLAG) {
+        return NULL;
+    }
+
+    return bus_buf;
+}
+
+
+static void _etos_bus_put_buf_idic(etos_bus_buf_t *bus_buf)
+{
+    if (--bus_buf->ref_cnt == 0) {
+        bus_buf->bus_check_flag = 0;
+        free(bus_buf);
+    }
+}
+
+#endif
+
+/******************************************************************************
+ *                                 Global Functions                           *
+ ******************************************************************************/
+
+/**
+ * create a bus subscriber.
+ *
+ * @param[in]    queue_len    max number of messages queued in the subscriber
+ * @param[out]   sub_handle   output handle for other bus API
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @see        etos_bus_sub_destroy()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_bus_sub_create(u32 queue_len, etos_bus_sub_handle *sub_handle)
+{
+#if (ETOS_BUS_ENABLE)
+    etos_bus_sub_t *sub;
+    etos_init_critical();
+
+    if ((sub_handle == NULL) || (queue_len == 0)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    sub = (etos_bus_sub_t *)malloc(sizeof(etos_bus_sub_t) + queue_len * sizeof(etos_bus_buf_t *));
+    if (sub == NULL) {
+        return ETOS_NO_MEM;
+    }
+
+    memset(sub, 0, sizeof(etos_bus_sub_t));
+    etos_waitq_init(&sub->waitq, NULL);
+    sub->queue_len = queue_len;
+    sub->bus_check_flag = ETOS_BUS_CHECK_FLAG;
+
+    etos_enter_critical();
+    list_add_tail(&sub->list, &_os_bus_sub_list_head);
+    etos_exit_critical();
+
+    *sub_handle = (etos_bus_sub_handle)sub;
+
+    return ETOS_RET_OK;
+#else
+    queue_len = queue_len;
+    sub_handle = sub_handle;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+
+/**
+ * destroy a bus subscriber.
+ * all topics are unsubscribed and the queued messages are released
+ *
+ * @param[in]    sub_handle
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail, a task is waiting for message
+ *
+ * @see        etos_bus_sub_create()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_bus_sub_destroy(etos_bus_sub_handle sub_handle)
+{
+#if (ETOS_BUS_ENABLE)
+    etos_bus_sub_t *sub = (etos_bus_sub_t *)sub_handle;
+    etos_init_critical();
+
+    if (!_etos_bus_sub_is_valid(sub)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    etos_enter_critical();
+
+    if (!etos_waitq_is_empty(&sub->waitq)) {
+        etos_exit_critical();
+        return ETOS_NOT_SUPPORT;
+    }
+
+    list_del(&sub->list);
+
+    while (sub->head != sub->tail) {
+        _etos_bus_put_buf_idic(sub->queue[sub->tail % sub->queue_len]);
+        sub->tail++;
+    }
+
+    sub->bus_check_flag = 0;
+
+    etos_exit_critical();
+
+    free(sub);
+
+    return ETOS_RET_OK;
+#else
+    sub_handle = sub_handle;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+
+/**
+ * subscribe a topic.
+ *
+ * @param[in]    sub_handle
+ * @param[in]    topic        0 ~ (ETOS_BUS_MAX_TOPICS - 1)
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @see        etos_bus_unsubscribe()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_bus_subscribe(etos_bus_sub_handle sub_handle, u32 topic)
+{
+#if (ETOS_BUS_ENABLE)
+    etos_bus_sub_t *sub = (etos_bus_sub_t *)sub_handle;
+    etos_init_critical();
+
+    if (!_etos_bus_sub_is_valid(sub) || (topic >= ETOS_BUS_MAX_TOPICS)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    etos_enter_critical();
+    sub->topic_mask |= (1UL << topic);
+    etos_exit_critical();
+
+    return ETOS_RET_OK;
+#else
+    sub_handle = sub_handle;
+    topic = topic;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+
+/**
+ * unsubscribe a topic.
+ * the messages of the topic queued already are still received
+ *
+ * @param[in]    sub_handle
+ * @param[in]    topic        0 ~ (ETOS_BUS_MAX_TOPICS - 1)
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @see        etos_bus_subscribe()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_bus_unsubscribe(etos_bus_sub_handle sub_handle, u32 topic)
+{
+#if (ETOS_BUS_ENABLE)
+    etos_bus_sub_t *sub = (etos_bus_sub_t *)sub_handle;
+    etos_init_critical();
+
+    if (!_etos_bus_sub_is_valid(sub) || (topic >= ETOS_BUS_MAX_TOPICS)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    etos_enter_critical();
+    sub->topic_mask &= ~(1UL << topic);
+    etos_exit_critical();
+
+    return ETOS_RET_OK;
+#else
+    sub_handle = sub_handle;
+    topic = topic;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+
+/**
+ * get a bus buffer.
+ * the publisher fills the buffer and publishes it
+ *
+ * @param[in]    len    payload length
+ *
+ * @return    the payload pointer
+ * @retval other   success
+ * @retval 0       fail
+ *
+ * @note       it can be called in ISR
+ * @see        etos_bus_publish()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+u8 *etos_bus_get_buf(u32 len)
+{
+#if (ETOS_BUS_ENABLE)
+    etos_bus_buf_t *bus_buf;
+
+    if (len == 0) {
+        return NULL;
+    }
+
+    bus_buf = (etos_bus_buf_t *)malloc(sizeof(etos_bus_buf_t) + len);
+    if (bus_buf == NULL) {
+        return NULL;
+    }
+
+    /*the reference of publisher, it is put after publish*/
+    bus_buf->ref_cnt = 1;
+    bus_buf->topic = 0;
+    bus_buf->len = len;
+    bus_buf->bus_check_flag = ETOS_BUS_CHECK_FLAG;
+
+    return bus_buf->data;
+#else
+    len = len;
+    return NULL;
+#endif
+}
+
+
+
+/**
+ * publish a bus buffer to all subscribers of the topic.
+ * the buffer reference is queued to every subscriber, the payload is not copied
+ *
+ * @param[in]    topic    0 ~ (ETOS_BUS_MAX_TOPICS - 1)
+ * @param[in]    buf      which is returned by etos_bus_get_buf()
+ *
+ * @return
+ * @retval 0       success, the buffer is owned by the bus even if no subscriber gets it
+ * @retval other   fail, the buffer is still owned by the caller
+ *
+ * @note       it can be called in ISR
+ * @see        etos_bus_recv()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_bus_publish(u32 topic, u8 *buf)
+{
+#if (ETOS_BUS_ENABLE)
+    s32 ret;
+    etos_init_critical();
+
+    etos_enter_critical();
+    ret = etos_bus_publish_idic(topic, buf);
+    etos_exit_critical();
+
+    return ret;
+#else
+    topic = topic;
+    buf = buf;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+
+/**
+ * publish a bus buffer in disable interrupt context.
+ *
+ * @param[in]    topic    0 ~ (ETOS_BUS_MAX_TOPICS - 1)
+ * @param[in]    buf      which is returned by etos_bus_get_buf()
+ *
+ * @return
+ * @retval 0       success, the buffer is owned by the bus even if no subscriber gets it
+ * @retval other   fail, the buffer is still owned by the caller
+ *
+ * @see        etos_bus_publish()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_bus_publish_idic(u32 topic, u8 *buf)
+{
+#if (ETOS_BUS_ENABLE)
+    u32 depth;
+    list_t *pt_entry;
+    etos_bus_sub_t *sub;
+    etos_bus_buf_t *bus_buf = _etos_bus_get_buf_head(buf);
+
+    if ((bus_buf == NULL) || (topic >= ETOS_BUS_MAX_TOPICS)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    bus_buf->topic = topic;
+
+    list_for_each(pt_entry, &_os_bus_sub_list_head) {
+        sub = list_entry(pt_entry, etos_bus_sub_t, list);
+        if (!(sub->topic_mask & (1UL << topic))) {
+            continue;
+        }
+
+        depth = sub->head - sub->tail;
+        if (depth >= sub->queue_len) {
+            /*a slow subscriber does not block the publisher and other subscribers*/
+            sub->stat.drop_cnt++;
+            continue;
+        }
+
+        bus_buf->ref_cnt++;
+        sub->queue[sub->head % sub->queue_len] = bus_buf;
+        sub->head++;
+
+        sub->stat.deliver_cnt++;
+        if (depth + 1 > sub->stat.max_depth) {
+            sub->stat.max_depth = depth + 1;
+        }
+
+        etos_waitq_wake_one_idic(&sub->waitq, ETOS_RET_OK, 0);
+    }
+
+    _etos_bus_put_buf_idic(bus_buf);
+
+    return ETOS_RET_OK;
+#else
+    topic = topic;
+    buf = buf;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+
+/**
+ * receive a bus message.
+ * do not call this API in an interrupt context
+ *
+ * @param[in]    sub_handle
+ * @param[out]   topic            can be NULL
+ * @param[out]   buf_ptr          payload, it must be released by etos_bus_release_buf()
+ * @param[out]   len              payload length, can be NULL
+ * @param[in]    timeout_ticks    0: do not wait, ETOS_WAIT_FOREVER: wait until a message is published
+ *
+ * @return
+ * @retval 0                  success
+ * @retval ETOS_RET_BUSY      there is no message and timeout_ticks is 0
+ * @retval ETOS_RET_TIMEOUT   timeout
+ * @retval other              fail
+ *
+ * @see        etos_bus_publish()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_bus_recv(etos_bus_sub_handle sub_handle, u32 *topic, u8 **buf_ptr, u32 *len, u32 timeout_ticks)
+{
+#if (ETOS_BUS_ENABLE)
+    s32 ret;
+    s32 left_ticks;
+    etos_tick deadline;
+    etos_bus_buf_t *bus_buf;
+    etos_bus_sub_t *sub = (etos_bus_sub_t *)sub_handle;
+    etos_init_critical();
+
+    if (!_etos_bus_sub_is_valid(sub) || (buf_ptr == NULL)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    *buf_ptr = NULL;
+
+    etos_enter_critical();
+
+    deadline = etos_sched_get_tick() + timeout_ticks;
+
+    while (sub->head == sub->tail) {
+        if (timeout_ticks == 0) {
+            etos_exit_critical();
+            return ETOS_RET_BUSY;
+        }
+
+        ret = etos_waitq_pend_idic(&sub->waitq, ETOS_TASK_PENDING_BUS, timeout_ticks, 0, 0);
+        if (ret != ETOS_RET_OK) {
+            etos_exit_critical();
+            return ret;
+        }
+
+        /*another task of the same subscriber may take the message first, wait the rest ticks*/
+        if (timeout_ticks != ETOS_WAIT_FOREVER) {
+            left_ticks = (s32)(deadline - etos_sched_get_tick());
+            if (left_ticks <= 0) {
+                etos_exit_critical();
+                return ETOS_RET_TIMEOUT;
+            }
+            timeout_ticks = (u32)left_ticks;
+        }
+    }
+
+    bus_buf = sub->queue[sub->tail % sub->queue_len];
+    sub->tail++;
+
+    etos_exit_critical();
+
+    if (topic) {
+        *topic = bus_buf->topic;
+    }
+
+    if (len) {
+        *len = bus_buf->len;
+    }
+
+    *buf_ptr = bus_buf->data;
+
+    return ETOS_RET_OK;
+#else
+    sub_handle = sub_handle;
+    topic = topic;
+    buf_ptr = buf_ptr;
+    len = len;
+    timeout_ticks = timeout_ticks;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+
+/**
+ * release a bus buffer.
+ * the buffer is freed when the last reference is released
+ *
+ * @param[in]    buf    which is received by etos_bus_recv()
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @note       it can be called in ISR
+ * @see        etos_bus_recv()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_bus_release_buf(u8 *buf)
+{
+#if (ETOS_BUS_ENABLE)
+    etos_bus_buf_t *bus_buf = _etos_bus_get_buf_head(buf);
+    etos_init_critical();
+
+    if (bus_buf == NULL) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    etos_enter_critical();
+    _etos_bus_put_buf_idic(bus_buf);
+    etos_exit_critical();
+
+    return ETOS_RET_OK;
+#else
+    buf = buf;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+
+/**
+ * get subscriber statistics.
+ *
+ * @param[in]    sub_handle
+ * @param[out]   stat
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_bus_get_stat(etos_bus_sub_handle sub_handle, etos_bus_stat_t *stat)
+{
+#if (ETOS_BUS_ENABLE)
+    etos_bus_sub_t *sub = (etos_bus_sub_t *)sub_handle;
+    etos_init_critical();
+
+    if (!_etos_bus_sub_is_valid(sub) || (stat == NULL)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    etos_enter_critical();
+    *stat = sub->stat;
+    etos_exit_critical();
+
+    return ETOS_RET_OK;
+#else
+    sub_handle = sub_handle;
+    stat = stat;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+/* EOF */
@@ -0,0 +1,426 @@
+/******************************************************************************
+File    :  etos_event.c
+
+This file is part of the ETOS distribution
+Copyright (c) 2026, ETOS Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+(version 2) as published by the Free Software Foundation. See
+the LICENSE file in the top-level directory for more details.
+
+Description:
+		32 bits event flag group
+
+History:
+
+Date           Author       Notes
+----------     -------      -------------------------
+2026-10-19     deeve        Create
+2026-10-19     deeve        Use generic wait queue
+
+*******************************************************************************/
+
+/******************************************************************************
+ *                                 Includes                                   *
+ ******************************************************************************/
+#include "etos_includes.h"
+
+/******************************************************************************
+ *                                 Defines                                    *
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                 Global Variables                           *
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                 Local Variables                            *
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                 Local Functions                            *
+ ******************************************************************************/
+
+#if (ETOS_EVENT_ENABLE)
+
+static BOOL _etos_event_is_valid(etos_event_t *event)
+{
+    return (event && (event->event_check_flag == ETOS_EVENT_CHECK_FLAG)) ? TRUE : FALSE;
+}
+
+
+static BOOL _etos_event_is_satisfied(u32 bits, u32 wait_bits, u32 options)
+{
+    if (options & ETOS_EVENT_WAIT_ALL) {
+        return ((bits & wait_bits) == wait_bits) ? TRUE : FALSE;
+    }
+
+    return (bits & wait_bits) ? TRUE : FALSE;
+}
+
+
+/*called in tick ISR, report the bits when it times out*/
+static void _etos_event_timeout_hook(etos_waitq_t *waitq, etos_tcb_t *pt_os_task_tcb)
+{
+    etos_event_t *event = list_entry(waitq, etos_event_t, waitq);
+
+    pt_os_task_tcb->wait_node.wake_value = event->bits;
+}
+
+#endif
+
+/******************************************************************************
+ *                                 Global Functions                           *
+ ******************************************************************************/
+
+/**
+ * create an event group.
+ *
+ * @param[in]    init_bits
+ * @param[out]   event_handle    output handle for other event API
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @see        etos_event_destroy()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_event_create(u32 init_bits, etos_event_handle *event_handle)
+{
+#if (ETOS_EVENT_ENABLE)
+    etos_event_t *event;
+
+    if (event_handle == NULL) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    event = (etos_event_t *)malloc(sizeof(etos_event_t));
+    if (event == NULL) {
+        return ETOS_NO_MEM;
+    }
+
+    etos_waitq_init(&event->waitq, _etos_event_timeout_hook);
+    event->bits = init_bits;
+    event->event_check_flag = ETOS_EVENT_CHECK_FLAG;
+
+    *event_handle = (etos_event_handle)event;
+
+    return ETOS_RET_OK;
+#else
+    init_bits = init_bits;
+    event_handle = event_handle;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+
+/**
+ * destroy an event group.
+ *
+ * @param[in]    event_handle
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail, a task is waiting for the event group
+ *
+ * @see        etos_event_create()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_event_destroy(etos_event_handle event_handle)
+{
+#if (ETOS_EVENT_ENABLE)
+    etos_event_t *event = (etos_event_t *)event_handle;
+    etos_init_critical();
+
+    if (!_etos_event_is_valid(event)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    etos_enter_critical();
+
+    if (!etos_waitq_is_empty(&event->waitq)) {
+        etos_exit_critical();
+        return ETOS_NOT_SUPPORT;
+    }
+
+    event->event_check_flag = 0;
+
+    etos_exit_critical();
+
+    free(event);
+
+    return ETOS_RET_OK;
+#else
+    event_handle = event_handle;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+
+/**
+ * set event bits.
+ * all waiters satisfied by the new bits are woken up in one pass
+ *
+ * @param[in]    event_handle
+ * @param[in]    bits
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @see        etos_event_wait()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_event_set(etos_event_handle event_handle, u32 bits)
+{
+    s32 ret;
+    etos_init_critical();
+
+    etos_enter_critical();
+    ret = etos_event_set_idic(event_handle, bits);
+    etos_exit_critical();
+
+    return ret;
+}
+
+
+
+/**
+ * set event bits in disable interrupt context.
+ * it can be called in ISR
+ *
+ * 所有waiter看到的是同一个bits，auto clear的bits在遍历完成后统一清除
+ *
+ * @param[in]    event_handle
+ * @param[in]    bits
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @note       the woken tasks run at next schedulable time
+ * @see        etos_event_set()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_event_set_idic(etos_event_handle event_handle, u32 bits)
+{
+#if (ETOS_EVENT_ENABLE)
+    u32 clear_bits = 0;
+    list_t *pt_entry, *pt_next;
+    etos_wait_node_t *pt_node;
+    etos_event_t *event = (etos_event_t *)event_handle;
+
+    if (!_etos_event_is_valid(event)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    event->bits |= bits;
+
+    list_for_each_safe(pt_entry, pt_next, &event->waitq.list) {
+        pt_node = list_entry(pt_entry, etos_wait_node_t, list);
+        if (!_etos_event_is_satisfied(event->bits, pt_node->wait_arg, pt_node->wait_opt)) {
+            continue;
+        }
+
+        if (pt_node->wait_opt & ETOS_EVENT_AUTO_CLEAR) {
+            clear_bits |= pt_node->wait_arg;
+        }
+
+        etos_waitq_wake_node_idic(pt_node, ETOS_RET_OK, event->bits);
+    }
+
+    event->bits &= (~clear_bits);
+
+    return ETOS_RET_OK;
+#else
+    event_handle = event_handle;
+    bits = bits;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+
+/**
+ * clear event bits.
+ *
+ * @param[in]    event_handle
+ * @param[in]    bits
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_event_clear(etos_event_handle event_handle, u32 bits)
+{
+    s32 ret;
+    etos_init_critical();
+
+    etos_enter_critical();
+    ret = etos_event_clear_idic(event_handle, bits);
+    etos_exit_critical();
+
+    return ret;
+}
+
+
+
+/**
+ * clear event bits in disable interrupt context.
+ * it can be called in ISR
+ *
+ * @param[in]    event_handle
+ * @param[in]    bits
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @see        etos_event_clear()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_event_clear_idic(etos_event_handle event_handle, u32 bits)
+{
+#if (ETOS_EVENT_ENABLE)
+    etos_event_t *event = (etos_event_t *)event_handle;
+
+    if (!_etos_event_is_valid(event)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    event->bits &= (~bits);
+
+    return ETOS_RET_OK;
+#else
+    event_handle = event_handle;
+    bits = bits;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+
+/**
+ * wait event bits.
+ * the caller pends until the wait is satisfied or timeout
+ *
+ * @param[in]    event_handle
+ * @param[in]    wait_bits
+ * @param[in]    options          ETOS_EVENT_WAIT_ANY or ETOS_EVENT_WAIT_ALL, | ETOS_EVENT_AUTO_CLEAR
+ * @param[out]   matched_bits     event bits when the wait is satisfied (before auto clear), can be NULL
+ * @param[in]    timeout_ticks    0: do not wait, ETOS_WAIT_FOREVER: wait until it is satisfied
+ *
+ * @return
+ * @retval 0                  success
+ * @retval ETOS_RET_BUSY      not satisfied and timeout_ticks is 0
+ * @retval ETOS_RET_TIMEOUT   timeout
+ * @retval other              fail
+ *
+ * @note       do not call this API in an interrupt context
+ * @see        etos_event_set()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_event_wait(etos_event_handle event_handle, u32 wait_bits, u32 options,
+                    u32 *matched_bits, u32 timeout_ticks)
+{
+#if (ETOS_EVENT_ENABLE)
+    s32 ret;
+    etos_wait_node_t *pt_node;
+    etos_event_t *event = (etos_event_t *)event_handle;
+    etos_init_critical();
+
+    if (!_etos_event_is_valid(event) || (wait_bits == 0)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    etos_enter_critical();
+
+    if (_etos_event_is_satisfied(event->bits, wait_bits, options)) {
+        if (matched_bits) {
+            *matched_bits = event->bits;
+        }
+        if (options & ETOS_EVENT_AUTO_CLEAR) {
+            event->bits &= (~wait_bits);
+        }
+        etos_exit_critical();
+        return ETOS_RET_OK;
+    }
+
+    if (timeout_ticks == 0) {
+        if (matched_bits) {
+            *matched_bits = event->bits;
+        }
+        etos_exit_critical();
+        return ETOS_RET_BUSY;
+    }
+
+    /*pending itself, it is resumed by set or timeout*/
+    ret = etos_waitq_pend_idic(&event->waitq, ETOS_TASK_PENDING_EVENT, timeout_ticks, wait_bits, options);
+
+    if (matched_bits) {
+        pt_node = etos_waitq_get_node(etos_sched_get_current_task());
+        *matched_bits = pt_node ? pt_node->wake_value : event->bits;
+    }
+
+    etos_exit_critical();
+
+    return ret;
+#else
+    event_handle = event_handle;
+    wait_bits = wait_bits;
+    options = options;
+    matched_bits = matched_bits;
+    timeout_ticks = timeout_ticks;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+
+/**
+ * get event bits.
+ *
+ * @param[in]    event_handle
+ * @param[out]   bits
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_event_get(etos_event_handle event_handle, u32 *bits)
+{
+#if (ETOS_EVENT_ENABLE)
+    etos_event_t *event = (etos_event_t *)event_handle;
+
+    if (!_etos_event_is_valid(event) || (bits == NULL)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    *bits = event->bits;
+
+    return ETOS_RET_OK;
+#else
+    event_handle = event_handle;
+    bits = bits;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+/* EOF */
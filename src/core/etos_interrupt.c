@@ -21,6 +21,10 @@ Date           Author       Notes
 2013-11-23     deeve        Create
 2015-4-14      deeve        Add some comments
 2015-4-15      deeve        Add etos_intr_in_isr()
+2026-10-19     deeve        Add trace points
+2026-10-19     deeve        Check task execution budget at tick
+2026-10-19     deeve        Update sporadic server at tick
+2026-10-19     deeve        Update wait queue timeout at tick
 
 *******************************************************************************/
 
@@ -212,6 +216,8 @@ void etos_isr_main_idic(void)
 
     _os_intr_in_isr = TRUE;
 
+    ETOS_TRACE_IDIC(ETOS_TRACE_EVT_ISR_ENTER, 0, 0);
+
     if (ETOS_TASK_HANDLE_IS_VALID(task_handle)) {
         etos_sched_set_task_state(task_handle, ETOS_TASK_INTERRUPTED);
     }
@@ -235,6 +241,8 @@ void etos_isr_main_idic(void)
 
     _os_intr_in_isr = FALSE;
 
+    ETOS_TRACE_IDIC(ETOS_TRACE_EVT_ISR_EXIT, 0, isr_ret);
+
     /* do not need reschedule */
     if (isr_ret == ETOS_ISR_RESCHEDULE_DISABLE) {
         /*return to task before*/
@@ -244,8 +252,11 @@ void etos_isr_main_idic(void)
 
     if (isr_ret & ETOS_ISR_RESCHEDULE_UPDATE_TICK) {
         etos_sched_adjust_tick(1);
-        /*sleep module*/
-        etos_sleep_update_tick_in_isr(etos_sched_get_tick());
+        /*account the tick to the interrupted task*/
+        etos_sched_update_budget_in_isr(task_handle);
+        etos_sporadic_update_tick_in_isr(task_handle, etos_sched_get_tick());
+        /*sleep and timeout of blocking API*/
+        etos_waitq_update_tick_in_isr(etos_sched_get_tick());
     }
 
     if (isr_ret & ETOS_ISR_RESCHEDULE_ENABLE) {
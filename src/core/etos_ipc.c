@@ -0,0 +1,455 @@
+/******************************************************************************
+File    :  etos_ipc.c
+
+This file is part of the ETOS distribution
+Copyright (c) 2026, ETOS Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+(version 2) as published by the Free Software Foundation. See
+the LICENSE file in the top-level directory for more details.
+
+Description:
+		synchronous send/receive/reply ipc
+
+History:
+
+Date           Author       Notes
+----------     -------      -------------------------
+2026-10-19     deeve        Create
+2026-10-19     deeve        Unwind nested priority donation of a server
+
+*******************************************************************************/
+
+/******************************************************************************
+ *                                 Includes                                   *
+ ******************************************************************************/
+#include "etos_includes.h"
+
+/******************************************************************************
+ *                                 Defines                                    *
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                 Global Variables                           *
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                 Local Variables                            *
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                 Local Functions                            *
+ ******************************************************************************/
+
+#if (ETOS_IPC_ENABLE)
+
+static BOOL _etos_ipc_is_valid(etos_ipc_t *ipc)
+{
+    return (ipc && (ipc->ipc_check_flag == ETOS_IPC_CHECK_FLAG)) ? TRUE : FALSE;
+}
+
+
+
+/*
+ * take the donation of a call back from the donation chain of the server.
+ * each donation swaps the server with the client, so the server holds the priority of the
+ * latest donated client, and each donated client holds the priority of the one donated
+ * before it. the task which holds the priority of the replied client is the server or
+ * the client donated just after it, swapping with it restores the client and keeps the chain
+ */
+static void _etos_ipc_undonate_idic(etos_tcb_t *pt_server, etos_ipc_call_t *call)
+{
+    etos_ipc_call_t *pt_next = NULL;
+    etos_ipc_call_t *pt_donated = pt_server->ipc_donated;
+    etos_task_handle holder = pt_server->task_handle;
+
+    while (pt_donated && (pt_donated != call)) {
+        pt_next = pt_donated;
+        pt_donated = pt_donated->prev_donated;
+    }
+
+    if (pt_donated == NULL) {
+        return;
+    }
+
+    if (pt_next) {
+        holder = pt_next->client;
+        pt_next->prev_donated = call->prev_donated;
+    } else {
+        pt_server->ipc_donated = call->prev_donated;
+    }
+
+    call->prev_donated = NULL;
+
+    /*do not swap if the priorities are changed by others during serving*/
+    if (((etos_tcb_t *)holder)->priority == call->client_priority) {
+        etos_sched_swap_priority_idic(holder, call->client);
+    }
+}
+
+#endif
+
+/******************************************************************************
+ *                                 Global Functions                           *
+ ******************************************************************************/
+
+/**
+ * create an ipc channel.
+ *
+ * @param[out]   ipc_handle    output handle for other ipc API
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @see        etos_ipc_destroy()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_ipc_create(etos_ipc_handle *ipc_handle)
+{
+#if (ETOS_IPC_ENABLE)
+    etos_ipc_t *ipc;
+
+    if (ipc_handle == NULL) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    ipc = (etos_ipc_t *)malloc(sizeof(etos_ipc_t));
+    if (ipc == NULL) {
+        return ETOS_NO_MEM;
+    }
+
+    memset(ipc, 0, sizeof(etos_ipc_t));
+    etos_waitq_init(&ipc->send_waitq, NULL);
+    etos_waitq_init(&ipc->recv_waitq, NULL);
+    ipc->ipc_check_flag = ETOS_IPC_CHECK_FLAG;
+
+    *ipc_handle = (etos_ipc_handle)ipc;
+
+    return ETOS_RET_OK;
+#else
+    ipc_handle = ipc_handle;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+
+/**
+ * destroy an ipc channel.
+ *
+ * @param[in]    ipc_handle
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail, a client or server is using the channel
+ *
+ * @see        etos_ipc_create()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_ipc_destroy(etos_ipc_handle ipc_handle)
+{
+#if (ETOS_IPC_ENABLE)
+    etos_ipc_t *ipc = (etos_ipc_t *)ipc_handle;
+    etos_init_critical();
+
+    if (!_etos_ipc_is_valid(ipc)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    etos_enter_critical();
+
+    if (!etos_waitq_is_empty(&ipc->send_waitq) || !etos_waitq_is_empty(&ipc->recv_waitq)
+        || ipc->serving_cnt) {
+        etos_exit_critical();
+        return ETOS_NOT_SUPPORT;
+    }
+
+    ipc->ipc_check_flag = 0;
+
+    etos_exit_critical();
+
+    free(ipc);
+
+    return ETOS_RET_OK;
+#else
+    ipc_handle = ipc_handle;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+
+/**
+ * call the server of an ipc channel.
+ * the caller blocks until the server replies, the request is passed by reference
+ *
+ * @param[in]     ipc_handle
+ * @param[in]     req          request, it is read by server directly
+ * @param[in]     req_len
+ * @param[out]    resp         response buffer, can be NULL
+ * @param[inout]  resp_len     in: size of resp, out: length of response, can be NULL
+ *
+ * @return   the status given by etos_ipc_reply(), or fail code of call
+ *
+ * @note       do not call this API in an interrupt context, it has no timeout because
+ *             the server may be using the request
+ * @see        etos_ipc_receive()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_ipc_call(etos_ipc_handle ipc_handle, const void *req, u32 req_len, void *resp, u32 *resp_len)
+{
+#if (ETOS_IPC_ENABLE)
+    s32 ret;
+    etos_ipc_call_t call;
+    etos_wait_node_t *pt_node;
+    etos_ipc_t *ipc = (etos_ipc_t *)ipc_handle;
+    etos_init_critical();
+
+    if (!_etos_ipc_is_valid(ipc)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    call.req = req;
+    call.req_len = req_len;
+    call.resp = resp;
+    call.resp_size = (resp && resp_len) ? *resp_len : 0;
+    call.resp_len = 0;
+    call.server = 0;
+    call.donated = FALSE;
+    call.client = 0;
+    call.client_priority = 0;
+    call.prev_donated = NULL;
+
+    etos_enter_critical();
+
+    pt_node = etos_waitq_prepare_idic(&ipc->send_waitq, ETOS_TASK_PENDING_IPC, ETOS_WAIT_FOREVER, (u32)&call, 0);
+    if (pt_node == NULL) {
+        etos_exit_critical();
+        return ETOS_INVALID_PARAM;
+    }
+
+    etos_waitq_wake_one_idic(&ipc->recv_waitq, ETOS_RET_OK, 0);
+
+    /*send blocked until it is received, then reply blocked until it is replied*/
+    ret = etos_waitq_wait_idic(pt_node);
+
+    etos_exit_critical();
+
+    if (resp_len) {
+        *resp_len = call.resp_len;
+    }
+
+    return ret;
+#else
+    ipc_handle = ipc_handle;
+    req = req;
+    req_len = req_len;
+    resp = resp;
+    resp_len = resp_len;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+
+/**
+ * receive a call.
+ * the server runs at the priority of the client until it replies if the client is higher
+ *
+ * @param[in]    ipc_handle
+ * @param[out]   client           the client to reply
+ * @param[out]   req              request of the client
+ * @param[out]   req_len          can be NULL
+ * @param[in]    timeout_ticks    0: do not wait, ETOS_WAIT_FOREVER: wait until a client calls
+ *
+ * @return
+ * @retval 0                  success
+ * @retval ETOS_RET_BUSY      there is no client and timeout_ticks is 0
+ * @retval ETOS_RET_TIMEOUT   timeout
+ * @retval other              fail
+ *
+ * @note       do not call this API in an interrupt context
+ * @see        etos_ipc_reply()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_ipc_receive(etos_ipc_handle ipc_handle, etos_task_handle *client, const void **req, u32 *req_len,
+                     u32 timeout_ticks)
+{
+#if (ETOS_IPC_ENABLE)
+    s32 ret;
+    s32 left_ticks;
+    etos_tick deadline;
+    etos_tcb_t *pt_server;
+    etos_tcb_t *pt_client;
+    etos_ipc_call_t *call;
+    etos_wait_node_t *pt_node;
+    etos_ipc_t *ipc = (etos_ipc_t *)ipc_handle;
+    etos_task_handle task_handle = etos_sched_get_current_task();
+    etos_init_critical();
+
+    if (!_etos_ipc_is_valid(ipc) || (client == NULL) || (req == NULL)
+        || !ETOS_TASK_HANDLE_IS_VALID(task_handle)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    pt_server = (etos_tcb_t *)task_handle;
+
+    etos_enter_critical();
+
+    deadline = etos_sched_get_tick() + timeout_ticks;
+
+    while ((pt_node = etos_waitq_peek_idic(&ipc->send_waitq)) == NULL) {
+        if (timeout_ticks == 0) {
+            etos_exit_critical();
+            return ETOS_RET_BUSY;
+        }
+
+        ret = etos_waitq_pend_idic(&ipc->recv_waitq, ETOS_TASK_PENDING_IPC, timeout_ticks, 0, 0);
+        if (ret != ETOS_RET_OK) {
+            etos_exit_critical();
+            return ret;
+        }
+
+        /*another server may receive the client first, wait the rest ticks*/
+        if (timeout_ticks != ETOS_WAIT_FOREVER) {
+            left_ticks = (s32)(deadline - etos_sched_get_tick());
+            if (left_ticks <= 0) {
+                etos_exit_critical();
+                return ETOS_RET_TIMEOUT;
+            }
+            timeout_ticks = (u32)left_ticks;
+        }
+    }
+
+    /*the client keeps pending out of the channel, only etos_ipc_reply() wakes it*/
+    etos_waitq_move_idic(pt_node, NULL);
+
+    pt_client = pt_node->pt_os_task_tcb;
+    call = (etos_ipc_call_t *)pt_node->wait_arg;
+    call->server = task_handle;
+    call->client = pt_client->task_handle;
+    call->client_priority = pt_client->priority;
+
+    /*donate the priority of the client, it is pending so the priorities can be swapped*/
+    if (pt_client->priority > pt_server->priority) {
+        if (etos_sched_swap_priority_idic(task_handle, pt_client->task_handle) == ETOS_RET_OK) {
+            call->donated = TRUE;
+            call->prev_donated = pt_server->ipc_donated;
+            pt_server->ipc_donated = call;
+        }
+    }
+
+    ipc->serving_cnt++;
+
+    etos_exit_critical();
+
+    *client = pt_client->task_handle;
+    *req = call->req;
+    if (req_len) {
+        *req_len = call->req_len;
+    }
+
+    return ETOS_RET_OK;
+#else
+    ipc_handle = ipc_handle;
+    client = client;
+    req = req;
+    req_len = req_len;
+    timeout_ticks = timeout_ticks;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+
+/**
+ * reply a client.
+ * the response is copied to the buffer of the client, the client is resumed and
+ * the server gets its own priority back
+ *
+ * @param[in]    ipc_handle
+ * @param[in]    client      which is returned by etos_ipc_receive()
+ * @param[in]    status      returned by etos_ipc_call()
+ * @param[in]    resp        can be NULL
+ * @param[in]    resp_len    it is truncated to the size of client buffer
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail, the client is not received by the caller
+ *
+ * @see        etos_ipc_receive()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_ipc_reply(etos_ipc_handle ipc_handle, etos_task_handle client, s32 status, const void *resp,
+                   u32 resp_len)
+{
+#if (ETOS_IPC_ENABLE)
+    etos_tcb_t *pt_server;
+    etos_ipc_call_t *call;
+    etos_wait_node_t *pt_node;
+    etos_ipc_t *ipc = (etos_ipc_t *)ipc_handle;
+    etos_task_handle task_handle = etos_sched_get_current_task();
+    etos_init_critical();
+
+    if (!_etos_ipc_is_valid(ipc) || !ETOS_TASK_HANDLE_IS_VALID(client)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    pt_server = (etos_tcb_t *)task_handle;
+    pt_node = etos_waitq_get_node(client);
+
+    etos_enter_critical();
+
+    /*a received client is pending out of any wait queue*/
+    if (!(((etos_tcb_t *)client)->task_state & ETOS_TASK_PENDING_IPC)
+        || (pt_node->reason != ETOS_TASK_PENDING_IPC) || pt_node->waitq) {
+        etos_exit_critical();
+        return ETOS_INVALID_PARAM;
+    }
+
+    call = (etos_ipc_call_t *)pt_node->wait_arg;
+    if (call->server != task_handle) {
+        etos_exit_critical();
+        return ETOS_INVALID_PARAM;
+    }
+
+    if (resp_len > call->resp_size) {
+        resp_len = call->resp_size;
+    }
+
+    if (resp && resp_len) {
+        memcpy(call->resp, resp, resp_len);
+    }
+    call->resp_len = resp_len;
+
+    /*give the donated priority back, the replied client may not be the latest received one*/
+    if (call->donated) {
+        _etos_ipc_undonate_idic(pt_server, call);
+    }
+
+    ipc->serving_cnt--;
+
+    etos_waitq_wake_node_idic(pt_node, status, 0);
+
+    etos_exit_critical();
+
+    return ETOS_RET_OK;
+#else
+    ipc_handle = ipc_handle;
+    client = client;
+    status = status;
+    resp = resp;
+    resp_len = resp_len;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+/* EOF */
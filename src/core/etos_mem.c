@@ -18,6 +18,13 @@ Date           Author       Notes
 ----------     -------      -------------------------
 2013-10-19     deeve        Create
 2015-4-14      deeve        Add some comments
+2026-10-19     deeve        Add trace points
+2026-10-19     deeve        Find fallback block size by non-empty bitmap
+2026-10-19     deeve        Add per task memory accounting and quota
+2026-10-19     deeve        Add buddy backend for large and bursty buffers
+2026-10-19     deeve        Add etos_mem_get_block_size()
+2026-10-19     deeve        Move memory usage of destroyed task to ISR account
+2026-10-19     deeve        Select buddy pool for a block size by etos_mem_buddy_select()
 
 *******************************************************************************/
 
@@ -30,6 +37,11 @@ Date           Author       Notes
  *                                 Defines                                    *
  ******************************************************************************/
 #define MEM_CHECK_FLAG     (0xdeadbeef)
+#define MEM_MAX_ITEMS      (32)   /* one bit of nonempty_bitmap for each block size */
+
+#define MEM_BUDDY_USED_FLAG    (0xdeadb0dd)
+#define MEM_BUDDY_FREE_FLAG    (0xfeedb0dd)
+#define MEM_BUDDY_MAX_ORDERS   (32)   /* one bit of nonempty_bitmap for each order */
 
 /*内存池定义区*/
 
@@ -45,6 +57,10 @@ typedef struct _mem_block {
     list_t  list;
     u32 block_id;  /* blk_headers[]的下标，释放的时候用它来将该block归还 */
     u32 user_len;
+#if (ETOS_MEM_ACCOUNT_ENABLE)
+    etos_task_handle owner;  /* 计入该task的内存使用, ETOS_MEM_OWNER_ISR: ISR或boot code */
+    u32 owner_id;            /* owner的mem_owner_id, 不相等说明owner已被destroy */
+#endif
     u8 user_data[0];
 } mem_block_t;
 
@@ -54,10 +70,27 @@ typedef struct _mem_pool_header {
     u32 max_block_size;
     u32 valid_items;
     u32 base_id_of_blk_size;    /* 2**base_id_of_blk_size = min_block_size */
+    u32 nonempty_bitmap;        /* bit n is set if blk_headers[n] has free block */
+    u32 buddy_bitmap;           /* bit n is set if the length of blk_headers[n] is malloc-ed from buddy pool first */
     mem_block_header_t blk_headers[0];
 } mem_pool_header_t;
 
 
+/*
+ * buddy pool, a block of order n is 2**(min_order+n) bytes including mem_block_t,
+ * mem_block_t.block_id is the order, check_flag tells it is free or used
+ */
+typedef struct _mem_buddy_header {
+    u8  *base;                  /* offset of a block is relative to it */
+    u32 len;
+    u32 min_order;              /* 2**min_order = ETOS_MEM_BUDDY_MIN_BLOCK_SIZE */
+    u32 order_num;
+    u32 nonempty_bitmap;        /* bit n is set if free_list[n] is not empty */
+    list_t free_list[MEM_BUDDY_MAX_ORDERS];
+    etos_mem_buddy_stat_t stat;
+} mem_buddy_header_t;
+
+
 /******************************************************************************
  *                                 Global Variables                           *
  ******************************************************************************/
@@ -68,6 +101,18 @@ typedef struct _mem_pool_header {
 
 static mem_pool_header_t *_os_pt_mem_pool_head;
 
+#if (ETOS_MEM_BUDDY_ENABLE)
+static mem_buddy_header_t *_os_pt_mem_buddy_head;
+#endif
+
+#if (ETOS_MEM_ACCOUNT_ENABLE)
+/* memory usage of ISR and boot code, and the blocks left by destroyed tasks */
+static etos_mem_stat_t _os_mem_isr_stat;
+
+/* last mem_owner_id given to a task, 0 is not used */
+static u32 _os_mem_owner_id;
+#endif
+
 
 
 
@@ -106,6 +151,364 @@ static inline u32 _etos_aligned_to_power_of_2(u32 n)
     }
 }
 
+
+/* keep nonempty_bitmap in sync with free_block_num, it is called in disable interrupt context */
+static inline void _etos_mem_update_bitmap_idic(u32 block_id)
+{
+    if (_os_pt_mem_pool_head->blk_headers[block_id].free_block_num) {
+        _os_pt_mem_pool_head->nonempty_bitmap |= (1UL << block_id);
+    } else {
+        _os_pt_mem_pool_head->nonempty_bitmap &= ~(1UL << block_id);
+    }
+}
+
+
+#if (ETOS_MEM_BUDDY_ENABLE)
+
+static inline u32 _etos_mem_buddy_block_size(u32 order)
+{
+    return 1UL << (_os_pt_mem_buddy_head->min_order + order);
+}
+
+
+static inline void _etos_mem_buddy_update_bitmap_idic(u32 order)
+{
+    if (list_is_empty(&_os_pt_mem_buddy_head->free_list[order])) {
+        _os_pt_mem_buddy_head->nonempty_bitmap &= ~(1UL << order);
+    } else {
+        _os_pt_mem_buddy_head->nonempty_bitmap |= (1UL << order);
+    }
+}
+
+
+static void _etos_mem_buddy_put_free_idic(mem_block_t *pt_block, u32 order)
+{
+    pt_block->check_flag = MEM_BUDDY_FREE_FLAG;
+    pt_block->block_id = order;
+    pt_block->user_len = 0;
+    list_add_tail(&pt_block->list, &_os_pt_mem_buddy_head->free_list[order]);
+    _os_pt_mem_buddy_head->nonempty_bitmap |= (1UL << order);
+}
+
+#endif
+
+
+#if (ETOS_MEM_ACCOUNT_ENABLE)
+
+/* owner of a new block: current task, or ETOS_MEM_OWNER_ISR in ISR and boot code */
+static etos_task_handle _etos_mem_current_owner(void)
+{
+    etos_task_handle task_handle;
+
+    if (etos_intr_in_isr()) {
+        return ETOS_MEM_OWNER_ISR;
+    }
+
+    task_handle = etos_sched_get_current_task();
+
+    return ETOS_TASK_HANDLE_IS_VALID(task_handle) ? task_handle : ETOS_MEM_OWNER_ISR;
+}
+
+
+/* NULL if the task is not created */
+static etos_mem_stat_t *_etos_mem_owner_stat(etos_task_handle owner)
+{
+    if (owner == ETOS_MEM_OWNER_ISR) {
+        return &_os_mem_isr_stat;
+    }
+
+    if (ETOS_TASK_HANDLE_IS_VALID(owner)) {
+        return &((etos_tcb_t *)owner)->mem_stat;
+    }
+
+    return NULL;
+}
+
+
+/* the account which the block is counted to, blocks of a destroyed task are in ISR account */
+static etos_mem_stat_t *_etos_mem_block_stat(mem_block_t *pt_mem_blk)
+{
+    etos_tcb_t *pt_os_task_tcb = (etos_tcb_t *)pt_mem_blk->owner;
+
+    /* the slot of a destroyed owner may be reused by a new task, owner_id is different then */
+    if ((pt_mem_blk->owner != ETOS_MEM_OWNER_ISR) && ETOS_TASK_HANDLE_IS_VALID(pt_mem_blk->owner)
+        && (pt_os_task_tcb->mem_owner_id == pt_mem_blk->owner_id)) {
+        return &pt_os_task_tcb->mem_stat;
+    }
+
+    return &_os_mem_isr_stat;
+}
+
+
+static void _etos_mem_set_owner_idic(mem_block_t *pt_mem_blk, etos_task_handle owner)
+{
+    pt_mem_blk->owner = owner;
+    pt_mem_blk->owner_id = (owner == ETOS_MEM_OWNER_ISR) ? 0 : ((etos_tcb_t *)owner)->mem_owner_id;
+}
+
+
+static u32 _etos_mem_block_size(mem_block_t *pt_mem_blk)
+{
+#if (ETOS_MEM_BUDDY_ENABLE)
+    if (pt_mem_blk->check_flag == MEM_BUDDY_USED_FLAG) {
+        return _etos_mem_buddy_block_size(pt_mem_blk->block_id);
+    }
+#endif
+
+    return _os_pt_mem_pool_head->min_block_size << pt_mem_blk->block_id;
+}
+
+
+/* the block is not taken if current context would use more than its quota */
+static BOOL _etos_mem_over_quota_idic(u32 block_size)
+{
+    etos_mem_stat_t *stat = _etos_mem_owner_stat(_etos_mem_current_owner());
+
+    if (stat->quota_bytes && (stat->live_bytes + block_size > stat->quota_bytes)) {
+        stat->quota_fail_cnt++;
+        return TRUE;
+    }
+
+    return FALSE;
+}
+
+
+static void _etos_mem_charge_idic(etos_mem_stat_t *stat, u32 live_bytes, u32 block_num)
+{
+    stat->live_bytes += live_bytes;
+    stat->block_num += block_num;
+    if (stat->peak_bytes < stat->live_bytes) {
+        stat->peak_bytes = stat->live_bytes;
+    }
+}
+
+
+static void _etos_mem_uncharge_idic(etos_mem_stat_t *stat, u32 block_size)
+{
+    ASSERT(stat->block_num && (stat->live_bytes >= block_size));
+
+    stat->live_bytes -= block_size;
+    stat->block_num--;
+}
+
+#endif
+
+
+/* index of blk_headers[] for len, valid_items if len is larger than the largest block size */
+static u32 _etos_mem_pool_block_id(u32 len)
+{
+    if (len <= _os_pt_mem_pool_head->min_block_size) {
+        return 0;
+    }
+
+    if (len > _os_pt_mem_pool_head->max_block_size) {
+        return _os_pt_mem_pool_head->valid_items;
+    }
+
+    return etos_log_base_2(_etos_aligned_to_power_of_2(len)) - _os_pt_mem_pool_head->base_id_of_blk_size;
+}
+
+
+/* take a block from the fixed block size pool */
+static s32 _etos_mem_pool_alloc_idic(u32 len, mem_block_t **pt_blk)
+{
+    mem_block_t *pt_mem_blk;
+    mem_block_header_t *pt_mem_blk_header;
+    list_t *entry;
+    u32 used_blk_num;
+    u32 block_id, mask;
+
+    if (_os_pt_mem_pool_head == NULL) {
+        return ETOS_NO_MEM;
+    }
+
+    block_id = _etos_mem_pool_block_id(len);
+    if (block_id >= _os_pt_mem_pool_head->valid_items) {
+        return ETOS_NO_MEM;
+    }
+
+    /* the smallest non-empty block size which is not less than len */
+    mask = _os_pt_mem_pool_head->nonempty_bitmap & ~((1UL << block_id) - 1);
+    if (mask == 0) {
+        return ETOS_NO_MEM;
+    }
+
+    block_id = etos_count_consecutive_0_in_lsb(mask);
+    pt_mem_blk_header = &_os_pt_mem_pool_head->blk_headers[block_id];
+
+#if (ETOS_MEM_ACCOUNT_ENABLE)
+    if (_etos_mem_over_quota_idic(_os_pt_mem_pool_head->min_block_size << block_id)) {
+        return ETOS_RET_FULL;
+    }
+#endif
+
+    /* remove block from list*/
+    entry = list_dequeue(&pt_mem_blk_header->list);
+    pt_mem_blk = list_entry(entry, mem_block_t, list);
+
+    pt_mem_blk_header->free_block_num--;
+    _etos_mem_update_bitmap_idic(block_id);
+
+    /* check it is error or not */
+    ASSERT(pt_mem_blk->block_id == block_id);
+
+    used_blk_num = pt_mem_blk_header->total_block_num - pt_mem_blk_header->free_block_num;
+    if (pt_mem_blk_header->max_used_blk_num < used_blk_num) {
+        pt_mem_blk_header->max_used_blk_num = used_blk_num;
+    }
+
+    *pt_blk = pt_mem_blk;
+
+    return ETOS_RET_OK;
+}
+
+
+static void _etos_mem_pool_free_idic(mem_block_t *pt_mem_blk)
+{
+    mem_block_header_t *pt_mem_blk_header;
+
+    ASSERT(pt_mem_blk->check_flag == MEM_CHECK_FLAG);
+
+    pt_mem_blk_header = &_os_pt_mem_pool_head->blk_headers[pt_mem_blk->block_id];
+
+    list_add_tail(&pt_mem_blk->list, &pt_mem_blk_header->list);
+    pt_mem_blk_header->free_block_num++;
+    _etos_mem_update_bitmap_idic(pt_mem_blk->block_id);
+}
+
+
+#if (ETOS_MEM_BUDDY_ENABLE)
+
+/* take a block from the buddy pool, a larger free block is split until it fits */
+static s32 _etos_mem_buddy_alloc_idic(u32 len, mem_block_t **pt_blk)
+{
+    u32 order, found, mask, block_size;
+    mem_block_t *pt_block, *pt_buddy;
+    mem_buddy_header_t *pt_buddy_head = _os_pt_mem_buddy_head;
+
+    if (pt_buddy_head == NULL) {
+        return ETOS_NO_MEM;
+    }
+
+    if (len > pt_buddy_head->len) {
+        pt_buddy_head->stat.fail_cnt++;
+        return ETOS_NO_MEM;
+    }
+
+    order = etos_log_base_2(_etos_aligned_to_power_of_2(len + sizeof(mem_block_t)));
+    order = (order > pt_buddy_head->min_order) ? (order - pt_buddy_head->min_order) : 0;
+
+    mask = (order < pt_buddy_head->order_num) ? (pt_buddy_head->nonempty_bitmap & ~((1UL << order) - 1)) : 0;
+    if (mask == 0) {
+        pt_buddy_head->stat.fail_cnt++;
+        return ETOS_NO_MEM;
+    }
+
+    block_size = _etos_mem_buddy_block_size(order);
+
+#if (ETOS_MEM_ACCOUNT_ENABLE)
+    if (_etos_mem_over_quota_idic(block_size)) {
+        return ETOS_RET_FULL;
+    }
+#endif
+
+    found = etos_count_consecutive_0_in_lsb(mask);
+    pt_block = list_entry(list_dequeue(&pt_buddy_head->free_list[found]), mem_block_t, list);
+    _etos_mem_buddy_update_bitmap_idic(found);
+
+    ASSERT(pt_block->check_flag == MEM_BUDDY_FREE_FLAG);
+
+    /* the upper half of each split is a free buddy */
+    while (found > order) {
+        found--;
+        pt_buddy = (mem_block_t *)((u8 *)pt_block + _etos_mem_buddy_block_size(found));
+        _etos_mem_buddy_put_free_idic(pt_buddy, found);
+        pt_buddy_head->stat.split_cnt++;
+    }
+
+    pt_block->check_flag = MEM_BUDDY_USED_FLAG;
+    pt_block->block_id = order;
+
+    pt_buddy_head->stat.free_bytes -= block_size;
+    if (pt_buddy_head->stat.min_free_bytes > pt_buddy_head->stat.free_bytes) {
+        pt_buddy_head->stat.min_free_bytes = pt_buddy_head->stat.free_bytes;
+    }
+    pt_buddy_head->stat.used_block_num++;
+    pt_buddy_head->stat.waste_bytes += block_size - len;
+
+    *pt_blk = pt_block;
+
+    return ETOS_RET_OK;
+}
+
+
+/* return a block to the buddy pool, it is merged with its free buddy as long as possible */
+static void _etos_mem_buddy_free_idic(mem_block_t *pt_block)
+{
+    u32 order, block_size, buddy_offset;
+    mem_block_t *pt_buddy;
+    mem_buddy_header_t *pt_buddy_head = _os_pt_mem_buddy_head;
+
+    order = pt_block->block_id;
+    block_size = _etos_mem_buddy_block_size(order);
+
+    pt_buddy_head->stat.free_bytes += block_size;
+    pt_buddy_head->stat.used_block_num--;
+    pt_buddy_head->stat.waste_bytes -= block_size - pt_block->user_len;
+
+    /* the largest blocks are carved side by side, they are not buddies */
+    while (order + 1 < pt_buddy_head->order_num) {
+        buddy_offset = ((u8 *)pt_block - pt_buddy_head->base) ^ block_size;
+        if (buddy_offset + block_size > pt_buddy_head->len) {
+            break;
+        }
+
+        pt_buddy = (mem_block_t *)(pt_buddy_head->base + buddy_offset);
+        if ((pt_buddy->check_flag != MEM_BUDDY_FREE_FLAG) || (pt_buddy->block_id != order)) {
+            break;
+        }
+
+        list_del(&pt_buddy->list);
+        _etos_mem_buddy_update_bitmap_idic(order);
+
+        /* the upper half is not a block any more */
+        if (pt_buddy < pt_block) {
+            pt_block->check_flag = 0;
+            pt_block = pt_buddy;
+        } else {
+            pt_buddy->check_flag = 0;
+        }
+
+        order++;
+        block_size <<= 1;
+        pt_buddy_head->stat.merge_cnt++;
+    }
+
+    _etos_mem_buddy_put_free_idic(pt_block, order);
+}
+
+#endif
+
+
+/* a block is taken, set its user length and owner */
+static void *_etos_mem_alloc_done_idic(mem_block_t *pt_mem_blk, u32 len)
+{
+#if (ETOS_MEM_ACCOUNT_ENABLE)
+    etos_task_handle owner = _etos_mem_current_owner();
+#endif
+
+    pt_mem_blk->user_len = len;
+
+#if (ETOS_MEM_ACCOUNT_ENABLE)
+    _etos_mem_set_owner_idic(pt_mem_blk, owner);
+    _etos_mem_charge_idic(_etos_mem_owner_stat(owner), _etos_mem_block_size(pt_mem_blk), 1);
+#endif
+
+    ETOS_TRACE_IDIC(ETOS_TRACE_EVT_MALLOC, (u16)len, (u32)(pt_mem_blk->user_data));
+
+    return (void *)(pt_mem_blk->user_data);
+}
+
 /******************************************************************************
  *                                 Global Functions                           *
  ******************************************************************************/
@@ -137,6 +540,7 @@ u32 etos_log_base_2(u32 n)
  * @retval 0                success
  * @retval other value      fail
  *
+ * @note   at most 32 block sizes
  * @authors    deeve
  * @date       2013/10/19
  */
@@ -180,12 +584,18 @@ s32 etos_mem_pool_init(u8 *mem_start, mem_pool_item_t pool_items[],
         }
     }
 
+    if (valid_items > MEM_MAX_ITEMS) {
+        return ETOS_INVALID_PARAM;
+    }
+
     max_blk_size = last_size;
 
     _os_pt_mem_pool_head = (mem_pool_header_t *) n_bits_align_up(mem_start, 4);
     _os_pt_mem_pool_head->min_block_size = min_blk_size;
     _os_pt_mem_pool_head->max_block_size = max_blk_size;
     _os_pt_mem_pool_head->valid_items = valid_items;
+    _os_pt_mem_pool_head->nonempty_bitmap = 0;
+    _os_pt_mem_pool_head->buddy_bitmap = 0;
 
 #if 1
     _os_pt_mem_pool_head->base_id_of_blk_size = etos_log_base_2(min_blk_size);
@@ -200,6 +610,7 @@ s32 etos_mem_pool_init(u8 *mem_start, mem_pool_item_t pool_items[],
         pt_blk_header->total_block_num = pool_items[i].block_num;
         pt_blk_header->free_block_num = pool_items[i].block_num;
         pt_blk_header->max_used_blk_num = 0;
+        _etos_mem_update_bitmap_idic(i);
     }
 
     pt_block_first = (mem_block_t *) &_os_pt_mem_pool_head->blk_headers[valid_items];
@@ -250,6 +661,9 @@ s32 etos_mem_destroy(void)
     }
 
     _os_pt_mem_pool_head = NULL;
+#if (ETOS_MEM_BUDDY_ENABLE)
+    _os_pt_mem_buddy_head = NULL;
+#endif
 
     return ETOS_RET_OK;
 }
@@ -274,7 +688,7 @@ s32 etos_mem_destroy(void)
 s32 etos_mem_pool_add(u8 *mem_start, u8 *mem_end, u32 blk_size)
 {
     u32 block_id;
-    u32 total_size_add, total_blks_add;
+    u32 total_size_add, total_blks_add, blks_add;
     register mem_pool_header_t *pt_mem_pool_head;
     mem_block_t *pt_block, *pt_block_first;
     list_t *pt_blk_head_list;
@@ -310,6 +724,7 @@ s32 etos_mem_pool_add(u8 *mem_start, u8 *mem_end, u32 blk_size)
     if (total_blks_add == 0) {
         return ETOS_INVALID_PARAM;
     }
+    blks_add = total_blks_add;
 
     block_id = etos_log_base_2(blk_size);
     block_id -= pt_mem_pool_head->base_id_of_blk_size;
@@ -341,6 +756,9 @@ s32 etos_mem_pool_add(u8 *mem_start, u8 *mem_end, u32 blk_size)
     /* add to corresponding block list tail*/
     etos_enter_critical();
     list_splice(pt_blk_head_list, pt_mem_pool_head->blk_headers[block_id].list.prev);
+    pt_mem_pool_head->blk_headers[block_id].total_block_num += blks_add;
+    pt_mem_pool_head->blk_headers[block_id].free_block_num += blks_add;
+    _etos_mem_update_bitmap_idic(block_id);
     etos_exit_critical();
 
     return ETOS_RET_OK;
@@ -348,80 +766,123 @@ s32 etos_mem_pool_add(u8 *mem_start, u8 *mem_end, u32 blk_size)
 
 
 /**
- * malloc a memory from memory pool.
- * just malloc a memory, it usage is same as malloc()
+ * init buddy memory pool.
+ * the memory is split and merged on demand, etos_mem_malloc() uses it when the length is
+ * larger than the largest block size, or the block size is used up
  *
- * @param[in]    len   the length of memory
+ * @param[in]    mem_start    the start address of buddy memory
+ * @param[in]    mem_end      the end address of buddy memory
  *
  * @return
- * @retval 0(NULL)        fail
- * @retval other value    success
+ * @retval 0       success
+ * @retval other   fail
  *
- * @note none
- * @see        etos_mem_free()
+ * @note   there is only one buddy pool, the memory is freed by etos_mem_free()
  * @authors    deeve
- * @date       2013/10/19
+ * @date       2026/10/19
  */
-void *etos_mem_malloc(u32 len)
+s32 etos_mem_buddy_init(u8 *mem_start, u8 *mem_end)
 {
-    mem_block_t *pt_mem_blk;
-    mem_block_header_t *pt_mem_blk_header;
-    list_t *entry;
-    u32 used_blk_num;
-    u32 block_id, valid_items, search_count;
-    u32 aligned_len, usr_len;
+#if (ETOS_MEM_BUDDY_ENABLE)
+    u32 len, order, top_order, min_order, offset;
+    mem_buddy_header_t *pt_buddy_head;
+    u8 *base;
     etos_init_critical();
 
-    if (_os_pt_mem_pool_head == NULL || (len == 0)) {
-        return NULL;
+    if ((mem_start == NULL) || (mem_end == NULL)) {
+        return ETOS_INVALID_PARAM;
     }
 
-    usr_len = len;
-    aligned_len = _etos_aligned_to_power_of_2(len);
-    search_count = 1;
+    if (_os_pt_mem_buddy_head) {
+        return ETOS_NOT_SUPPORT;
+    }
 
-    valid_items = _os_pt_mem_pool_head->valid_items;
-    block_id = etos_log_base_2(aligned_len);
-    block_id -= _os_pt_mem_pool_head->base_id_of_blk_size;
-    pt_mem_blk_header = &_os_pt_mem_pool_head->blk_headers[block_id];
+    min_order = etos_log_base_2(ETOS_MEM_BUDDY_MIN_BLOCK_SIZE);
+    if (!_etos_is_power_of_2(ETOS_MEM_BUDDY_MIN_BLOCK_SIZE) || (ETOS_MEM_BUDDY_MIN_BLOCK_SIZE <= sizeof(mem_block_t))) {
+        return ETOS_INVALID_PARAM;
+    }
 
-    if (block_id >= valid_items) {
-        return NULL;
+    pt_buddy_head = (mem_buddy_header_t *) n_bits_align_up(mem_start, 4);
+    base = (u8 *) n_bits_align_up(pt_buddy_head + 1, 4);
+    mem_end = (u8 *) n_bits_align_down(mem_end, 4);
+
+    if ((mem_end <= base) || ((u32)(mem_end - base) < ETOS_MEM_BUDDY_MIN_BLOCK_SIZE)) {
+        return ETOS_INVALID_PARAM;
     }
 
-    do {
-        if (pt_mem_blk_header->free_block_num > 0) {
+    len = mem_end - base;
+    top_order = etos_log_base_2(len);
+    if (top_order - min_order >= MEM_BUDDY_MAX_ORDERS) {
+        top_order = min_order + MEM_BUDDY_MAX_ORDERS - 1;
+    }
 
-            etos_enter_critical();
+    memset(pt_buddy_head, 0, sizeof(mem_buddy_header_t));
+    pt_buddy_head->base = base;
+    pt_buddy_head->len = len;
+    pt_buddy_head->min_order = min_order;
+    pt_buddy_head->order_num = top_order - min_order + 1;
+    for (order = 0; order < MEM_BUDDY_MAX_ORDERS; order++) {
+        INIT_LIST_HEAD(&pt_buddy_head->free_list[order]);
+    }
 
-            /* remove block from list*/
-            entry = list_dequeue(&pt_mem_blk_header->list);
-            pt_mem_blk = list_entry(entry, mem_block_t, list);
+    etos_enter_critical();
 
-            pt_mem_blk_header->free_block_num--;
+    _os_pt_mem_buddy_head = pt_buddy_head;
+
+    /* carve the largest blocks first, the rest is carved into smaller blocks */
+    offset = 0;
+    order = pt_buddy_head->order_num - 1;
+    while (1) {
+        if (offset + _etos_mem_buddy_block_size(order) <= len) {
+            _etos_mem_buddy_put_free_idic((mem_block_t *)(base + offset), order);
+            offset += _etos_mem_buddy_block_size(order);
+        } else if (order) {
+            order--;
+        } else {
+            break;
+        }
+    }
 
-            etos_exit_critical();
+    pt_buddy_head->stat.total_bytes = offset;
+    pt_buddy_head->stat.free_bytes = offset;
+    pt_buddy_head->stat.min_free_bytes = offset;
 
+    etos_exit_critical();
 
-            /* check it is error or not */
-            ASSERT(pt_mem_blk->block_id == block_id);
+    return ETOS_RET_OK;
+#else
+    mem_start = mem_start;
+    mem_end = mem_end;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
 
-            pt_mem_blk->user_len = usr_len;
 
-            used_blk_num = pt_mem_blk_header->total_block_num - pt_mem_blk_header->free_block_num;
-            if (pt_mem_blk_header->max_used_blk_num < used_blk_num) {
-                pt_mem_blk_header->max_used_blk_num = used_blk_num;
-            }
+/**
+ * malloc a memory from memory pool.
+ * just malloc a memory, it usage is same as malloc()
+ *
+ * @param[in]    len   the length of memory
+ *
+ * @return
+ * @retval 0(NULL)        fail
+ * @retval other value    success
+ *
+ * @note   it fails when the memory quota of current task is used up, see etos_mem_set_quota()
+ * @see        etos_mem_free()
+ * @authors    deeve
+ * @date       2013/10/19
+ */
+void *etos_mem_malloc(u32 len)
+{
+    void *ptr;
+    etos_init_critical();
 
-            return (void *)(pt_mem_blk->user_data);
-        } else {
-            block_id++;
-            search_count++;
-            pt_mem_blk_header = &_os_pt_mem_pool_head->blk_headers[block_id];
-        }
-    } while (block_id < valid_items);
+    etos_enter_critical();
+    ptr = etos_mem_malloc_idic(len);
+    etos_exit_critical();
 
-    return NULL;
+    return ptr;
 }
 
 
@@ -436,69 +897,146 @@ void *etos_mem_malloc(u32 len)
  * @retval 0(NULL)        fail
  * @retval other value    success
  *
- * @note none
+ * @note   it fails when the memory quota of current context is used up
  * @see        etos_mem_malloc()
  * @authors    deeve
  * @date       2013/10/19
  */
 void *etos_mem_malloc_idic(u32 len)
 {
+    s32 ret = ETOS_NO_MEM;
     mem_block_t *pt_mem_blk;
-    mem_block_header_t *pt_mem_blk_header;
-    list_t *entry;
-    u32 used_blk_num;
-    u32 block_id, valid_items, search_count;
-    u32 aligned_len, usr_len;
+#if (ETOS_MEM_BUDDY_ENABLE)
+    BOOL buddy_first = FALSE;
+#endif
 
-    if (_os_pt_mem_pool_head == NULL || (len == 0)) {
+    if (len == 0) {
         return NULL;
     }
 
-    usr_len = len;
-    aligned_len = _etos_aligned_to_power_of_2(len);
-    search_count = 1;
+#if (ETOS_MEM_BUDDY_ENABLE)
+    /* the block size is selected by etos_mem_buddy_select(), the fixed blocks are the fallback */
+    if (_os_pt_mem_pool_head && (_etos_mem_pool_block_id(len) < _os_pt_mem_pool_head->valid_items)) {
+        buddy_first = (_os_pt_mem_pool_head->buddy_bitmap >> _etos_mem_pool_block_id(len)) & 1;
+    }
+    if (buddy_first) {
+        ret = _etos_mem_buddy_alloc_idic(len, &pt_mem_blk);
+    }
+#endif
 
-    valid_items = _os_pt_mem_pool_head->valid_items;
-    block_id = etos_log_base_2(aligned_len);
-    block_id -= _os_pt_mem_pool_head->base_id_of_blk_size;
-    pt_mem_blk_header = &_os_pt_mem_pool_head->blk_headers[block_id];
+    if (ret == ETOS_NO_MEM) {
+        ret = _etos_mem_pool_alloc_idic(len, &pt_mem_blk);
+    }
+
+#if (ETOS_MEM_BUDDY_ENABLE)
+    /* larger than the largest block size, or the block sizes are used up */
+    if ((ret == ETOS_NO_MEM) && !buddy_first) {
+        ret = _etos_mem_buddy_alloc_idic(len, &pt_mem_blk);
+    }
+#endif
 
-    if (block_id >= valid_items) {
+    if (ret != ETOS_RET_OK) {
         return NULL;
     }
 
-    do {
-        if (pt_mem_blk_header->free_block_num > 0) {
+    return _etos_mem_alloc_done_idic(pt_mem_blk, len);
+}
 
-            /* remove block from list*/
-            entry = list_dequeue(&pt_mem_blk_header->list);
-            pt_mem_blk = list_entry(entry, mem_block_t, list);
 
-            pt_mem_blk_header->free_block_num--;
 
-            /* check it is error or not */
-            ASSERT(pt_mem_blk->block_id == block_id);
 
-            pt_mem_blk->user_len = usr_len;
+/**
+ * malloc a memory from buddy memory pool.
+ * the fixed block size pool is not used, eg: for large buffers and benchmark
+ *
+ * @param[in]    len   the length of memory
+ *
+ * @return
+ * @retval 0(NULL)        fail
+ * @retval other value    success
+ *
+ * @see        etos_mem_free()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+void *etos_mem_buddy_malloc(u32 len)
+{
+#if (ETOS_MEM_BUDDY_ENABLE)
+    s32 ret;
+    void *ptr = NULL;
+    mem_block_t *pt_mem_blk;
+    etos_init_critical();
 
-            used_blk_num = pt_mem_blk_header->total_block_num - pt_mem_blk_header->free_block_num;
-            if (pt_mem_blk_header->max_used_blk_num < used_blk_num) {
-                pt_mem_blk_header->max_used_blk_num = used_blk_num;
-            }
+    if (len == 0) {
+        return NULL;
+    }
 
-            return (void *)(pt_mem_blk->user_data);
-        } else {
-            block_id++;
-            search_count++;
-            pt_mem_blk_header = &_os_pt_mem_pool_head->blk_headers[block_id];
-        }
-    } while (block_id < valid_items);
+    etos_enter_critical();
+    ret = _etos_mem_buddy_alloc_idic(len, &pt_mem_blk);
+    if (ret == ETOS_RET_OK) {
+        ptr = _etos_mem_alloc_done_idic(pt_mem_blk, len);
+    }
+    etos_exit_critical();
 
+    return ptr;
+#else
+    len = len;
     return NULL;
+#endif
 }
 
 
 
+/**
+ * select buddy pool for a block size of the fixed block size pool.
+ * etos_mem_malloc() of a length which uses blk_size block is taken from buddy pool first,
+ * the fixed blocks are the fallback, eg: for bursty lengths which the fixed count can not serve
+ *
+ * @param[in]    blk_size    block size given in pool items of etos_mem_pool_init()
+ * @param[in]    enable      TRUE: buddy pool first, FALSE: fixed blocks first
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @note   the selected blocks are freed by etos_mem_free() as well
+ * @see        etos_mem_buddy_init()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_mem_buddy_select(u32 blk_size, BOOL enable)
+{
+#if (ETOS_MEM_BUDDY_ENABLE)
+    u32 block_id;
+    etos_init_critical();
+
+    if ((_os_pt_mem_pool_head == NULL) || !_etos_is_power_of_2(blk_size)
+        || (blk_size < _os_pt_mem_pool_head->min_block_size)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    block_id = _etos_mem_pool_block_id(blk_size);
+    if (block_id >= _os_pt_mem_pool_head->valid_items) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    etos_enter_critical();
+    if (enable) {
+        _os_pt_mem_pool_head->buddy_bitmap |= (1UL << block_id);
+    } else {
+        _os_pt_mem_pool_head->buddy_bitmap &= ~(1UL << block_id);
+    }
+    etos_exit_critical();
+
+    return ETOS_RET_OK;
+#else
+    blk_size = blk_size;
+    enable = enable;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
 
 /**
  * free the memory of ptr.
@@ -517,27 +1055,14 @@ void *etos_mem_malloc_idic(u32 len)
  */
 s32 etos_mem_free(void *ptr)
 {
-    mem_block_t *pt_mem_blk;
-    mem_block_header_t *pt_mem_blk_header;
-
+    s32 ret;
     etos_init_critical();
 
-    if (ptr == NULL) {
-        return ETOS_INVALID_PARAM;
-    }
-
-    pt_mem_blk = list_entry(ptr, mem_block_t, user_data);
-
-    ASSERT(pt_mem_blk->check_flag == MEM_CHECK_FLAG);
-
-    pt_mem_blk_header = &_os_pt_mem_pool_head->blk_headers[pt_mem_blk->block_id];
-
     etos_enter_critical();
-    list_add_tail(&pt_mem_blk->list, &pt_mem_blk_header->list);
-    pt_mem_blk_header->free_block_num++;
+    ret = etos_mem_free_idic(ptr);
     etos_exit_critical();
 
-    return ETOS_RET_OK;
+    return ret;
 }
 
 
@@ -561,7 +1086,6 @@ s32 etos_mem_free(void *ptr)
 s32 etos_mem_free_idic(void *ptr)
 {
     mem_block_t *pt_mem_blk;
-    mem_block_header_t *pt_mem_blk_header;
 
     if (ptr == NULL) {
         return ETOS_INVALID_PARAM;
@@ -569,17 +1093,323 @@ s32 etos_mem_free_idic(void *ptr)
 
     pt_mem_blk = list_entry(ptr, mem_block_t, user_data);
 
-    ASSERT(pt_mem_blk->check_flag == MEM_CHECK_FLAG);
+#if (ETOS_MEM_ACCOUNT_ENABLE)
+    _etos_mem_uncharge_idic(_etos_mem_block_stat(pt_mem_blk), _etos_mem_block_size(pt_mem_blk));
+#endif
+    ETOS_TRACE_IDIC(ETOS_TRACE_EVT_FREE, 0, (u32)ptr);
 
-    pt_mem_blk_header = &_os_pt_mem_pool_head->blk_headers[pt_mem_blk->block_id];
+#if (ETOS_MEM_BUDDY_ENABLE)
+    if (pt_mem_blk->check_flag == MEM_BUDDY_USED_FLAG) {
+        _etos_mem_buddy_free_idic(pt_mem_blk);
+        return ETOS_RET_OK;
+    }
+#endif
 
-    list_add_tail(&pt_mem_blk->list, &pt_mem_blk_header->list);
-    pt_mem_blk_header->free_block_num++;
+    _etos_mem_pool_free_idic(pt_mem_blk);
+
+    return ETOS_RET_OK;
+}
+
+
+
+/**
+ * get the block size of ptr.
+ * the size of the block which holds the memory, it is not less than the length of malloc
+ *
+ * @param[in]    ptr    the return value of etos_mem_malloc()
+ *
+ * @return   block size, 0 if ptr is NULL
+ *
+ * @note       the block size is counted by memory quota
+ * @see        etos_mem_malloc()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+u32 etos_mem_get_block_size(void *ptr)
+{
+    if (ptr == NULL) {
+        return 0;
+    }
+
+    return _etos_mem_block_size(list_entry(ptr, mem_block_t, user_data));
+}
+
+
+/**
+ * set memory quota of a task.
+ * etos_mem_malloc() fails when the task would use more than quota bytes of blocks
+ *
+ * @param[in]    task_handle    task, or ETOS_MEM_OWNER_ISR for ISR and boot code
+ * @param[in]    quota_bytes    0: no limit
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @note       the block size is counted, eg: malloc(100) uses 128 bytes
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_mem_set_quota(etos_task_handle task_handle, u32 quota_bytes)
+{
+#if (ETOS_MEM_ACCOUNT_ENABLE)
+    etos_mem_stat_t *stat;
+    etos_init_critical();
+
+    stat = _etos_mem_owner_stat(task_handle);
+    if (stat == NULL) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    etos_enter_critical();
+    stat->quota_bytes = quota_bytes;
+    etos_exit_critical();
+
+    return ETOS_RET_OK;
+#else
+    task_handle = task_handle;
+    quota_bytes = quota_bytes;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+
+/**
+ * get memory usage of a task.
+ *
+ * @param[in]    task_handle    task, or ETOS_MEM_OWNER_ISR for ISR and boot code
+ * @param[out]   stat
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_mem_get_stat(etos_task_handle task_handle, etos_mem_stat_t *stat)
+{
+#if (ETOS_MEM_ACCOUNT_ENABLE)
+    etos_mem_stat_t *owner_stat;
+    etos_init_critical();
+
+    owner_stat = _etos_mem_owner_stat(task_handle);
+    if ((owner_stat == NULL) || (stat == NULL)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    etos_enter_critical();
+    *stat = *owner_stat;
+    etos_exit_critical();
+
+    return ETOS_RET_OK;
+#else
+    task_handle = task_handle;
+    stat = stat;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+
+/**
+ * give a memory to another task in disable interrupt context.
+ * the memory is counted to the new owner from now on
+ *
+ * @param[in]    ptr            the return value of etos_mem_malloc()
+ * @param[in]    task_handle    new owner, or ETOS_MEM_OWNER_ISR
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @note       quota of the new owner is not checked, it only fails its next malloc
+ * @see        etos_mem_take_idic()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_mem_give_idic(void *ptr, etos_task_handle task_handle)
+{
+#if (ETOS_MEM_ACCOUNT_ENABLE)
+    u32 block_size;
+    mem_block_t *pt_mem_blk;
+    etos_mem_stat_t *old_stat, *new_stat;
+
+    new_stat = _etos_mem_owner_stat(task_handle);
+    if ((ptr == NULL) || (new_stat == NULL)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    pt_mem_blk = list_entry(ptr, mem_block_t, user_data);
+
+    ASSERT((pt_mem_blk->check_flag == MEM_CHECK_FLAG) || (pt_mem_blk->check_flag == MEM_BUDDY_USED_FLAG));
+
+    old_stat = _etos_mem_block_stat(pt_mem_blk);
+    if (old_stat != new_stat) {
+        block_size = _etos_mem_block_size(pt_mem_blk);
+        _etos_mem_uncharge_idic(old_stat, block_size);
+        _etos_mem_charge_idic(new_stat, block_size, 1);
+    }
+    _etos_mem_set_owner_idic(pt_mem_blk, task_handle);
+
+    return ETOS_RET_OK;
+#else
+    ptr = ptr;
+    task_handle = task_handle;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+
+/**
+ * take a memory to current context in disable interrupt context.
+ * eg: receiver of a message buffer takes it
+ *
+ * @param[in]    ptr    the return value of etos_mem_malloc()
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @see        etos_mem_give_idic()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_mem_take_idic(void *ptr)
+{
+#if (ETOS_MEM_ACCOUNT_ENABLE)
+    return etos_mem_give_idic(ptr, _etos_mem_current_owner());
+#else
+    ptr = ptr;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+
+/**
+ * start memory account of a new task in disable interrupt context.
+ * clear its statistics and give it a new owner id
+ *
+ * @param[in]    task_handle    the task just created
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @note       called by etos_task_create() after the task handle is valid
+ * @see        etos_mem_account_task_destroy_idic()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_mem_account_task_create_idic(etos_task_handle task_handle)
+{
+#if (ETOS_MEM_ACCOUNT_ENABLE)
+    etos_tcb_t *pt_os_task_tcb = (etos_tcb_t *)task_handle;
+
+    if (!ETOS_TASK_HANDLE_IS_VALID(task_handle)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    memset(&pt_os_task_tcb->mem_stat, 0, sizeof(etos_mem_stat_t));
+
+    if (++_os_mem_owner_id == 0) {
+        _os_mem_owner_id = 1;
+    }
+    pt_os_task_tcb->mem_owner_id = _os_mem_owner_id;
+
+    return ETOS_RET_OK;
+#else
+    task_handle = task_handle;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+
+/**
+ * end memory account of a task in disable interrupt context.
+ * the blocks which the task does not free are counted to ISR account
+ *
+ * @param[in]    task_handle    the task to be destroyed
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @note       called before the task handle is invalid, the blocks are uncharged from
+ *             ISR account when they are freed
+ * @see        etos_mem_account_task_create_idic()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_mem_account_task_destroy_idic(etos_task_handle task_handle)
+{
+#if (ETOS_MEM_ACCOUNT_ENABLE)
+    etos_tcb_t *pt_os_task_tcb = (etos_tcb_t *)task_handle;
+
+    if (!ETOS_TASK_HANDLE_IS_VALID(task_handle)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    _etos_mem_charge_idic(&_os_mem_isr_stat, pt_os_task_tcb->mem_stat.live_bytes,
+                          pt_os_task_tcb->mem_stat.block_num);
+
+    /*blocks with the old owner id are in ISR account from now on*/
+    pt_os_task_tcb->mem_owner_id = 0;
+    memset(&pt_os_task_tcb->mem_stat, 0, sizeof(etos_mem_stat_t));
+
+    return ETOS_RET_OK;
+#else
+    task_handle = task_handle;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+
+/**
+ * get statistics of buddy memory pool.
+ *
+ * @param[out]   stat
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_mem_buddy_get_stat(etos_mem_buddy_stat_t *stat)
+{
+#if (ETOS_MEM_BUDDY_ENABLE)
+    etos_init_critical();
+
+    if (stat == NULL) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    if (_os_pt_mem_buddy_head == NULL) {
+        return ETOS_NOT_INIT;
+    }
+
+    etos_enter_critical();
+    *stat = _os_pt_mem_buddy_head->stat;
+    stat->largest_free_bytes = _os_pt_mem_buddy_head->nonempty_bitmap
+                               ? _etos_mem_buddy_block_size(etos_log_base_2(_os_pt_mem_buddy_head->nonempty_bitmap)) : 0;
+    etos_exit_critical();
 
     return ETOS_RET_OK;
+#else
+    stat = stat;
+    return ETOS_NOT_SUPPORT;
+#endif
 }
 
 
+
 /**
  * report memory statistics.
  * print memory statistics for monitor memory usage
@@ -596,6 +1426,9 @@ s32 etos_mem_report(const char *prompt)
     u32 i, valid_items, block_size;
     mem_block_header_t *pt_blk_header;
     const char *header;
+#if (ETOS_MEM_BUDDY_ENABLE)
+    etos_mem_buddy_stat_t buddy_stat;
+#endif
 
     if (prompt) {
         header = prompt;
@@ -616,6 +1449,24 @@ s32 etos_mem_report(const char *prompt)
         block_size *= 2;
     }
 
+#if (ETOS_MEM_ACCOUNT_ENABLE)
+    /*per task usage is in etos_task_report()*/
+    xlogt(LOG_MODULE_ETOS, "%s: isr(and destroyed task) live:%d peak:%d blocks:%d quota:%d quota_fail:%d\r\n",
+          header, _os_mem_isr_stat.live_bytes, _os_mem_isr_stat.peak_bytes, _os_mem_isr_stat.block_num,
+          _os_mem_isr_stat.quota_bytes, _os_mem_isr_stat.quota_fail_cnt);
+#endif
+
+#if (ETOS_MEM_BUDDY_ENABLE)
+    if (etos_mem_buddy_get_stat(&buddy_stat) == ETOS_RET_OK) {
+        xlogt(LOG_MODULE_ETOS, "%s: buddy total:%d free:%d min_free:%d largest:%d frag:%d%% used:%d waste:%d split:%d merge:%d fail:%d\r\n",
+              header, buddy_stat.total_bytes, buddy_stat.free_bytes, buddy_stat.min_free_bytes,
+              buddy_stat.largest_free_bytes,
+              buddy_stat.free_bytes ? (100 - buddy_stat.largest_free_bytes * 100 / buddy_stat.free_bytes) : 0,
+              buddy_stat.used_block_num, buddy_stat.waste_bytes, buddy_stat.split_cnt, buddy_stat.merge_cnt,
+              buddy_stat.fail_cnt);
+    }
+#endif
+
     return ETOS_RET_OK;
 }
 
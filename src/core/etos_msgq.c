@@ -18,6 +18,18 @@ Date           Author       Notes
 ----------     -------      -------------------------
 2013-10-20     deeve        Create
 2015-4-14      deeve        Add some comments
+2026-10-19     deeve        Add trace points
+2026-10-19     deeve        Receivers wait on generic wait queue
+2026-10-19     deeve        Add etos_msgq_recv_timeout()
+2026-10-19     deeve        Hand over message to one of multiple receivers
+2026-10-19     deeve        Add static message queue with buffer slab
+2026-10-19     deeve        Add message priority bands
+2026-10-19     deeve        Add batch receive and release
+2026-10-19     deeve        Notify queue set
+2026-10-19     deeve        Add depth, throughput and latency statistics
+2026-10-19     deeve        Add queue capacity and blocking send
+2026-10-19     deeve        Receiver takes the ownership of message buffer
+2026-10-19     deeve        Report latency in us
 
 *******************************************************************************/
 
@@ -30,6 +42,11 @@ Date           Author       Notes
  *                                 Defines                                    *
  ******************************************************************************/
 
+/*buffer size in slab, keep every buffer header 4 bytes aligned*/
+#define MSGQ_SLAB_BUF_SIZE(msg_size)    (sizeof(etos_msgq_buf_t) + (((msg_size) + 3) & (~3)))
+
+#define MSGQ_LATENCY_AVG_SHIFT          (3)    /*weight of new sample in running average is 1/8*/
+
 /******************************************************************************
  *                                 Global Variables                           *
  ******************************************************************************/
@@ -37,11 +54,199 @@ Date           Author       Notes
 /******************************************************************************
  *                                 Local Variables                            *
  ******************************************************************************/
+static struct list_head _os_msgq_list_head = {&_os_msgq_list_head, &_os_msgq_list_head};
 
 /******************************************************************************
  *                                 Local Functions                            *
  ******************************************************************************/
 
+/*put the buffer back to its slab, or free it if it is malloc-ed*/
+static void _etos_msgq_free_buf_idic(etos_msgq_buf_t *msgq_buf)
+{
+    etos_msgq_head_t *slab_head = msgq_buf->slab_head;
+
+    if (slab_head) {
+        list_add_tail(&msgq_buf->list, &slab_head->free_list);
+        slab_head->free_cnt++;
+    } else {
+        free(msgq_buf);
+    }
+}
+
+
+static void _etos_msgq_enqueue_idic(etos_msgq_head_t *msgq_head, etos_msgq_buf_t *msgq_buf, u32 prio)
+{
+    list_add_tail(&msgq_buf->list, &msgq_head->msg_list[prio]);
+
+    if (++msgq_head->stat.band_depth[prio] > msgq_head->stat.band_max_depth[prio]) {
+        msgq_head->stat.band_max_depth[prio] = msgq_head->stat.band_depth[prio];
+    }
+
+    if (++msgq_head->stat.depth > msgq_head->stat.max_depth) {
+        msgq_head->stat.max_depth = msgq_head->stat.depth;
+    }
+}
+
+
+/*the first message of the highest non-empty band, NULL if there is no message*/
+static etos_msgq_buf_t *_etos_msgq_dequeue_idic(etos_msgq_head_t *msgq_head)
+{
+    u32 prio = ETOS_MSGQ_PRIO_BANDS;
+
+    while (prio--) {
+        if (!list_is_empty(&msgq_head->msg_list[prio])) {
+            msgq_head->stat.band_depth[prio]--;
+            msgq_head->stat.depth--;
+            /*there is room now, the sender rechecks it when it runs*/
+            etos_waitq_wake_one_idic(&msgq_head->send_waitq, ETOS_RET_OK, 0);
+            return list_entry(list_dequeue(&msgq_head->msg_list[prio]), etos_msgq_buf_t, list);
+        }
+    }
+
+    return NULL;
+}
+
+
+static BOOL _etos_msgq_is_full(etos_msgq_head_t *msgq_head)
+{
+    return (msgq_head->capacity && (msgq_head->stat.depth >= msgq_head->capacity)) ? TRUE : FALSE;
+}
+
+
+/*drop the oldest message of the lowest non-empty band*/
+static void _etos_msgq_drop_oldest_idic(etos_msgq_head_t *msgq_head)
+{
+    u32 prio;
+
+    for (prio = 0; prio < ETOS_MSGQ_PRIO_BANDS; prio++) {
+        if (!list_is_empty(&msgq_head->msg_list[prio])) {
+            msgq_head->stat.band_depth[prio]--;
+            msgq_head->stat.depth--;
+            msgq_head->stat.drop_cnt++;
+            _etos_msgq_free_buf_idic(list_entry(list_dequeue(&msgq_head->msg_list[prio]), etos_msgq_buf_t, list));
+            return;
+        }
+    }
+}
+
+
+/*
+ * wait until the queue is not full, or drop the oldest message by policy,
+ * timeout_ticks is 0 in ISR and idic sender
+ */
+static s32 _etos_msgq_wait_room_idic(etos_msgq_head_t *msgq_head, u32 timeout_ticks)
+{
+    s32 ret;
+    s32 left_ticks;
+    etos_tick deadline = etos_sched_get_tick() + timeout_ticks;
+
+    while (_etos_msgq_is_full(msgq_head)) {
+        if (msgq_head->full_policy == ETOS_MSGQ_FULL_DROP_OLDEST) {
+            _etos_msgq_drop_oldest_idic(msgq_head);
+            continue;
+        }
+
+        if (timeout_ticks == 0) {
+            msgq_head->stat.reject_cnt++;
+            return ETOS_RET_FULL;
+        }
+
+        ret = etos_waitq_pend_idic(&msgq_head->send_waitq, ETOS_TASK_PENDING_MSG, timeout_ticks, 0, 0);
+        if (ret != ETOS_RET_OK) {
+            msgq_head->stat.reject_cnt++;
+            return ret;
+        }
+
+        /*another sender may take the room first, wait the rest ticks*/
+        if (timeout_ticks != ETOS_WAIT_FOREVER) {
+            left_ticks = (s32)(deadline - etos_sched_get_tick());
+            if (left_ticks <= 0) {
+                msgq_head->stat.reject_cnt++;
+                return ETOS_RET_TIMEOUT;
+            }
+            timeout_ticks = (u32)left_ticks;
+        }
+    }
+
+    return ETOS_RET_OK;
+}
+
+
+/*count a received message and measure its send to receive latency*/
+static void _etos_msgq_recv_stat_idic(etos_msgq_head_t *msgq_head, etos_msgq_buf_t *msgq_buf)
+{
+    etos_msgq_stat_t *stat = &msgq_head->stat;
+    u32 latency = etos_sched_get_timestamp() - msgq_buf->send_timestamp;
+
+    if (stat->recv_cnt == 0) {
+        stat->latency_min = latency;
+        stat->latency_max = latency;
+        stat->latency_avg = latency;
+    } else {
+        if (latency < stat->latency_min) {
+            stat->latency_min = latency;
+        }
+        if (latency > stat->latency_max) {
+            stat->latency_max = latency;
+        }
+        stat->latency_avg = stat->latency_avg - (stat->latency_avg >> MSGQ_LATENCY_AVG_SHIFT)
+                            + (latency >> MSGQ_LATENCY_AVG_SHIFT);
+    }
+
+    stat->recv_cnt++;
+}
+
+
+/*the receiver owns a malloc-ed buffer from now on, see etos_mem_take_idic()*/
+static inline void _etos_msgq_take_buf_idic(etos_msgq_buf_t *msgq_buf)
+{
+#if (ETOS_MEM_ACCOUNT_ENABLE)
+    if (msgq_buf->slab_head == NULL) {
+        etos_mem_take_idic(msgq_buf);
+    }
+#else
+    msgq_buf = msgq_buf;
+#endif
+}
+
+
+static void _etos_msgq_init_head(etos_msgq_head_t *msgq_head, etos_msg_type msg_type)
+{
+    u32 prio;
+
+    memset(msgq_head, 0, sizeof(etos_msgq_head_t));
+
+    msgq_head->msg_type = msg_type;
+    msgq_head->msg_check_flag = ETOS_MSG_CHECK_FLAG;
+    etos_waitq_init(&msgq_head->recv_waitq, NULL);
+    etos_waitq_init(&msgq_head->send_waitq, NULL);
+    INIT_LIST_HEAD(&msgq_head->free_list);
+
+    for (prio = 0; prio < ETOS_MSGQ_PRIO_BANDS; prio++) {
+        INIT_LIST_HEAD(&msgq_head->msg_list[prio]);
+    }
+}
+
+
+/*
+ * hand over the buffer to the highest waiting receiver directly, queue it if there is no receiver,
+ * so every message is delivered to exactly one receiver and a woken receiver always gets its message
+ */
+static void _etos_msgq_deliver_idic(etos_msgq_head_t *msgq_head, etos_msgq_buf_t *msgq_buf, u32 prio)
+{
+    etos_wait_node_t *pt_node = etos_waitq_peek_idic(&msgq_head->recv_waitq);
+
+    msgq_buf->send_timestamp = etos_sched_get_timestamp();
+    msgq_head->stat.sent_cnt++;
+
+    if (pt_node) {
+        etos_waitq_wake_node_idic(pt_node, ETOS_RET_OK, (u32)msgq_buf);
+    } else {
+        _etos_msgq_enqueue_idic(msgq_head, msgq_buf, prio);
+        etos_qset_notify_idic(msgq_head->qset);
+    }
+}
+
 /******************************************************************************
  *                                 Global Functions                           *
  ******************************************************************************/
@@ -66,6 +271,7 @@ Date           Author       Notes
 s32 etos_msgq_create(etos_msg_type msg_type, etos_msg_handle *msg_handle)
 {
     etos_msgq_head_t *msgq_head;
+    etos_init_critical();
 
     if (msg_handle == NULL) {
         return ETOS_INVALID_PARAM;
@@ -76,10 +282,72 @@ s32 etos_msgq_create(etos_msg_type msg_type, etos_msg_handle *msg_handle)
         return ETOS_NO_MEM;
     }
 
-    msgq_head->msg_type = msg_type;
-    msgq_head->msg_check_flag = ETOS_MSG_CHECK_FLAG;
-    msgq_head->recv_task = 0;
-    INIT_LIST_HEAD(&msgq_head->list);
+    _etos_msgq_init_head(msgq_head, msg_type);
+
+    etos_enter_critical();
+    list_add_tail(&msgq_head->list, &_os_msgq_list_head);
+    etos_exit_critical();
+
+    *msg_handle = (etos_msg_handle)msgq_head;
+
+    return ETOS_RET_OK;
+}
+
+
+
+/**
+ * create a static message queue.
+ * all buffers are preallocated in a slab with the queue, etos_msgq_get_buf() and
+ * etos_msgq_release_buf() just pop and push the free list
+ *
+ * @param[in]    msg_type
+ * @param[in]    msg_size    max length of a message
+ * @param[in]    msg_count   number of buffers
+ * @param[out]   msg_handle  output handle for other message queue API
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @note       head and slab are got by one malloc, so only the slab is rounded once
+ * @see        etos_msgq_destroy()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_msgq_create_static(etos_msg_type msg_type, u32 msg_size, u32 msg_count, etos_msg_handle *msg_handle)
+{
+    u32 i;
+    u8 *slab;
+    etos_msgq_buf_t *msgq_buf;
+    etos_msgq_head_t *msgq_head;
+    etos_init_critical();
+
+    if ((msg_handle == NULL) || (msg_size == 0) || (msg_count == 0)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    msgq_head = (etos_msgq_head_t *)malloc(sizeof(etos_msgq_head_t) + msg_count * MSGQ_SLAB_BUF_SIZE(msg_size));
+    if (msgq_head == NULL) {
+        return ETOS_NO_MEM;
+    }
+
+    _etos_msgq_init_head(msgq_head, msg_type);
+    msgq_head->msg_size = msg_size;
+    msgq_head->msg_count = msg_count;
+    msgq_head->free_cnt = msg_count;
+
+    /*preformat all buffers in slab*/
+    slab = (u8 *)(msgq_head + 1);
+    for (i = 0; i < msg_count; i++) {
+        msgq_buf = (etos_msgq_buf_t *)(slab + i * MSGQ_SLAB_BUF_SIZE(msg_size));
+        msgq_buf->slab_head = msgq_head;
+        msgq_buf->msg_check_flag = ETOS_MSG_CHECK_FLAG;
+        list_add_tail(&msgq_buf->list, &msgq_head->free_list);
+    }
+
+    etos_enter_critical();
+    list_add_tail(&msgq_head->list, &_os_msgq_list_head);
+    etos_exit_critical();
 
     *msg_handle = (etos_msg_handle)msgq_head;
 
@@ -96,7 +364,7 @@ s32 etos_msgq_create(etos_msg_type msg_type, etos_msg_handle *msg_handle)
  *
  * @return
  * @retval 0       success
- * @retval other   fail
+ * @retval other   fail, a task is waiting for message or it is in a queue set
  *
  * @note none
  * @see        etos_msgq_create()
@@ -105,9 +373,9 @@ s32 etos_msgq_create(etos_msg_type msg_type, etos_msg_handle *msg_handle)
  */
 s32 etos_msgq_destroy(etos_msg_handle msg_handle)
 {
+    u32 own_cnt, prio;
     list_t *entry;
     etos_msgq_buf_t *msgq_buf;
-    etos_task_state_e recv_task_state;
     etos_msgq_head_t *msgq_head = (etos_msgq_head_t *)msg_handle;
     etos_init_critical();
 
@@ -119,24 +387,36 @@ s32 etos_msgq_destroy(etos_msg_handle msg_handle)
     /*clear msgq*/
     etos_enter_critical();
 
-    if (etos_sched_get_task_state(msgq_head->recv_task, &recv_task_state)) {
-        xlogw(LOG_MODULE_ETOS, "get task state error\n");
-    } else {
-        if (recv_task_state & ETOS_TASK_PENDING_MSG) {
-            /*task is waiting for message*/
+    if (!etos_waitq_is_empty(&msgq_head->recv_waitq) || !etos_waitq_is_empty(&msgq_head->send_waitq)
+        || msgq_head->qset) {
+        /*task is waiting for message or room, or it is in a queue set*/
+        etos_exit_critical();
+        return ETOS_NOT_SUPPORT;
+    }
+
+    if (msgq_head->msg_size) {
+        /*buffers of the slab must be all free or queued*/
+        own_cnt = msgq_head->free_cnt;
+        for (prio = 0; prio < ETOS_MSGQ_PRIO_BANDS; prio++) {
+            list_for_each(entry, &msgq_head->msg_list[prio]) {
+                if (list_entry(entry, etos_msgq_buf_t, list)->slab_head == msgq_head) {
+                    own_cnt++;
+                }
+            }
+        }
+
+        if (own_cnt != msgq_head->msg_count) {
             etos_exit_critical();
             return ETOS_NOT_SUPPORT;
         }
     }
 
-    while (!list_is_empty(&msgq_head->list)) { //not empty, it has msg
-        entry = list_dequeue(&msgq_head->list);
-        msgq_buf = list_entry(entry, etos_msgq_buf_t, list);
-        if (msgq_buf) {
-            free(msgq_buf);  //free buf
-        }
+    while ((msgq_buf = _etos_msgq_dequeue_idic(msgq_head)) != NULL) { //not empty, it has msg
+        _etos_msgq_free_buf_idic(msgq_buf);  //free buf
     }
-    free(msgq_head);  // free head
+    list_del(&msgq_head->list);
+    msgq_head->msg_check_flag = 0;
+    free(msgq_head);  // free head and slab
 
     etos_exit_critical();
 
@@ -167,15 +447,32 @@ u8 *etos_msgq_get_buf(etos_msg_handle msg_handle, u32 len)
 {
     etos_msgq_buf_t *msgq_buf;
     etos_msgq_head_t *msgq_head = (etos_msgq_head_t *)msg_handle;
+    etos_init_critical();
 
     if ((msgq_head == NULL) || (len == 0)
         || (msgq_head->msg_check_flag != ETOS_MSG_CHECK_FLAG)) {
         return NULL;
     }
 
-    msgq_buf = (etos_msgq_buf_t *)malloc(len + sizeof(etos_msgq_buf_t));
-    if (msgq_buf == NULL) {
-        return NULL;
+    if (msgq_head->msg_size) {
+        if (len > msgq_head->msg_size) {
+            return NULL;
+        }
+
+        etos_enter_critical();
+        if (list_is_empty(&msgq_head->free_list)) {
+            etos_exit_critical();
+            return NULL;
+        }
+        msgq_buf = list_entry(list_dequeue(&msgq_head->free_list), etos_msgq_buf_t, list);
+        msgq_head->free_cnt--;
+        etos_exit_critical();
+    } else {
+        msgq_buf = (etos_msgq_buf_t *)malloc(len + sizeof(etos_msgq_buf_t));
+        if (msgq_buf == NULL) {
+            return NULL;
+        }
+        msgq_buf->slab_head = NULL;
     }
 
     msgq_buf->msg_check_flag = ETOS_MSG_CHECK_FLAG;
@@ -207,6 +504,7 @@ s32 etos_msgq_release_buf(etos_msg_handle msg_handle, u8 *msg_buf)
 {
     etos_msgq_buf_t *msgq_buf;
     etos_msgq_head_t *msgq_head = (etos_msgq_head_t *)msg_handle;
+    etos_init_critical();
 
     if ((msgq_head == NULL)
         || (msgq_head->msg_check_flag != ETOS_MSG_CHECK_FLAG)
@@ -224,7 +522,9 @@ s32 etos_msgq_release_buf(etos_msg_handle msg_handle, u8 *msg_buf)
 
 
     //INIT_LIST_HEAD(&msgq_buf->list);  //have done in recv list_dequeue
-    free(msgq_buf);
+    etos_enter_critical();
+    _etos_msgq_free_buf_idic(msgq_buf);
+    etos_exit_critical();
 
     return ETOS_RET_OK;
 }
@@ -249,13 +549,66 @@ s32 etos_msgq_release_buf(etos_msg_handle msg_handle, u8 *msg_buf)
  */
 s32 etos_msgq_send(etos_msg_handle msg_handle, u8 *msg_buf)
 {
+    return etos_msgq_send_prio(msg_handle, msg_buf, ETOS_MSGQ_PRIO_NORMAL);
+}
+
+
+
+/**
+ * send a message queue buffer with priority.
+ * send a message queue buffer to the task which is wait to receive massge queue
+ *
+ * @param[in]    msg_handle
+ * @param[in]    msg_buf      which is returned by etos_msgq_get_buf()
+ * @param[in]    prio         0 ~ (ETOS_MSGQ_PRIO_BANDS - 1), higher priority message is received first
+ *
+ * @return
+ * @retval 0               success
+ * @retval ETOS_RET_FULL   the queue is full and it is called in ISR
+ * @retval other           fail
+ *
+ * @note       messages in the same priority are FIFO, a task waits for room when the queue is full
+ * @see        etos_msgq_recv()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_msgq_send_prio(etos_msg_handle msg_handle, u8 *msg_buf, u32 prio)
+{
+    return etos_msgq_send_timeout(msg_handle, msg_buf, prio, ETOS_WAIT_FOREVER);
+}
+
+
+
+/**
+ * send a message queue buffer with priority and timeout.
+ * the caller waits for room when the queue is full
+ *
+ * @param[in]    msg_handle
+ * @param[in]    msg_buf          which is returned by etos_msgq_get_buf()
+ * @param[in]    prio             0 ~ (ETOS_MSGQ_PRIO_BANDS - 1), higher priority message is received first
+ * @param[in]    timeout_ticks    0: do not wait, ETOS_WAIT_FOREVER: wait until there is room
+ *
+ * @return
+ * @retval 0                  success
+ * @retval ETOS_RET_FULL      the queue is full and timeout_ticks is 0 or it is called in ISR
+ * @retval ETOS_RET_TIMEOUT   timeout
+ * @retval other              fail
+ *
+ * @note       the caller still owns the buffer when it fails
+ * @see        etos_msgq_set_capacity()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_msgq_send_timeout(etos_msg_handle msg_handle, u8 *msg_buf, u32 prio, u32 timeout_ticks)
+{
+    s32 ret;
     etos_msgq_buf_t *msgq_buf;
     etos_msgq_head_t *msgq_head = (etos_msgq_head_t *)msg_handle;
     etos_init_critical();
 
     if ((msgq_head == NULL)
         || (msgq_head->msg_check_flag != ETOS_MSG_CHECK_FLAG)
-        || (msg_buf == NULL)) {
+        || (msg_buf == NULL) || (prio >= ETOS_MSGQ_PRIO_BANDS)) {
         return ETOS_INVALID_PARAM;
     }
 
@@ -267,6 +620,7 @@ s32 etos_msgq_send(etos_msg_handle msg_handle, u8 *msg_buf)
 
     if (etos_intr_in_isr()) {
         msgq_buf->send_task = ETOS_INTR_VIRTUAL_TASK_HANDLE;
+        timeout_ticks = 0;  /*ISR can not wait*/
     } else {
         msgq_buf->send_task = etos_sched_get_current_task();
     }
@@ -275,8 +629,14 @@ s32 etos_msgq_send(etos_msg_handle msg_handle, u8 *msg_buf)
 
     etos_enter_critical();
 
-    list_add_tail(&msgq_buf->list, &msgq_head->list);
-    etos_sched_resume_task(msgq_head->recv_task, ETOS_TASK_PENDING_MSG);
+    ret = _etos_msgq_wait_room_idic(msgq_head, timeout_ticks);
+    if (ret != ETOS_RET_OK) {
+        etos_exit_critical();
+        return ret;
+    }
+
+    ETOS_TRACE_IDIC(ETOS_TRACE_EVT_MSGQ_SEND, 0, msg_handle);
+    _etos_msgq_deliver_idic(msgq_head, msgq_buf, prio);
 
     etos_exit_critical();
 
@@ -303,13 +663,39 @@ s32 etos_msgq_send(etos_msg_handle msg_handle, u8 *msg_buf)
  * @date       2015/4/14
  */
 s32 etos_msgq_send_idic(etos_msg_handle msg_handle, u8 *msg_buf)
+{
+    return etos_msgq_send_prio_idic(msg_handle, msg_buf, ETOS_MSGQ_PRIO_NORMAL);
+}
+
+
+
+/**
+ * send a message queue buffer with priority.
+ * send a message queue buffer to the task which is wait to receive massge queue
+ * it is called in a disable interrupt context
+ *
+ * @param[in]    msg_handle
+ * @param[in]    msg_buf      which is returned by etos_msgq_get_buf()
+ * @param[in]    prio         0 ~ (ETOS_MSGQ_PRIO_BANDS - 1), higher priority message is received first
+ *
+ * @return
+ * @retval 0               success
+ * @retval ETOS_RET_FULL   the queue is full
+ * @retval other           fail
+ *
+ * @note       messages in the same priority are FIFO
+ * @see        etos_msgq_recv()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_msgq_send_prio_idic(etos_msg_handle msg_handle, u8 *msg_buf, u32 prio)
 {
     etos_msgq_buf_t *msgq_buf;
     etos_msgq_head_t *msgq_head = (etos_msgq_head_t *)msg_handle;
 
     if ((msgq_head == NULL)
         || (msgq_head->msg_check_flag != ETOS_MSG_CHECK_FLAG)
-        || (msg_buf == NULL)) {
+        || (msg_buf == NULL) || (prio >= ETOS_MSGQ_PRIO_BANDS)) {
         return ETOS_INVALID_PARAM;
     }
 
@@ -327,8 +713,12 @@ s32 etos_msgq_send_idic(etos_msg_handle msg_handle, u8 *msg_buf)
 
     xlogi(LOG_MODULE_ETOS, "msg_send: handle=0x%x buf=0x%x\r\n", msg_handle, (u32)msg_buf);
 
-    list_add_tail(&msgq_buf->list, &msgq_head->list);
-    etos_sched_resume_task_idic(msgq_head->recv_task, ETOS_TASK_PENDING_MSG);
+    if (_etos_msgq_wait_room_idic(msgq_head, 0) != ETOS_RET_OK) {
+        return ETOS_RET_FULL;
+    }
+
+    ETOS_TRACE_IDIC(ETOS_TRACE_EVT_MSGQ_SEND, 0, msg_handle);
+    _etos_msgq_deliver_idic(msgq_head, msgq_buf, prio);
 
     return ETOS_RET_OK;
 }
@@ -357,7 +747,38 @@ s32 etos_msgq_send_idic(etos_msg_handle msg_handle, u8 *msg_buf)
  */
 s32 etos_msgq_recv(etos_msg_handle msg_handle, u8 **msg_buf_ptr, etos_task_handle *send_task)
 {
-    list_t *entry;
+    return etos_msgq_recv_timeout(msg_handle, msg_buf_ptr, send_task, ETOS_WAIT_FOREVER);
+}
+
+
+
+/**
+ * receive a message queue buffer with timeout.
+ * the caller pends until a message queue buffer is sent or timeout
+ * do not call this API in an interrupt context
+ *
+ * @param[in]    msg_handle
+ * @param[out]   msg_buf_ptr       output message queue buffer, NULL if it fails
+ * @param[out]   send_task         output send message queue buffer task
+ *                                 it equal ETOS_INTR_VIRTUAL_TASK_HANDLE when send message in ISR
+ * @param[in]    timeout_ticks     0: do not wait, ETOS_WAIT_FOREVER: wait until a message is sent
+ *
+ * @return
+ * @retval 0                  success
+ * @retval ETOS_RET_BUSY      there is no message and timeout_ticks is 0
+ * @retval ETOS_RET_TIMEOUT   timeout
+ * @retval other              fail
+ *
+ * @note       many tasks can receive from the same queue, each message is delivered to
+ *             the highest waiting receiver (FIFO in the same priority)
+ * @see        etos_msgq_send()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_msgq_recv_timeout(etos_msg_handle msg_handle, u8 **msg_buf_ptr, etos_task_handle *send_task,
+                           u32 timeout_ticks)
+{
+    s32 ret;
     etos_msgq_buf_t *msgq_buf;
     etos_msgq_head_t *msgq_head = (etos_msgq_head_t *)msg_handle;
     etos_init_critical();
@@ -368,32 +789,36 @@ s32 etos_msgq_recv(etos_msg_handle msg_handle, u8 **msg_buf_ptr, etos_task_handl
         return ETOS_INVALID_PARAM;
     }
 
-    if (etos_intr_in_isr()) {
-        xlogf(LOG_MODULE_ETOS, "can not recv message in ISR\r\n");
-    }
+    *msg_buf_ptr = NULL;
 
-    msgq_head->recv_task = etos_sched_get_current_task();
-
-    while (1) {
-        if (list_is_empty(&msgq_head->list)) {
-            /*pending itself becasue of message*/
-            etos_sched_pending_task(msgq_head->recv_task, ETOS_TASK_PENDING_MSG);
-        } else {
-            etos_enter_critical();
-            entry = list_dequeue(&msgq_head->list);
-            if (entry) {
-                msgq_buf = list_entry(entry, etos_msgq_buf_t, list);
-                etos_exit_critical();
-                break;
-            } else {
-                etos_exit_critical();
-                continue;
-            }
+    etos_enter_critical();
+
+    msgq_buf = _etos_msgq_dequeue_idic(msgq_head);
+    if (msgq_buf == NULL) {
+        if (timeout_ticks == 0) {
+            etos_exit_critical();
+            return ETOS_RET_BUSY;
         }
+
+        /*pending itself becasue of message, sender hands over the buffer by wake value*/
+        ret = etos_waitq_pend_idic(&msgq_head->recv_waitq, ETOS_TASK_PENDING_MSG, timeout_ticks, 0, 0);
+        if (ret != ETOS_RET_OK) {
+            etos_exit_critical();
+            return ret;
+        }
+
+        msgq_buf = (etos_msgq_buf_t *)etos_waitq_get_node(etos_sched_get_current_task())->wake_value;
     }
 
+    _etos_msgq_recv_stat_idic(msgq_head, msgq_buf);
+    _etos_msgq_take_buf_idic(msgq_buf);
+
+    etos_exit_critical();
+
     ASSERT(msgq_buf->msg_check_flag == ETOS_MSG_CHECK_FLAG);
 
+    ETOS_TRACE(ETOS_TRACE_EVT_MSGQ_RECV, 0, msg_handle);
+
     xlogi(LOG_MODULE_ETOS, "msg_recv: handle=0x%x buf=0x%x\r\n", msg_handle, (u32)(msgq_buf->msg_data));
 
     if (send_task) {
@@ -407,6 +832,131 @@ s32 etos_msgq_recv(etos_msg_handle msg_handle, u8 **msg_buf_ptr, etos_task_handl
 
 
 
+/**
+ * receive a batch of message queue buffers.
+ * the caller pends until there is a message, then all queued messages (at most max_num)
+ * are drained in one critical section
+ * do not call this API in an interrupt context
+ *
+ * @param[in]    msg_handle
+ * @param[out]   msg_bufs       output message queue buffers, higher priority first
+ * @param[in]    max_num        size of msg_bufs
+ * @param[out]   recv_num       number of received buffers
+ *
+ * @return
+ * @retval 0       success, recv_num is at least 1
+ * @retval other   fail
+ *
+ * @note       it will be blocking when there is no message buffer to be received
+ * @see        etos_msgq_release_buf_batch()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_msgq_recv_batch(etos_msg_handle msg_handle, u8 *msg_bufs[], u32 max_num, u32 *recv_num)
+{
+    s32 ret;
+    u32 num = 0;
+    etos_msgq_buf_t *msgq_buf;
+    etos_msgq_head_t *msgq_head = (etos_msgq_head_t *)msg_handle;
+    etos_init_critical();
+
+    if ((msgq_head == NULL)
+        || (msgq_head->msg_check_flag != ETOS_MSG_CHECK_FLAG)
+        || (msg_bufs == NULL) || (max_num == 0) || (recv_num == NULL)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    *recv_num = 0;
+
+    etos_enter_critical();
+
+    msgq_buf = _etos_msgq_dequeue_idic(msgq_head);
+    if (msgq_buf == NULL) {
+        /*pending itself becasue of message, sender hands over the buffer by wake value*/
+        ret = etos_waitq_pend_idic(&msgq_head->recv_waitq, ETOS_TASK_PENDING_MSG, ETOS_WAIT_FOREVER, 0, 0);
+        if (ret != ETOS_RET_OK) {
+            etos_exit_critical();
+            return ret;
+        }
+
+        msgq_buf = (etos_msgq_buf_t *)etos_waitq_get_node(etos_sched_get_current_task())->wake_value;
+    }
+
+    /*one wakeup, drain the messages queued during pending too*/
+    do {
+        ASSERT(msgq_buf->msg_check_flag == ETOS_MSG_CHECK_FLAG);
+        _etos_msgq_recv_stat_idic(msgq_head, msgq_buf);
+        _etos_msgq_take_buf_idic(msgq_buf);
+        msg_bufs[num++] = msgq_buf->msg_data;
+    } while ((num < max_num) && ((msgq_buf = _etos_msgq_dequeue_idic(msgq_head)) != NULL));
+
+    etos_exit_critical();
+
+    ETOS_TRACE(ETOS_TRACE_EVT_MSGQ_RECV, num, msg_handle);
+
+    xlogi(LOG_MODULE_ETOS, "msg_recv_batch: handle=0x%x num=%d\r\n", msg_handle, num);
+
+    *recv_num = num;
+
+    return ETOS_RET_OK;
+}
+
+
+
+/**
+ * release a batch of buffers.
+ * release message queue buffers got from etos_msgq_recv_batch() in one critical section
+ *
+ * @param[in]    msg_handle
+ * @param[in]    msg_bufs
+ * @param[in]    num
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail, the buffers before the invalid one are released
+ *
+ * @see        etos_msgq_recv_batch()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_msgq_release_buf_batch(etos_msg_handle msg_handle, u8 *msg_bufs[], u32 num)
+{
+    u32 i;
+    s32 ret = ETOS_RET_OK;
+    etos_msgq_buf_t *msgq_buf;
+    etos_msgq_head_t *msgq_head = (etos_msgq_head_t *)msg_handle;
+    etos_init_critical();
+
+    if ((msgq_head == NULL)
+        || (msgq_head->msg_check_flag != ETOS_MSG_CHECK_FLAG)
+        || (msg_bufs == NULL)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    etos_enter_critical();
+
+    for (i = 0; i < num; i++) {
+        if (msg_bufs[i] == NULL) {
+            ret = ETOS_INVALID_PARAM;
+            break;
+        }
+
+        msgq_buf = list_entry(msg_bufs[i], etos_msgq_buf_t, msg_data);
+        if (msgq_buf->msg_check_flag != ETOS_MSG_CHECK_FLAG) {
+            ret = ETOS_INVALID_PARAM;
+            break;
+        }
+
+        _etos_msgq_free_buf_idic(msgq_buf);
+    }
+
+    etos_exit_critical();
+
+    return ret;
+}
+
+
+
 /**
  * receive a message queue buffer.
  * receive a message queue buffer, it won't be blocking when
@@ -429,7 +979,6 @@ s32 etos_msgq_recv(etos_msg_handle msg_handle, u8 **msg_buf_ptr, etos_task_handl
  */
 s32 etos_msgq_recv_no_block(etos_msg_handle msg_handle, u8 **msg_buf_ptr, etos_task_handle *send_task)
 {
-    list_t *entry;
     etos_msgq_buf_t *msgq_buf;
     etos_msgq_head_t *msgq_head = (etos_msgq_head_t *)msg_handle;
     etos_init_critical();
@@ -444,23 +993,26 @@ s32 etos_msgq_recv_no_block(etos_msg_handle msg_handle, u8 **msg_buf_ptr, etos_t
         xlogf(LOG_MODULE_ETOS, "can not recv message in ISR\r\n");
     }
 
-    msgq_head->recv_task = etos_sched_get_current_task();
+    etos_enter_critical();
+    msgq_buf = _etos_msgq_dequeue_idic(msgq_head);
+    if (msgq_buf) {
+        _etos_msgq_recv_stat_idic(msgq_head, msgq_buf);
+        _etos_msgq_take_buf_idic(msgq_buf);
+    }
+    etos_exit_critical();
 
-    if (list_is_empty(&msgq_head->list)) {
+    if (msgq_buf == NULL) {
         *msg_buf_ptr = NULL;
         if (send_task) {
             send_task = 0;
         }
         return ETOS_RET_OK;
-    } else {
-        etos_enter_critical();
-        entry = list_dequeue(&msgq_head->list);
-        msgq_buf = list_entry(entry, etos_msgq_buf_t, list);
-        etos_exit_critical();
     }
 
     ASSERT(msgq_buf->msg_check_flag == ETOS_MSG_CHECK_FLAG);
 
+    ETOS_TRACE(ETOS_TRACE_EVT_MSGQ_RECV, 0, msg_handle);
+
     xlogi(LOG_MODULE_ETOS, "msg_recv: handle=0x%x buf=0x%x\r\n", msg_handle, (u32)(msgq_buf->msg_data));
 
     if (send_task) {
@@ -474,5 +1026,152 @@ s32 etos_msgq_recv_no_block(etos_msg_handle msg_handle, u8 **msg_buf_ptr, etos_t
 
 
 
+/**
+ * get message queue statistics.
+ *
+ * @param[in]    msg_handle
+ * @param[out]   stat
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_msgq_get_stat(etos_msg_handle msg_handle, etos_msgq_stat_t *stat)
+{
+    etos_msgq_head_t *msgq_head = (etos_msgq_head_t *)msg_handle;
+    etos_init_critical();
+
+    if ((msgq_head == NULL)
+        || (msgq_head->msg_check_flag != ETOS_MSG_CHECK_FLAG)
+        || (stat == NULL)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    etos_enter_critical();
+    *stat = msgq_head->stat;
+    etos_exit_critical();
+
+    return ETOS_RET_OK;
+}
+
+
+
+/**
+ * set the capacity of a message queue.
+ *
+ * @param[in]    msg_handle
+ * @param[in]    capacity       0: unbounded, or max queued messages
+ * @param[in]    full_policy    etos_msgq_full_policy_e
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @note       messages handed over to a waiting receiver are not queued, they are not counted
+ * @see        etos_msgq_send_timeout()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_msgq_set_capacity(etos_msg_handle msg_handle, u32 capacity, u32 full_policy)
+{
+    etos_msgq_head_t *msgq_head = (etos_msgq_head_t *)msg_handle;
+    etos_init_critical();
+
+    if ((msgq_head == NULL)
+        || (msgq_head->msg_check_flag != ETOS_MSG_CHECK_FLAG)
+        || (full_policy > ETOS_MSGQ_FULL_DROP_OLDEST)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    etos_enter_critical();
+
+    msgq_head->capacity = capacity;
+    msgq_head->full_policy = full_policy;
+
+    /*waiting senders recheck the new capacity*/
+    etos_waitq_wake_all_idic(&msgq_head->send_waitq, ETOS_RET_OK, 0);
+
+    etos_exit_critical();
+
+    return ETOS_RET_OK;
+}
+
+
+
+/**
+ * enumerate all message queues.
+ *
+ * @param[in]    msg_handle    0: get the first queue, or the queue got last time
+ *
+ * @return   the next message queue
+ * @retval 0       there is no more queue
+ * @retval other   handle of the next queue
+ *
+ * @note       do not destroy the queue during enumeration
+ * @see        etos_msgq_get_stat()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+etos_msg_handle etos_msgq_get_next(etos_msg_handle msg_handle)
+{
+    list_t *pt_entry;
+    etos_msgq_head_t *msgq_head = (etos_msgq_head_t *)msg_handle;
+    etos_init_critical();
+
+    if (msgq_head && (msgq_head->msg_check_flag != ETOS_MSG_CHECK_FLAG)) {
+        return 0;
+    }
+
+    etos_enter_critical();
+    pt_entry = msgq_head ? msgq_head->list.next : _os_msgq_list_head.next;
+    etos_exit_critical();
+
+    if (pt_entry == &_os_msgq_list_head) {
+        return 0;
+    }
+
+    return (etos_msg_handle)list_entry(pt_entry, etos_msgq_head_t, list);
+}
+
+
+
+/**
+ * report message queue statistics.
+ * print depth, throughput and latency of all message queues
+ *
+ * @param[in]    prompt   print header
+ *
+ * @return 0
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_msgq_report(const char *prompt)
+{
+    etos_msg_handle msg_handle = 0;
+    etos_msgq_stat_t stat;
+    const char *header;
+
+    if (prompt) {
+        header = prompt;
+    } else {
+        header = "etos msgq";
+    }
+
+    while ((msg_handle = etos_msgq_get_next(msg_handle)) != 0) {
+        etos_msgq_get_stat(msg_handle, &stat);
+        xlogt(LOG_MODULE_ETOS, "%s: 0x%08x type:%d depth:%d max depth:%d sent:%d recv:%d reject:%d drop:%d latency(us) min:%d avg:%d max:%d\r\n",
+              header, msg_handle, ((etos_msgq_head_t *)msg_handle)->msg_type, stat.depth, stat.max_depth,
+              stat.sent_cnt, stat.recv_cnt, stat.reject_cnt, stat.drop_cnt, etos_sched_timestamp_to_us(stat.latency_min),
+              etos_sched_timestamp_to_us(stat.latency_avg), etos_sched_timestamp_to_us(stat.latency_max));
+    }
+
+    return ETOS_RET_OK;
+}
+
+
 /* EOF */
 
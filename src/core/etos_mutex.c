@@ -0,0 +1,564 @@
+/******************************************************************************
+File    :  etos_mutex.c
+
+This file is part of the ETOS distribution
+Copyright (c) 2026, ETOS Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+(version 2) as published by the Free Software Foundation. See
+the LICENSE file in the top-level directory for more details.
+
+Description:
+		mutex with priority inheritance
+
+History:
+
+Date           Author       Notes
+----------     -------      -------------------------
+2026-10-19     deeve        Create
+2026-10-19     deeve        Use generic wait queue
+2026-10-19     deeve        Report hold time without overflow
+
+*******************************************************************************/
+
+/******************************************************************************
+ *                                 Includes                                   *
+ ******************************************************************************/
+#include "etos_includes.h"
+
+/******************************************************************************
+ *                                 Defines                                    *
+ ******************************************************************************/
+
+#define DEFAULT_MUTEX_NAME     "mutex"
+
+/******************************************************************************
+ *                                 Global Variables                           *
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                 Local Variables                            *
+ ******************************************************************************/
+
+#if (ETOS_MUTEX_ENABLE)
+static struct list_head _os_mutex_list_head = {&_os_mutex_list_head, &_os_mutex_list_head};
+#endif
+
+/******************************************************************************
+ *                                 Local Functions                            *
+ ******************************************************************************/
+
+#if (ETOS_MUTEX_ENABLE)
+
+static BOOL _etos_mutex_is_valid(etos_mutex_t *mutex)
+{
+    return (mutex && (mutex->mutex_check_flag == ETOS_MUTEX_CHECK_FLAG)) ? TRUE : FALSE;
+}
+
+
+static void _etos_mutex_take_idic(etos_mutex_t *mutex, etos_tcb_t *pt_os_task_tcb)
+{
+    mutex->owner = pt_os_task_tcb;
+    mutex->lock_cnt = 1;
+    mutex->lock_timestamp = etos_sched_get_timestamp();
+    mutex->stat.acquire_cnt++;
+    list_add_tail(&mutex->held_list, &pt_os_task_tcb->mutex_held_list);
+}
+
+
+/*
+ * the owner borrows the priority of the highest waiter,
+ * pass it along the chain if the owner is waiting for another mutex
+ */
+static void _etos_mutex_inherit_idic(etos_mutex_t *mutex)
+{
+    u32 depth;
+    etos_tcb_t *pt_owner;
+    etos_wait_node_t *pt_node;
+
+    for (depth = 0; (depth < ETOS_MUTEX_MAX_NESTING) && mutex; depth++) {
+        pt_owner = mutex->owner;
+        pt_node = etos_waitq_peek_idic(&mutex->waitq);
+        if ((pt_owner == NULL) || (pt_node == NULL)) {
+            return;
+        }
+
+        if (pt_node->priority <= pt_owner->priority) {
+            return;
+        }
+
+        if (!pt_owner->mutex_boosted) {
+            pt_owner->mutex_orig_priority = pt_owner->priority;
+            pt_owner->mutex_boosted = TRUE;
+        }
+
+        if (pt_node->pt_os_task_tcb->priority == pt_node->priority) {
+            /*the waiter may be still running before it pends, swap with it directly*/
+            etos_sched_swap_priority_idic(pt_owner->task_handle, pt_node->pt_os_task_tcb->task_handle);
+        } else {
+            etos_sched_set_priority_idic(pt_owner->task_handle, pt_node->priority);
+        }
+
+        if ((pt_owner->wait_node.waitq == NULL)
+            || (pt_owner->wait_node.reason != ETOS_TASK_PENDING_MUTEX)) {
+            return;
+        }
+
+        /*the owner is pending on another mutex, requeue it with new priority*/
+        etos_waitq_requeue_idic(&pt_owner->wait_node, pt_owner->priority);
+
+        mutex = list_entry(pt_owner->wait_node.waitq, etos_mutex_t, waitq);
+    }
+}
+
+
+/*
+ * the owner runs at the highest waiter of the mutexes it still holds,
+ * it gets the priority before inheritance back if there is no waiter
+ */
+static void _etos_mutex_disinherit_idic(etos_tcb_t *pt_owner)
+{
+    u32 priority;
+    list_t *pt_entry;
+    etos_mutex_t *mutex;
+    etos_wait_node_t *pt_node;
+
+    if (!pt_owner->mutex_boosted) {
+        return;
+    }
+
+    priority = pt_owner->mutex_orig_priority;
+
+    list_for_each(pt_entry, &pt_owner->mutex_held_list) {
+        mutex = list_entry(pt_entry, etos_mutex_t, held_list);
+        pt_node = etos_waitq_peek_idic(&mutex->waitq);
+        if (pt_node && (pt_node->priority > priority)) {
+            priority = pt_node->priority;
+        }
+    }
+
+    if (priority >= pt_owner->priority) {
+        return;
+    }
+
+    if (etos_sched_set_priority_idic(pt_owner->task_handle, priority) != ETOS_RET_OK) {
+        return;
+    }
+
+    if (priority == pt_owner->mutex_orig_priority) {
+        pt_owner->mutex_boosted = FALSE;
+    }
+}
+
+
+/*put the waiter back to its waiting priority and resume it*/
+static void _etos_mutex_wakeup_idic(etos_wait_node_t *pt_node, s32 result)
+{
+    etos_sched_set_priority_idic(pt_node->pt_os_task_tcb->task_handle, pt_node->priority);
+    etos_waitq_wake_node_idic(pt_node, result, 0);
+}
+
+
+/*called in tick ISR, the waiter has been removed from the wait queue and it is resumed after it*/
+static void _etos_mutex_timeout_hook(etos_waitq_t *waitq, etos_tcb_t *pt_os_task_tcb)
+{
+    etos_mutex_t *mutex = list_entry(waitq, etos_mutex_t, waitq);
+
+    mutex->stat.timeout_cnt++;
+
+    if (mutex->owner) {
+        _etos_mutex_disinherit_idic(mutex->owner);
+    }
+
+    etos_sched_set_priority_idic(pt_os_task_tcb->task_handle, pt_os_task_tcb->wait_node.priority);
+}
+
+#endif
+
+/******************************************************************************
+ *                                 Global Functions                           *
+ ******************************************************************************/
+
+/**
+ * create a mutex.
+ *
+ * @param[in]    name          mutex name, max length is ETOS_MAX_TASK_NAME_LEN
+ * @param[in]    recursive     TRUE: the owner can lock it again
+ * @param[out]   mutex_handle  output handle for other mutex API
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @see        etos_mutex_destroy()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_mutex_create(const char *name, BOOL recursive, etos_mutex_handle *mutex_handle)
+{
+#if (ETOS_MUTEX_ENABLE)
+    etos_mutex_t *mutex;
+    etos_init_critical();
+
+    if (mutex_handle == NULL) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    mutex = (etos_mutex_t *)malloc(sizeof(etos_mutex_t));
+    if (mutex == NULL) {
+        return ETOS_NO_MEM;
+    }
+
+    memset(mutex, 0, sizeof(etos_mutex_t));
+    INIT_LIST_HEAD(&mutex->held_list);
+    etos_waitq_init(&mutex->waitq, _etos_mutex_timeout_hook);
+    mutex->recursive = recursive;
+
+    if (name) {
+        strncpy(mutex->name, name, ETOS_MAX_TASK_NAME_LEN);
+    } else {
+        strncpy(mutex->name, DEFAULT_MUTEX_NAME, ETOS_MAX_TASK_NAME_LEN);
+    }
+
+    mutex->mutex_check_flag = ETOS_MUTEX_CHECK_FLAG;
+
+    etos_enter_critical();
+    list_add_tail(&mutex->list, &_os_mutex_list_head);
+    etos_exit_critical();
+
+    *mutex_handle = (etos_mutex_handle)mutex;
+
+    return ETOS_RET_OK;
+#else
+    name = name;
+    recursive = recursive;
+    mutex_handle = mutex_handle;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+
+/**
+ * destroy a mutex.
+ *
+ * @param[in]    mutex_handle
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail, the mutex is owned by a task
+ *
+ * @see        etos_mutex_create()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_mutex_destroy(etos_mutex_handle mutex_handle)
+{
+#if (ETOS_MUTEX_ENABLE)
+    etos_mutex_t *mutex = (etos_mutex_t *)mutex_handle;
+    etos_init_critical();
+
+    if (!_etos_mutex_is_valid(mutex)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    etos_enter_critical();
+
+    if (mutex->owner || !etos_waitq_is_empty(&mutex->waitq)) {
+        etos_exit_critical();
+        return ETOS_NOT_SUPPORT;
+    }
+
+    list_del(&mutex->list);
+    mutex->mutex_check_flag = 0;
+
+    etos_exit_critical();
+
+    free(mutex);
+
+    return ETOS_RET_OK;
+#else
+    mutex_handle = mutex_handle;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+
+/**
+ * lock a mutex.
+ * the caller pends until the mutex is unlocked or timeout, the owner runs at
+ * the priority of the highest waiter until it unlocks all mutexes
+ *
+ * 优先级继承通过交换priority slot实现: 等待者pending期间占用owner原来的slot，
+ * owner占用等待者的slot，等待者被唤醒时回到自己等待时的priority
+ *
+ * @param[in]    mutex_handle
+ * @param[in]    timeout_ticks    0: do not wait, ETOS_WAIT_FOREVER: wait until it is unlocked
+ *
+ * @return
+ * @retval 0                  success
+ * @retval ETOS_RET_BUSY      the mutex is owned by another task and timeout_ticks is 0
+ * @retval ETOS_RET_TIMEOUT   timeout
+ * @retval other              fail
+ *
+ * @note       do not call this API in an interrupt context
+ * @see        etos_mutex_unlock()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_mutex_lock(etos_mutex_handle mutex_handle, u32 timeout_ticks)
+{
+#if (ETOS_MUTEX_ENABLE)
+    s32 ret;
+    etos_task_handle task_handle;
+    etos_tcb_t *pt_os_task_tcb_cur;
+    etos_wait_node_t *pt_node;
+    etos_mutex_t *mutex = (etos_mutex_t *)mutex_handle;
+    etos_init_critical();
+
+    if (!_etos_mutex_is_valid(mutex)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    if (etos_intr_in_isr()) {
+        xlogf(LOG_MODULE_ETOS, "can not lock mutex in ISR\r\n");
+    }
+
+    task_handle = etos_sched_get_current_task();
+    if (!ETOS_TASK_HANDLE_IS_VALID(task_handle)) {
+        return ETOS_NOT_SUPPORT;
+    }
+
+    pt_os_task_tcb_cur = (etos_tcb_t *)task_handle;
+
+    etos_enter_critical();
+
+    if (mutex->owner == NULL) {
+        _etos_mutex_take_idic(mutex, pt_os_task_tcb_cur);
+        etos_exit_critical();
+        return ETOS_RET_OK;
+    }
+
+    if (mutex->owner == pt_os_task_tcb_cur) {
+        if (mutex->recursive) {
+            mutex->lock_cnt++;
+            ret = ETOS_RET_OK;
+        } else {
+            /*dead lock*/
+            ret = ETOS_RET_FAIL;
+        }
+        etos_exit_critical();
+        return ret;
+    }
+
+    mutex->stat.contended_cnt++;
+
+    if (timeout_ticks == 0) {
+        etos_exit_critical();
+        return ETOS_RET_BUSY;
+    }
+
+    /*queue itself first, the owner inherits its priority before it pends*/
+    pt_node = etos_waitq_prepare_idic(&mutex->waitq, ETOS_TASK_PENDING_MUTEX, timeout_ticks, 0, 0);
+
+    _etos_mutex_inherit_idic(mutex);
+
+    /*pending itself, it is resumed by unlock or timeout*/
+    ret = etos_waitq_wait_idic(pt_node);
+
+    etos_exit_critical();
+
+    return ret;
+#else
+    mutex_handle = mutex_handle;
+    timeout_ticks = timeout_ticks;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+
+/**
+ * try to lock a mutex.
+ *
+ * @param[in]    mutex_handle
+ *
+ * @return
+ * @retval 0                  success
+ * @retval ETOS_RET_BUSY      the mutex is owned by another task
+ * @retval other              fail
+ *
+ * @see        etos_mutex_lock()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_mutex_trylock(etos_mutex_handle mutex_handle)
+{
+    return etos_mutex_lock(mutex_handle, 0);
+}
+
+
+
+/**
+ * unlock a mutex.
+ * the mutex is handed over to the highest waiter, which runs at next schedulable time
+ *
+ * @param[in]    mutex_handle
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail, the caller is not the owner
+ *
+ * @note       the owner must unlock all mutexes before its task ends
+ * @see        etos_mutex_lock()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_mutex_unlock(etos_mutex_handle mutex_handle)
+{
+#if (ETOS_MUTEX_ENABLE)
+    u32 hold_time;
+    etos_tcb_t *pt_os_task_tcb_cur;
+    etos_wait_node_t *pt_node;
+    etos_mutex_t *mutex = (etos_mutex_t *)mutex_handle;
+    etos_init_critical();
+
+    if (!_etos_mutex_is_valid(mutex)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    pt_os_task_tcb_cur = (etos_tcb_t *)etos_sched_get_current_task();
+
+    etos_enter_critical();
+
+    if ((pt_os_task_tcb_cur == NULL) || (mutex->owner != pt_os_task_tcb_cur)) {
+        etos_exit_critical();
+        return ETOS_RET_FAIL;
+    }
+
+    if (--mutex->lock_cnt > 0) {
+        etos_exit_critical();
+        return ETOS_RET_OK;
+    }
+
+    hold_time = etos_sched_get_timestamp() - mutex->lock_timestamp;
+    if (hold_time > mutex->stat.max_hold_time) {
+        mutex->stat.max_hold_time = hold_time;
+    }
+
+    list_del_init(&mutex->held_list);
+    mutex->owner = NULL;
+
+    pt_node = etos_waitq_peek_idic(&mutex->waitq);
+    if (pt_node) {
+        /*hand over to the highest waiter*/
+        _etos_mutex_take_idic(mutex, pt_node->pt_os_task_tcb);
+    }
+
+    /*give back the borrowed priority before the waiter takes its priority back*/
+    _etos_mutex_disinherit_idic(pt_os_task_tcb_cur);
+
+    if (pt_node) {
+        _etos_mutex_wakeup_idic(pt_node, ETOS_RET_OK);
+
+        /*the new owner inherits from the rest waiters*/
+        _etos_mutex_inherit_idic(mutex);
+    }
+
+    etos_exit_critical();
+
+    return ETOS_RET_OK;
+#else
+    mutex_handle = mutex_handle;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+
+/**
+ * get mutex contention statistics.
+ *
+ * @param[in]    mutex_handle
+ * @param[out]   stat
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_mutex_get_stat(etos_mutex_handle mutex_handle, etos_mutex_stat_t *stat)
+{
+#if (ETOS_MUTEX_ENABLE)
+    etos_mutex_t *mutex = (etos_mutex_t *)mutex_handle;
+    etos_init_critical();
+
+    if (!_etos_mutex_is_valid(mutex) || (stat == NULL)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    etos_enter_critical();
+    *stat = mutex->stat;
+    etos_exit_critical();
+
+    return ETOS_RET_OK;
+#else
+    mutex_handle = mutex_handle;
+    stat = stat;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+
+/**
+ * report mutex statistics.
+ * print owner and contention statistics of all mutexes
+ *
+ * @param[in]    prompt   print header
+ *
+ * @return 0
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_mutex_report(const char *prompt)
+{
+#if (ETOS_MUTEX_ENABLE)
+    list_t *pt_entry;
+    etos_mutex_t *mutex;
+    const char *header;
+    u32 hold_ms;
+    u32 freq = etos_sched_get_timestamp_freq();
+
+    if (prompt) {
+        header = prompt;
+    } else {
+        header = "etos mutex";
+    }
+
+    list_for_each(pt_entry, &_os_mutex_list_head) {
+        mutex = list_entry(pt_entry, etos_mutex_t, list);
+        /*
+         * hold time is a 32 bits timestamp difference, it wraps after 2^32 / freq seconds
+         * (about 47 hours with 25.2KHz timer4), ms does not overflow if freq is below 4MHz
+         */
+        hold_ms = (mutex->stat.max_hold_time / freq) * 1000 + ((mutex->stat.max_hold_time % freq) * 1000) / freq;
+        xlogt(LOG_MODULE_ETOS, "%s: %-8s owner:%-8s acquire:%d contended:%d timeout:%d max hold:%d(%dms)\r\n",
+              header, mutex->name, mutex->owner ? mutex->owner->task_name : "-",
+              mutex->stat.acquire_cnt, mutex->stat.contended_cnt, mutex->stat.timeout_cnt,
+              mutex->stat.max_hold_time, hold_ms);
+    }
+#else
+    prompt = prompt;
+#endif
+
+    return ETOS_RET_OK;
+}
+
+
+/* EOF */
@@ -0,0 +1,310 @@
+/******************************************************************************
+File    :  etos_notify.c
+
+This file is part of the ETOS distribution
+Copyright (c) 2026, ETOS Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+(version 2) as published by the Free Software Foundation. See
+the LICENSE file in the top-level directory for more details.
+
+Description:
+		direct to task notification
+
+History:
+
+Date           Author       Notes
+----------     -------      -------------------------
+2026-10-19     deeve        Create
+2026-10-19     deeve        Add etos_task_notify_take() for counting semaphore
+2026-10-19     deeve        Keep waiting in take when it is notified with zero value
+
+*******************************************************************************/
+
+/******************************************************************************
+ *                                 Includes                                   *
+ ******************************************************************************/
+#include "etos_includes.h"
+
+/******************************************************************************
+ *                                 Defines                                    *
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                 Global Variables                           *
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                 Local Variables                            *
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                 Local Functions                            *
+ ******************************************************************************/
+
+#if (ETOS_NOTIFY_ENABLE)
+
+/*wait until the task is notified, it is called with interrupt disabled*/
+static s32 _etos_task_notify_pend_idic(etos_tcb_t *pt_os_task_tcb, u32 timeout_ticks)
+{
+    if (pt_os_task_tcb->notify_pending) {
+        return ETOS_RET_OK;
+    }
+
+    if (timeout_ticks == 0) {
+        return ETOS_RET_BUSY;
+    }
+
+    /*sleep without wait queue, the notifier wakes the wait node of the task directly*/
+    return etos_waitq_pend_idic(NULL, ETOS_TASK_PENDING_NOTIFY, timeout_ticks, 0, 0);
+}
+
+#endif
+
+/******************************************************************************
+ *                                 Global Functions                           *
+ ******************************************************************************/
+
+/**
+ * notify a task.
+ * update the notification value of the task and wake it up if it is waiting
+ *
+ * @param[in]    task_handle
+ * @param[in]    value
+ * @param[in]    action     etos_notify_action_e
+ *
+ * @return
+ * @retval 0               success
+ * @retval ETOS_RET_BUSY   ETOS_NOTIFY_NO_OVERWRITE and the last value is not taken
+ * @retval other           fail
+ *
+ * @note       it can be called in ISR
+ * @see        etos_task_notify_wait()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_task_notify(etos_task_handle task_handle, u32 value, u32 action)
+{
+#if (ETOS_NOTIFY_ENABLE)
+    s32 ret;
+    etos_init_critical();
+
+    etos_enter_critical();
+    ret = etos_task_notify_idic(task_handle, value, action);
+    etos_exit_critical();
+
+    return ret;
+#else
+    task_handle = task_handle;
+    value = value;
+    action = action;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+
+/**
+ * notify a task in disable interrupt context.
+ *
+ * @param[in]    task_handle
+ * @param[in]    value
+ * @param[in]    action     etos_notify_action_e
+ *
+ * @return
+ * @retval 0               success
+ * @retval ETOS_RET_BUSY   ETOS_NOTIFY_NO_OVERWRITE and the last value is not taken
+ * @retval other           fail
+ *
+ * @see        etos_task_notify()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_task_notify_idic(etos_task_handle task_handle, u32 value, u32 action)
+{
+#if (ETOS_NOTIFY_ENABLE)
+    etos_tcb_t *pt_os_task_tcb = (etos_tcb_t *)task_handle;
+
+    if (!ETOS_TASK_HANDLE_IS_VALID(task_handle)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    switch (action) {
+    case ETOS_NOTIFY_SET_BITS:
+        pt_os_task_tcb->notify_value |= value;
+        break;
+    case ETOS_NOTIFY_INCREMENT:
+        pt_os_task_tcb->notify_value++;
+        break;
+    case ETOS_NOTIFY_OVERWRITE:
+        pt_os_task_tcb->notify_value = value;
+        break;
+    case ETOS_NOTIFY_NO_OVERWRITE:
+        if (pt_os_task_tcb->notify_pending) {
+            return ETOS_RET_BUSY;
+        }
+        pt_os_task_tcb->notify_value = value;
+        break;
+    default:
+        return ETOS_INVALID_PARAM;
+    }
+
+    pt_os_task_tcb->notify_pending = TRUE;
+
+    /*the pending bit is cleared when it is resumed, so a timed out waiter is not woken twice*/
+    if (pt_os_task_tcb->task_state & ETOS_TASK_PENDING_NOTIFY) {
+        etos_waitq_wake_node_idic(&pt_os_task_tcb->wait_node, ETOS_RET_OK, 0);
+    }
+
+    return ETOS_RET_OK;
+#else
+    task_handle = task_handle;
+    value = value;
+    action = action;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+
+/**
+ * wait notification of current task.
+ * the value is output and the clear_bits of it are cleared when it returns
+ *
+ * @param[in]    clear_bits       bits cleared on exit, ETOS_NOTIFY_CLEAR_ALL: clear the whole value
+ * @param[out]   value            notification value before clear, can be NULL
+ * @param[in]    timeout_ticks    0: do not wait, ETOS_WAIT_FOREVER: wait until notified
+ *
+ * @return
+ * @retval 0                  success
+ * @retval ETOS_RET_BUSY      there is no notification and timeout_ticks is 0
+ * @retval ETOS_RET_TIMEOUT   timeout
+ * @retval other              fail
+ *
+ * @note       do not call this API in an interrupt context
+ * @see        etos_task_notify()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_task_notify_wait(u32 clear_bits, u32 *value, u32 timeout_ticks)
+{
+#if (ETOS_NOTIFY_ENABLE)
+    s32 ret;
+    etos_tcb_t *pt_os_task_tcb;
+    etos_task_handle task_handle = etos_sched_get_current_task();
+    etos_init_critical();
+
+    if (!ETOS_TASK_HANDLE_IS_VALID(task_handle)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    pt_os_task_tcb = (etos_tcb_t *)task_handle;
+
+    etos_enter_critical();
+
+    ret = _etos_task_notify_pend_idic(pt_os_task_tcb, timeout_ticks);
+    if (ret != ETOS_RET_OK) {
+        etos_exit_critical();
+        return ret;
+    }
+
+    if (value) {
+        *value = pt_os_task_tcb->notify_value;
+    }
+
+    pt_os_task_tcb->notify_value &= ~clear_bits;
+    pt_os_task_tcb->notify_pending = FALSE;
+
+    etos_exit_critical();
+
+    return ETOS_RET_OK;
+#else
+    clear_bits = clear_bits;
+    value = value;
+    timeout_ticks = timeout_ticks;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+
+/**
+ * take one count of notification of current task.
+ * the notification value is used as a counting semaphore given by ETOS_NOTIFY_INCREMENT,
+ * the value is decreased by one, and it keeps pending while the value is not zero
+ *
+ * @param[out]   count            notification value before take, can be NULL
+ * @param[in]    timeout_ticks    0: do not wait, ETOS_WAIT_FOREVER: wait until notified
+ *
+ * @return
+ * @retval 0                  success
+ * @retval ETOS_RET_BUSY      the value is zero and timeout_ticks is 0
+ * @retval ETOS_RET_TIMEOUT   timeout
+ * @retval other              fail
+ *
+ * @note       do not call this API in an interrupt context
+ * @see        etos_task_notify()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_task_notify_take(u32 *count, u32 timeout_ticks)
+{
+#if (ETOS_NOTIFY_ENABLE)
+    s32 ret;
+    s32 left_ticks;
+    etos_tick deadline;
+    etos_tcb_t *pt_os_task_tcb;
+    etos_task_handle task_handle = etos_sched_get_current_task();
+    etos_init_critical();
+
+    if (!ETOS_TASK_HANDLE_IS_VALID(task_handle)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    pt_os_task_tcb = (etos_tcb_t *)task_handle;
+
+    etos_enter_critical();
+
+    deadline = etos_sched_get_tick() + timeout_ticks;
+
+    /*a notification with zero value is not a count, eg: overwritten by 0, wait the rest ticks*/
+    while (pt_os_task_tcb->notify_value == 0) {
+        pt_os_task_tcb->notify_pending = FALSE;
+
+        ret = _etos_task_notify_pend_idic(pt_os_task_tcb, timeout_ticks);
+        if (ret != ETOS_RET_OK) {
+            etos_exit_critical();
+            return ret;
+        }
+
+        if ((timeout_ticks != ETOS_WAIT_FOREVER) && (pt_os_task_tcb->notify_value == 0)) {
+            left_ticks = (s32)(deadline - etos_sched_get_tick());
+            if (left_ticks <= 0) {
+                pt_os_task_tcb->notify_pending = FALSE;
+                etos_exit_critical();
+                return ETOS_RET_TIMEOUT;
+            }
+            timeout_ticks = (u32)left_ticks;
+        }
+    }
+
+    if (count) {
+        *count = pt_os_task_tcb->notify_value;
+    }
+
+    pt_os_task_tcb->notify_value--;
+    pt_os_task_tcb->notify_pending = (pt_os_task_tcb->notify_value != 0) ? TRUE : FALSE;
+
+    etos_exit_critical();
+
+    return ETOS_RET_OK;
+#else
+    count = count;
+    timeout_ticks = timeout_ticks;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+/* EOF */
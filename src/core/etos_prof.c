@@ -0,0 +1,254 @@
+/******************************************************************************
+File    :  etos_prof.c
+
+This file is part of the ETOS distribution
+Copyright (c) 2026, ETOS Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+(version 2) as published by the Free Software Foundation. See
+the LICENSE file in the top-level directory for more details.
+
+Description:
+		statistical PC sampling profiler
+
+History:
+
+Date           Author       Notes
+----------     -------      -------------------------
+2026-10-19     deeve        Create
+
+*******************************************************************************/
+
+/******************************************************************************
+ *                                 Includes                                   *
+ ******************************************************************************/
+#include "etos_includes.h"
+
+/******************************************************************************
+ *                                 Defines                                    *
+ ******************************************************************************/
+
+/*PC offset in the IRQ frame, see irq in boot.S*/
+#define PROF_IRQ_FRAME_PC_OFFSET       (15)
+
+/******************************************************************************
+ *                                 Global Variables                           *
+ ******************************************************************************/
+
+extern u32 g_os_running_task_num;
+extern u32 *g_os_boot_sp;
+
+/******************************************************************************
+ *                                 Local Variables                            *
+ ******************************************************************************/
+
+#if (ETOS_PROF_ENABLE)
+static u32 _os_prof_pc[ETOS_PROF_SAMPLE_NUM];
+static u8  _os_prof_task[ETOS_PROF_SAMPLE_NUM];
+
+static u32 _os_prof_sample_cnt;
+static u32 _os_prof_dropped_cnt;
+static u32 _os_prof_rate_hz;
+
+static BOOL _os_prof_running;
+#endif
+
+/******************************************************************************
+ *                                 Local Functions                            *
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                 Global Functions                           *
+ ******************************************************************************/
+
+/**
+ * start profiler.
+ * start to record samples, the samples recorded before are kept
+ *
+ * @param[in]    sample_rate_hz    the rate of etos_prof_sample_in_isr() is called,
+ *                                 it is only used by host tool
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @see   etos_prof_stop()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_prof_start(u32 sample_rate_hz)
+{
+#if (ETOS_PROF_ENABLE)
+    if (sample_rate_hz == 0) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    _os_prof_rate_hz = sample_rate_hz;
+    _os_prof_running = TRUE;
+
+    return ETOS_RET_OK;
+#else
+    sample_rate_hz = sample_rate_hz;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+
+/**
+ * stop profiler.
+ *
+ * @param[in]    void
+ *
+ * @return   none
+ *
+ * @see   etos_prof_start()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+void etos_prof_stop(void)
+{
+#if (ETOS_PROF_ENABLE)
+    _os_prof_running = FALSE;
+#endif
+}
+
+
+
+/**
+ * clear all samples.
+ *
+ * @param[in]    void
+ *
+ * @return   none
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+void etos_prof_reset(void)
+{
+#if (ETOS_PROF_ENABLE)
+    etos_init_critical();
+
+    etos_enter_critical();
+    _os_prof_sample_cnt = 0;
+    _os_prof_dropped_cnt = 0;
+    etos_exit_critical();
+#endif
+}
+
+
+
+/**
+ * record one sample.
+ * record the interrupted PC and task from the saved IRQ frame
+ *
+ * @param[in]    void
+ *
+ * @return   none
+ *
+ * @note  it must be called in ISR, eg: timer interrupt service routine
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+void etos_prof_sample_in_isr(void)
+{
+#if (ETOS_PROF_ENABLE)
+    u32 *sp_addr;
+    etos_task_handle task_handle;
+    u8 task_id;
+
+    if (!_os_prof_running) {
+        return;
+    }
+
+    if (_os_prof_sample_cnt >= ETOS_PROF_SAMPLE_NUM) {
+        _os_prof_dropped_cnt++;
+        return;
+    }
+
+    /*the same rule as irq in boot.S, where the interrupted frame is saved*/
+    task_handle = etos_sched_get_current_task();
+    if ((g_os_running_task_num == 0) || (task_handle == 0)) {
+        sp_addr = g_os_boot_sp;
+        task_id = ETOS_PROF_TASK_BOOT;
+    } else {
+        sp_addr = ((etos_tcb_t *)task_handle)->register_stack_pointer;
+        task_id = (u8)(((etos_tcb_t *)task_handle)->base_priority);
+    }
+
+    if (sp_addr == NULL) {
+        _os_prof_dropped_cnt++;
+        return;
+    }
+
+    _os_prof_pc[_os_prof_sample_cnt] = *(sp_addr + PROF_IRQ_FRAME_PC_OFFSET);
+    _os_prof_task[_os_prof_sample_cnt] = task_id;
+    _os_prof_sample_cnt++;
+#endif
+}
+
+
+
+/**
+ * dump samples.
+ * print all samples as text lines, tools/etos_prof.py maps them to functions
+ *
+ * output format:
+ *     EPRF <version> <sample rate hz> <sample num> <dropped num>
+ *     EPN <task id> <task name>
+ *     EPS <pc> <task id>
+ *     EPRF END
+ *
+ * @param[in]    output_handle    gioi handle, eg: xlog_get_output_handle()
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @note  profiler is stopped during dump
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_prof_dump(u32 output_handle)
+{
+#if (ETOS_PROF_ENABLE)
+    u32 i;
+    BOOL running;
+    etos_tcb_t *pt_os_task_tcb;
+
+    if (output_handle == 0) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    running = _os_prof_running;
+    _os_prof_running = FALSE;
+
+    printf(output_handle, "EPRF %d %u %u %u\r\n", ETOS_PROF_VERSION,
+           _os_prof_rate_hz, _os_prof_sample_cnt, _os_prof_dropped_cnt);
+
+    for (i = 0; i < ETOS_MAX_PRIORITY_TASK_NUM; i++) {
+        pt_os_task_tcb = etos_task_get_task(i);
+        if (pt_os_task_tcb && ETOS_TASK_HANDLE_IS_VALID(pt_os_task_tcb->task_handle)) {
+            printf(output_handle, "EPN %u %s\r\n", pt_os_task_tcb->base_priority, pt_os_task_tcb->task_name);
+        }
+    }
+
+    for (i = 0; i < _os_prof_sample_cnt; i++) {
+        printf(output_handle, "EPS %08x %u\r\n", _os_prof_pc[i], _os_prof_task[i]);
+    }
+
+    printf(output_handle, "EPRF END\r\n");
+
+    _os_prof_running = running;
+
+    return ETOS_RET_OK;
+#else
+    output_handle = output_handle;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+/* EOF */
@@ -0,0 +1,436 @@
+/******************************************************************************
+File    :  etos_qset.c
+
+This file is part of the ETOS distribution
+Copyright (c) 2026, ETOS Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+(version 2) as published by the Free Software Foundation. See
+the LICENSE file in the top-level directory for more details.
+
+Description:
+		queue set, wait on multiple message queues and semaphores at once
+
+History:
+
+Date           Author       Notes
+----------     -------      -------------------------
+2026-10-19     deeve        Create
+
+*******************************************************************************/
+
+/******************************************************************************
+ *                                 Includes                                   *
+ ******************************************************************************/
+#include "etos_includes.h"
+
+/******************************************************************************
+ *                                 Defines                                    *
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                 Global Variables                           *
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                 Local Variables                            *
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                 Local Functions                            *
+ ******************************************************************************/
+
+#if (ETOS_QSET_ENABLE)
+
+static BOOL _etos_qset_is_valid(etos_qset_t *qset)
+{
+    return (qset && (qset->qset_check_flag == ETOS_QSET_CHECK_FLAG)) ? TRUE : FALSE;
+}
+
+
+/*the set pointer in member object, NULL if the handle is invalid*/
+static etos_qset_t **_etos_qset_member_link(u32 type, u32 handle)
+{
+    etos_msgq_head_t *msgq_head;
+    etos_sem_t *sem;
+
+    if (type == ETOS_QSET_MEMBER_MSGQ) {
+        msgq_head = (etos_msgq_head_t *)handle;
+        if (msgq_head && (msgq_head->msg_check_flag == ETOS_MSG_CHECK_FLAG)) {
+            return &msgq_head->qset;
+        }
+    } else if (type == ETOS_QSET_MEMBER_SEM) {
+        sem = (etos_sem_t *)handle;
+        if (sem && (sem->sem_check_flag == ETOS_SEM_CHECK_FLAG)) {
+            return &sem->qset;
+        }
+    }
+
+    return NULL;
+}
+
+
+static BOOL _etos_qset_member_is_ready_idic(etos_qset_member_t *member)
+{
+    u32 prio;
+    etos_msgq_head_t *msgq_head;
+
+    if (member->type == ETOS_QSET_MEMBER_MSGQ) {
+        msgq_head = (etos_msgq_head_t *)member->handle;
+        for (prio = 0; prio < ETOS_MSGQ_PRIO_BANDS; prio++) {
+            if (!list_is_empty(&msgq_head->msg_list[prio])) {
+                return TRUE;
+            }
+        }
+    } else if (member->type == ETOS_QSET_MEMBER_SEM) {
+        return (((etos_sem_t *)member->handle)->count > 0) ? TRUE : FALSE;
+    }
+
+    return FALSE;
+}
+
+
+/*find a ready member round robin, NULL if no member is ready*/
+static etos_qset_member_t *_etos_qset_find_ready_idic(etos_qset_t *qset)
+{
+    u32 i, index;
+
+    for (i = 0; i < qset->member_num; i++) {
+        index = (qset->next_member + i) % qset->member_num;
+        if (_etos_qset_member_is_ready_idic(&qset->members[index])) {
+            qset->next_member = index + 1;
+            return &qset->members[index];
+        }
+    }
+
+    return NULL;
+}
+
+#endif
+
+/******************************************************************************
+ *                                 Global Functions                           *
+ ******************************************************************************/
+
+/**
+ * create a queue set.
+ *
+ * @param[out]   qset_handle    output handle for other queue set API
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @see        etos_qset_destroy()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_qset_create(etos_qset_handle *qset_handle)
+{
+#if (ETOS_QSET_ENABLE)
+    etos_qset_t *qset;
+
+    if (qset_handle == NULL) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    qset = (etos_qset_t *)malloc(sizeof(etos_qset_t));
+    if (qset == NULL) {
+        return ETOS_NO_MEM;
+    }
+
+    memset(qset, 0, sizeof(etos_qset_t));
+    etos_waitq_init(&qset->waitq, NULL);
+    qset->qset_check_flag = ETOS_QSET_CHECK_FLAG;
+
+    *qset_handle = (etos_qset_handle)qset;
+
+    return ETOS_RET_OK;
+#else
+    qset_handle = qset_handle;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+
+/**
+ * destroy a queue set.
+ * all members are removed from the set
+ *
+ * @param[in]    qset_handle
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail, a task is selecting the set
+ *
+ * @see        etos_qset_create()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_qset_destroy(etos_qset_handle qset_handle)
+{
+#if (ETOS_QSET_ENABLE)
+    u32 i;
+    etos_qset_t **link;
+    etos_qset_t *qset = (etos_qset_t *)qset_handle;
+    etos_init_critical();
+
+    if (!_etos_qset_is_valid(qset)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    etos_enter_critical();
+
+    if (!etos_waitq_is_empty(&qset->waitq)) {
+        etos_exit_critical();
+        return ETOS_NOT_SUPPORT;
+    }
+
+    for (i = 0; i < qset->member_num; i++) {
+        link = _etos_qset_member_link(qset->members[i].type, qset->members[i].handle);
+        if (link && (*link == qset)) {
+            *link = NULL;
+        }
+    }
+
+    qset->qset_check_flag = 0;
+
+    etos_exit_critical();
+
+    free(qset);
+
+    return ETOS_RET_OK;
+#else
+    qset_handle = qset_handle;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+
+/**
+ * add a message queue or semaphore to a queue set.
+ *
+ * @param[in]    qset_handle
+ * @param[in]    type      etos_qset_member_e
+ * @param[in]    handle    etos_msg_handle or etos_sem_handle
+ *
+ * @return
+ * @retval 0               success
+ * @retval ETOS_RET_BUSY   the member is in a queue set already
+ * @retval other           fail
+ *
+ * @note       an object can be a member of only one queue set
+ * @see        etos_qset_remove()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_qset_add(etos_qset_handle qset_handle, u32 type, u32 handle)
+{
+#if (ETOS_QSET_ENABLE)
+    etos_qset_t **link;
+    etos_qset_t *qset = (etos_qset_t *)qset_handle;
+    etos_init_critical();
+
+    if (!_etos_qset_is_valid(qset)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    link = _etos_qset_member_link(type, handle);
+    if (link == NULL) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    etos_enter_critical();
+
+    if (*link) {
+        etos_exit_critical();
+        return ETOS_RET_BUSY;
+    }
+
+    if (qset->member_num >= ETOS_QSET_MAX_MEMBERS) {
+        etos_exit_critical();
+        return ETOS_NO_MEM;
+    }
+
+    qset->members[qset->member_num].type = type;
+    qset->members[qset->member_num].handle = handle;
+    qset->member_num++;
+    *link = qset;
+
+    etos_exit_critical();
+
+    return ETOS_RET_OK;
+#else
+    qset_handle = qset_handle;
+    type = type;
+    handle = handle;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+
+/**
+ * remove a member from a queue set.
+ *
+ * @param[in]    qset_handle
+ * @param[in]    handle    etos_msg_handle or etos_sem_handle
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @see        etos_qset_add()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_qset_remove(etos_qset_handle qset_handle, u32 handle)
+{
+#if (ETOS_QSET_ENABLE)
+    u32 i;
+    etos_qset_t **link;
+    etos_qset_t *qset = (etos_qset_t *)qset_handle;
+    etos_init_critical();
+
+    if (!_etos_qset_is_valid(qset)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    etos_enter_critical();
+
+    for (i = 0; i < qset->member_num; i++) {
+        if (qset->members[i].handle == handle) {
+            break;
+        }
+    }
+
+    if (i == qset->member_num) {
+        etos_exit_critical();
+        return ETOS_INVALID_PARAM;
+    }
+
+    link = _etos_qset_member_link(qset->members[i].type, handle);
+    if (link && (*link == qset)) {
+        *link = NULL;
+    }
+
+    /*move the last member to the hole*/
+    qset->member_num--;
+    qset->members[i] = qset->members[qset->member_num];
+    qset->next_member = 0;
+
+    etos_exit_critical();
+
+    return ETOS_RET_OK;
+#else
+    qset_handle = qset_handle;
+    handle = handle;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+
+/**
+ * wait until a member of a queue set is ready.
+ * a message queue is ready when it has messages, a semaphore is ready when its count is not 0
+ *
+ * @param[in]    qset_handle
+ * @param[out]   ready_handle     the ready member
+ * @param[in]    timeout_ticks    0: do not wait, ETOS_WAIT_FOREVER: wait until a member is ready
+ *
+ * @return
+ * @retval 0                  success
+ * @retval ETOS_RET_BUSY      no member is ready and timeout_ticks is 0
+ * @retval ETOS_RET_TIMEOUT   timeout
+ * @retval other              fail
+ *
+ * @note       the caller gets the message or semaphore by etos_msgq_recv_no_block() or
+ *             etos_sem_take(h, 0), it may fail if another task gets it first
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_qset_select(etos_qset_handle qset_handle, u32 *ready_handle, u32 timeout_ticks)
+{
+#if (ETOS_QSET_ENABLE)
+    s32 ret;
+    s32 left_ticks;
+    etos_tick deadline;
+    etos_qset_member_t *member;
+    etos_qset_t *qset = (etos_qset_t *)qset_handle;
+    etos_init_critical();
+
+    if (!_etos_qset_is_valid(qset) || (ready_handle == NULL)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    etos_enter_critical();
+
+    deadline = etos_sched_get_tick() + timeout_ticks;
+
+    while ((member = _etos_qset_find_ready_idic(qset)) == NULL) {
+        if (timeout_ticks == 0) {
+            etos_exit_critical();
+            return ETOS_RET_BUSY;
+        }
+
+        /*it is woken up when any member becomes ready*/
+        ret = etos_waitq_pend_idic(&qset->waitq, ETOS_TASK_PENDING_QSET, timeout_ticks, 0, 0);
+        if (ret != ETOS_RET_OK) {
+            etos_exit_critical();
+            return ret;
+        }
+
+        /*the member may be taken by other task before it runs, wait the rest ticks*/
+        if (timeout_ticks != ETOS_WAIT_FOREVER) {
+            left_ticks = (s32)(deadline - etos_sched_get_tick());
+            if (left_ticks <= 0) {
+                etos_exit_critical();
+                return ETOS_RET_TIMEOUT;
+            }
+            timeout_ticks = (u32)left_ticks;
+        }
+    }
+
+    *ready_handle = member->handle;
+
+    etos_exit_critical();
+
+    return ETOS_RET_OK;
+#else
+    qset_handle = qset_handle;
+    ready_handle = ready_handle;
+    timeout_ticks = timeout_ticks;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+
+/**
+ * notify a queue set that a member may be ready in disable interrupt context.
+ * it is called by message queue and semaphore
+ *
+ * @param[in]    qset    the set of the member, can be NULL
+ *
+ * @return   none
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+void etos_qset_notify_idic(struct _etos_qset *qset)
+{
+#if (ETOS_QSET_ENABLE)
+    if (qset) {
+        etos_waitq_wake_all_idic(&qset->waitq, ETOS_RET_OK, 0);
+    }
+#else
+    qset = qset;
+#endif
+}
+
+
+/* EOF */
@@ -0,0 +1,264 @@
+/******************************************************************************
+File    :  etos_ring.c
+
+This file is part of the ETOS distribution
+Copyright (c) 2026, ETOS Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+(version 2) as published by the Free Software Foundation. See
+the LICENSE file in the top-level directory for more details.
+
+Description:
+		lock-free single producer / single consumer byte ring
+
+History:
+
+Date           Author       Notes
+----------     -------      -------------------------
+2026-10-19     deeve        Create
+
+*******************************************************************************/
+
+/******************************************************************************
+ *                                 Includes                                   *
+ ******************************************************************************/
+#include "etos_includes.h"
+
+/******************************************************************************
+ *                                 Defines                                    *
+ ******************************************************************************/
+
+/*
+ * data must be copied before head/tail is published, single core only needs compiler barrier
+ */
+#define RING_BARRIER()    __asm__ __volatile__ ("" : : : "memory")
+
+/******************************************************************************
+ *                                 Global Variables                           *
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                 Local Variables                            *
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                 Local Functions                            *
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                 Global Functions                           *
+ ******************************************************************************/
+
+/**
+ * init a ring.
+ *
+ * @param[in]    ring
+ * @param[in]    buf
+ * @param[in]    size    buffer size, it must be power of 2
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_ring_init(etos_ring_t *ring, u8 *buf, u32 size)
+{
+    if ((ring == NULL) || (buf == NULL) || (size == 0) || (size & (size - 1))) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    ring->head = 0;
+    ring->tail = 0;
+    ring->mask = size - 1;
+    ring->buf = buf;
+    etos_waitq_init(&ring->waitq, NULL);
+
+    return ETOS_RET_OK;
+}
+
+
+
+/**
+ * get the number of bytes in a ring.
+ *
+ * @param[in]    ring
+ *
+ * @return   bytes can be read
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+u32 etos_ring_count(etos_ring_t *ring)
+{
+    return ring->head - ring->tail;
+}
+
+
+
+/**
+ * get the free space of a ring.
+ *
+ * @param[in]    ring
+ *
+ * @return   bytes can be written
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+u32 etos_ring_space(etos_ring_t *ring)
+{
+    return ring->mask + 1 - (ring->head - ring->tail);
+}
+
+
+
+/**
+ * write bytes to a ring.
+ * it is called by the only producer, it can be called in ISR
+ *
+ * @param[in]    ring
+ * @param[in]    data
+ * @param[in]    len
+ *
+ * @return   bytes written, it is less than len when the ring is full
+ *
+ * @note       interrupt is disabled only when the consumer is waiting
+ * @see        etos_ring_get()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+u32 etos_ring_put(etos_ring_t *ring, const u8 *data, u32 len)
+{
+    u32 head = ring->head;
+    u32 space, index, copy_len;
+    etos_init_critical();
+
+    space = ring->mask + 1 - (head - ring->tail);
+    if (len > space) {
+        len = space;
+    }
+
+    if (len == 0) {
+        return 0;
+    }
+
+    index = head & ring->mask;
+    copy_len = ring->mask + 1 - index;
+    if (copy_len >= len) {
+        memcpy(&ring->buf[index], data, len);
+    } else {
+        memcpy(&ring->buf[index], data, copy_len);
+        memcpy(&ring->buf[0], data + copy_len, len - copy_len);
+    }
+
+    RING_BARRIER();
+    ring->head = head + len;
+    RING_BARRIER();
+
+    /*the consumer queues itself with interrupt disabled after it sees an empty ring*/
+    if (!etos_waitq_is_empty(&ring->waitq)) {
+        etos_enter_critical();
+        etos_waitq_wake_one_idic(&ring->waitq, ETOS_RET_OK, 0);
+        etos_exit_critical();
+    }
+
+    return len;
+}
+
+
+
+/**
+ * read bytes from a ring.
+ * it is called by the only consumer
+ *
+ * @param[in]    ring
+ * @param[out]   buf
+ * @param[in]    len
+ *
+ * @return   bytes read, 0 if the ring is empty
+ *
+ * @see        etos_ring_put()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+u32 etos_ring_get(etos_ring_t *ring, u8 *buf, u32 len)
+{
+    u32 tail = ring->tail;
+    u32 count, index, copy_len;
+
+    count = ring->head - tail;
+    if (len > count) {
+        len = count;
+    }
+
+    if (len == 0) {
+        return 0;
+    }
+
+    RING_BARRIER();
+
+    index = tail & ring->mask;
+    copy_len = ring->mask + 1 - index;
+    if (copy_len >= len) {
+        memcpy(buf, &ring->buf[index], len);
+    } else {
+        memcpy(buf, &ring->buf[index], copy_len);
+        memcpy(buf + copy_len, &ring->buf[0], len - copy_len);
+    }
+
+    RING_BARRIER();
+    ring->tail = tail + len;
+
+    return len;
+}
+
+
+
+/**
+ * wait until a ring is not empty.
+ * it is called by the only consumer
+ *
+ * @param[in]    ring
+ * @param[in]    timeout_ticks    0: do not wait, ETOS_WAIT_FOREVER: wait until data comes
+ *
+ * @return
+ * @retval 0                  success, some data can be read
+ * @retval ETOS_RET_BUSY      the ring is empty and timeout_ticks is 0
+ * @retval ETOS_RET_TIMEOUT   timeout
+ * @retval other              fail
+ *
+ * @note       do not call this API in an interrupt context
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_ring_wait(etos_ring_t *ring, u32 timeout_ticks)
+{
+    s32 ret = ETOS_RET_OK;
+    etos_init_critical();
+
+    /*fast path*/
+    if (ring->head != ring->tail) {
+        return ETOS_RET_OK;
+    }
+
+    if (timeout_ticks == 0) {
+        return ETOS_RET_BUSY;
+    }
+
+    etos_enter_critical();
+
+    /*check again, the producer may put data before interrupt is disabled*/
+    if (ring->head == ring->tail) {
+        ret = etos_waitq_pend_idic(&ring->waitq, ETOS_TASK_PENDING_STREAM, timeout_ticks, 0, 0);
+    }
+
+    etos_exit_critical();
+
+    return ret;
+}
+
+
+/* EOF */
@@ -18,6 +18,14 @@ Date           Author       Notes
 ----------     -------      -------------------------
 2013-10-20     deeve        Create
 2015-4-15      deeve        Add some comments
+2026-10-19     deeve        Add trace points and timestamp source
+2026-10-19     deeve        Add task execution budget check
+2026-10-19     deeve        Notify sporadic server when it pending
+2026-10-19     deeve        Add priority swap for mutex priority inheritance
+2026-10-19     deeve        Add 64 bit tick protected by seqlock
+2026-10-19     deeve        Add timestamp to us conversion
+2026-10-19     deeve        Start a new budget activation when a task is suspended
+2026-10-19     deeve        Add owed tick, carry high 32 bits in etos_sched_set_tick()
 
 *******************************************************************************/
 
@@ -93,10 +101,47 @@ static u32 _os_sched_priority_mask_between_2_intrs;
 static etos_tick _os_tick;
 
 
+/* high 32 bits of 64 bit tick, _os_tick and it are read without disable interrupt by seqlock */
+static u32 _os_tick_hi;
+static etos_seqlock_t _os_tick_seqlock = ETOS_SEQLOCK_INITIALIZER;
+
+/* ticks acknowledged by the tick timer ISR but not added to _os_tick yet, see etos_sched_owe_tick_idic() */
+static u32 _os_tick_owed;
+
+
+/* timestamp source, system tick is used when it is NULL */
+static pfunc_timestamp _os_pfunc_timestamp;
+static u32 _os_timestamp_freq = (1000 * TICK_COUNT_IN_16_MILLISECONDS) / 16;
+
+
 /******************************************************************************
  *                                 Local Functions                            *
  ******************************************************************************/
 
+/*add offset to the 64 bit tick, it is called in the write section of tick seqlock*/
+static void _etos_sched_add_tick_idic(s32 offset)
+{
+    etos_tick tick_old = _os_tick;
+
+    _os_tick += offset;
+
+    /*carry or borrow to high 32 bits*/
+    if ((offset > 0) && (_os_tick < tick_old)) {
+        _os_tick_hi++;
+    } else if ((offset < 0) && (_os_tick > tick_old)) {
+        _os_tick_hi--;
+    }
+}
+
+/*trace task switch, it is called in disable interrupt context*/
+static inline void _etos_sched_trace_switch(etos_task_handle from, etos_task_handle to)
+{
+    if (from != to) {
+        ETOS_TRACE_IDIC(ETOS_TRACE_EVT_SWITCH, 0, etos_trace_task_id(to));
+    }
+}
+
+
 /*the common entry for all task*/
 s32 _etos_sched_task_common_entry(etos_tcb_t *pt_os_task_tcb)
 {
@@ -120,6 +165,9 @@ void _etos_sched_start_task_idic(etos_tcb_t *pt_os_task_tcb)
 
     pt_os_task_tcb->task_state = ETOS_TASK_RUNNING;
     g_os_current_task_handle = pt_os_task_tcb->task_handle;
+#if (ETOS_TASK_BUDGET_ENABLE)
+    pt_os_task_tcb->run_ticks = 0;
+#endif
 
     g_os_running_task_num++;
 
@@ -138,6 +186,8 @@ void _etos_sched_start_task_idic(etos_tcb_t *pt_os_task_tcb)
     /*remove from schedule list*/
     etos_disable_cpu_interrupt();
 
+    ETOS_TRACE_IDIC(ETOS_TRACE_EVT_TASK_END, 0, (u32)ret);
+
     _os_sched_priority_mask_between_2_intrs &= (~mask_val);
     pt_os_task_tcb->task_state = ETOS_TASK_END;
 
@@ -216,13 +266,21 @@ etos_tick etos_sched_get_tick(void)
  *
  * @return  none
  *
- * @note none
+ * @note the 64 bit tick moves by the signed difference from current tick, it carries or borrows
+ *       the high 32 bits like etos_sched_adjust_tick()
  * @authors    deeve
  * @date       2015/4/15
  */
 void etos_sched_set_tick(etos_tick tick)
 {
-    _os_tick = tick;
+    etos_init_critical();
+
+    etos_enter_critical();
+    etos_seqlock_write_begin_idic(&_os_tick_seqlock);
+    /*the 64 bit tick moves by the signed difference of low 32 bits, so it does not jump by 2^32*/
+    _etos_sched_add_tick_idic((s32)(tick - _os_tick));
+    etos_seqlock_write_end_idic(&_os_tick_seqlock);
+    etos_exit_critical();
 }
 
 
@@ -235,13 +293,244 @@ void etos_sched_set_tick(etos_tick tick)
  *
  * @return   none
  *
- * @note none
+ * @note the ticks owed by etos_sched_owe_tick_idic() are paid by a positive offset
  * @authors    deeve
  * @date       2015/4/15
  */
 void etos_sched_adjust_tick(s32 offset)
 {
-    _os_tick += offset;
+    etos_init_critical();
+
+    etos_enter_critical();
+    etos_seqlock_write_begin_idic(&_os_tick_seqlock);
+
+    _etos_sched_add_tick_idic(offset);
+
+    /*the owed ticks are added now*/
+    if (offset > 0) {
+        _os_tick_owed = (_os_tick_owed > (u32)offset) ? (_os_tick_owed - offset) : 0;
+    }
+
+    etos_seqlock_write_end_idic(&_os_tick_seqlock);
+    etos_exit_critical();
+}
+
+
+
+/**
+ * owe a tick in the tick timer ISR.
+ * the tick timer ISR acknowledges the hardware before the tick is added by etos_sched_adjust_tick(),
+ * the tick is owed in between, so a time base which combines the tick and the hardware counter
+ * counts it and does not go back
+ *
+ * @param[in]    void
+ *
+ * @return   none
+ *
+ * @note  call it in the ISR which returns ETOS_ISR_RESCHEDULE_UPDATE_TICK, before the interrupt is cleared
+ * @see   etos_sched_get_owed_tick()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+void etos_sched_owe_tick_idic(void)
+{
+    etos_seqlock_write_begin_idic(&_os_tick_seqlock);
+    _os_tick_owed++;
+    etos_seqlock_write_end_idic(&_os_tick_seqlock);
+}
+
+
+
+/**
+ * get owed tick.
+ * read it with etos_sched_get_tick() between etos_sched_tick_read_begin() and etos_sched_tick_read_retry()
+ *
+ * @param[in]    void
+ *
+ * @return   ticks owed by etos_sched_owe_tick_idic() and not added to the tick yet
+ *
+ * @see   etos_sched_owe_tick_idic()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+u32 etos_sched_get_owed_tick(void)
+{
+    return _os_tick_owed;
+}
+
+
+
+/**
+ * get 64 bit tick.
+ * the tick does not wrap around, it is read without disable interrupt
+ *
+ * @param[in]    void
+ *
+ * @return  64 bit tick, the low 32 bits is etos_sched_get_tick()
+ *
+ * @note  do not call it in the context which interrupts the tick update
+ * @see   etos_sched_tick_read_begin()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+u64 etos_sched_get_tick64(void)
+{
+    u32 sequence;
+    u32 tick_lo, tick_hi;
+
+    do {
+        sequence = etos_seqlock_read_begin(&_os_tick_seqlock);
+        tick_lo = _os_tick;
+        tick_hi = _os_tick_hi;
+    } while (etos_seqlock_read_retry(&_os_tick_seqlock, sequence));
+
+    return ((u64)tick_hi << 32) | tick_lo;
+}
+
+
+
+/**
+ * begin to read the time base.
+ * a time source which combines the tick and a hardware counter reads them between
+ * etos_sched_tick_read_begin() and etos_sched_tick_read_retry(), and reads again if it is retry
+ *
+ * @param[in]    void
+ *
+ * @return   sequence which is passed to etos_sched_tick_read_retry()
+ *
+ * @see   etos_sched_tick_read_retry()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+u32 etos_sched_tick_read_begin(void)
+{
+    return etos_seqlock_read_begin(&_os_tick_seqlock);
+}
+
+
+
+/**
+ * check whether the tick is updated during reading the time base.
+ *
+ * @param[in]    sequence    returned by etos_sched_tick_read_begin()
+ *
+ * @return
+ * @retval TRUE    the tick is updated, read again
+ * @retval FALSE   the values read are consistent
+ *
+ * @see   etos_sched_tick_read_begin()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+BOOL etos_sched_tick_read_retry(u32 sequence)
+{
+    return etos_seqlock_read_retry(&_os_tick_seqlock, sequence);
+}
+
+
+
+/**
+ * register timestamp source.
+ * register a high resolution free running counter which is used by trace
+ * and statistics, the system tick is used if there is no timestamp source
+ *
+ * @param[in]    pfunc_ts     function pointer which returns current timestamp
+ * @param[in]    freq_hz      timestamp counter frequency
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @note  pfunc_ts may be called in ISR and disable interrupt context
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_sched_register_timestamp(pfunc_timestamp pfunc_ts, u32 freq_hz)
+{
+    if ((pfunc_ts == NULL) || (freq_hz == 0)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    _os_timestamp_freq = freq_hz;
+    _os_pfunc_timestamp = pfunc_ts;
+
+    return ETOS_RET_OK;
+}
+
+
+
+/**
+ * get timestamp.
+ * get current timestamp from the registered timestamp source
+ *
+ * @param[in]    void
+ *
+ * @return   timestamp
+ *
+ * @note  it wraps around, use (u32)(end - begin) to get the duration
+ * @see   etos_sched_get_timestamp_freq()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+u32 etos_sched_get_timestamp(void)
+{
+    if (_os_pfunc_timestamp) {
+        return _os_pfunc_timestamp();
+    }
+
+    return _os_tick;
+}
+
+
+
+/**
+ * get timestamp frequency.
+ * get the count of timestamp in one second
+ *
+ * @param[in]    void
+ *
+ * @return   frequency in Hz
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+u32 etos_sched_get_timestamp_freq(void)
+{
+    return _os_timestamp_freq;
+}
+
+
+
+/**
+ * convert timestamp count to us.
+ * the duration measured by timestamp is converted with 32 bit division only, armv4 has no
+ * divide instruction and the 64 bit division of libgcc is much slower than the 32 bit one
+ *
+ * @param[in]    count    timestamp count, eg: (u32)(end - begin)
+ *
+ * @return   us
+ *
+ * @note  it wraps around if the duration is longer than about 4294 seconds
+ * @see   etos_sched_get_timestamp_freq()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+u32 etos_sched_timestamp_to_us(u32 count)
+{
+    u32 rem;
+    u32 freq = _os_timestamp_freq;
+
+    if (freq == 0) {
+        return count;
+    }
+
+    if (freq >= 1000000) {
+        return count / (freq / 1000000);
+    }
+
+    /*count * 1000000 / freq, each product is smaller than freq * 1000, so it does not overflow*/
+    rem = (count % freq) * 1000;
+    return (count / freq) * 1000000 + (rem / freq) * 1000 + ((rem % freq) * 1000) / freq;
 }
 
 
@@ -443,6 +732,8 @@ void etos_sched_do_schedule_in_isr(etos_task_handle task_handle)
     etos_task_handle *current_task_handle = &g_os_current_task_handle;
     u32 *boot_sp = g_os_boot_sp;
 
+    _etos_sched_trace_switch(*current_task_handle, task_handle);
+
     if (*current_task_handle) {
         /* not from a task end or boot code */
         ASSERT(ETOS_TASK_HANDLE_IS_VALID(*current_task_handle));
@@ -540,6 +831,8 @@ s32 etos_sched_do_schedule_idic(etos_task_handle task_handle, etos_task_state_e
     register etos_tcb_t *pt_os_task_tcb_cur;
     register etos_tcb_t *pt_os_task_tcb_next = (etos_tcb_t *)task_handle;
 
+    _etos_sched_trace_switch(g_os_current_task_handle, task_handle);
+
     if (g_os_current_task_handle) { /* not from a task end */
         ASSERT(ETOS_TASK_HANDLE_IS_VALID(g_os_current_task_handle));
 
@@ -606,8 +899,10 @@ s32 etos_sched_do_schedule_idic(etos_task_handle task_handle, etos_task_state_e
                 g_os_running_task_num++;
             }
 
+#if (ETOS_SCHED_VERBOSE_LOG)
             xlogi(LOG_MODULE_ETOS, "task num=%d switch from %s to %s\r\n", g_os_running_task_num,
                   pt_os_task_tcb_cur->task_name, pt_os_task_tcb_next->task_name);
+#endif
             os_switch_task_context(&pt_os_task_tcb_cur->register_stack_pointer, pt_os_task_tcb_next->register_stack_pointer, 0);
         }
     }
@@ -636,9 +931,12 @@ s32 etos_sched_do_schedule_idic(etos_task_handle task_handle, etos_task_state_e
 s32 etos_sched_pending_task(etos_task_handle task_handle, etos_task_state_e reason)
 {
     register etos_task_handle task_handle_next;
-    register etos_tcb_t *pt_os_task_tcb_cur, *pt_os_task_tcb_next;
+    register etos_tcb_t *pt_os_task_tcb_cur;
     u32 mask_val;
+#if (ETOS_SCHED_VERBOSE_LOG)
+    register etos_tcb_t *pt_os_task_tcb_next;
     u32 *sp_addr;
+#endif
     etos_init_critical();
 
     if (ETOS_TASK_HANDLE_IS_VALID(task_handle)) {
@@ -659,7 +957,22 @@ s32 etos_sched_pending_task(etos_task_handle task_handle, etos_task_state_e reas
 
     g_os_running_task_num--;
 
+    ETOS_TRACE_IDIC(ETOS_TRACE_EVT_PEND, 0, reason);
+
+#if (ETOS_TASK_BUDGET_ENABLE)
+    /*new activation after resume*/
+    pt_os_task_tcb_cur->run_ticks = 0;
+#endif
+
+    /*the demoted task gets its priority back, sporadic server manages its priority itself*/
+    if (!etos_sporadic_pending_idic(task_handle)
+        && (pt_os_task_tcb_cur->priority < pt_os_task_tcb_cur->base_priority)) {
+        etos_sched_change_priority_idic(task_handle, pt_os_task_tcb_cur->base_priority);
+    }
+
     task_handle_next = etos_sched_pick_next_task_idic(etos_sched_get_tick());
+
+#if (ETOS_SCHED_VERBOSE_LOG)
     pt_os_task_tcb_next = (etos_tcb_t *)task_handle_next;
 
     if (pt_os_task_tcb_next) {
@@ -676,6 +989,7 @@ s32 etos_sched_pending_task(etos_task_handle task_handle, etos_task_state_e reas
         xlogi(LOG_MODULE_ETOS, "cpsr:0x%x lr:0x%x pc:0x%x task num:%d\r\n", *sp_addr,
               *(sp_addr + 14), *(sp_addr + 15), g_os_running_task_num);
     }
+#endif
 
     etos_sched_do_schedule_idic(task_handle_next, reason);
 
@@ -729,13 +1043,17 @@ s32 etos_sched_resume_task(etos_task_handle task_handle, etos_task_state_e reaso
     pt_os_task_tcb->task_state &= (~reason);
     pt_os_task_tcb->task_state |= ETOS_TASK_READY;
 
+    ETOS_TRACE_IDIC(ETOS_TRACE_EVT_READY, pt_os_task_tcb->base_priority, reason);
+
     etos_exit_critical();
 
+#if (ETOS_SCHED_VERBOSE_LOG)
     xlogi(LOG_MODULE_ETOS, "resume task: name=%s pc=0x%x lr=0x%x reason=0x%x\r\n",
           pt_os_task_tcb->task_name,
           *(pt_os_task_tcb->register_stack_pointer + 15),
           *(pt_os_task_tcb->register_stack_pointer + 14),
           reason);
+#endif
 
     return ETOS_RET_OK;
 }
@@ -764,7 +1082,9 @@ s32 etos_sched_resume_task_idic(etos_task_handle task_handle, etos_task_state_e
 {
     register etos_tcb_t *pt_os_task_tcb;
     u32 mask_val;
+#if (ETOS_SCHED_VERBOSE_LOG)
     u32 *sp_addr;
+#endif
 
     if (ETOS_TASK_HANDLE_IS_VALID(task_handle)) {
         pt_os_task_tcb = (etos_tcb_t *)task_handle;
@@ -782,6 +1102,9 @@ s32 etos_sched_resume_task_idic(etos_task_handle task_handle, etos_task_state_e
     pt_os_task_tcb->task_state &= (~reason);
     pt_os_task_tcb->task_state |= ETOS_TASK_READY;
 
+    ETOS_TRACE_IDIC(ETOS_TRACE_EVT_READY, pt_os_task_tcb->base_priority, reason);
+
+#if (ETOS_SCHED_VERBOSE_LOG)
     if (g_os_current_task_handle) {
         sp_addr = ((etos_tcb_t *)(g_os_current_task_handle))->register_stack_pointer;
         xlogi(LOG_MODULE_ETOS, "interrupted task: cpsr:0x%x lr:0x%x pc:0x%x\r\n", *sp_addr,
@@ -798,11 +1121,227 @@ s32 etos_sched_resume_task_idic(etos_task_handle task_handle, etos_task_state_e
           *(pt_os_task_tcb->register_stack_pointer + 15),
           *(pt_os_task_tcb->register_stack_pointer + 14),
           reason);
+#endif
+
+    return ETOS_RET_OK;
+}
+
+
+
+/**
+ * change task priority in disable interrupt context.
+ * change the effective priority of a task, the schedule mask follows the new priority
+ *
+ * @param[in]    task_handle
+ * @param[in]    new_priority     it must be free, see etos_task_priority_is_free_idic()
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @note  the new priority takes effect at next schedulable time
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_sched_change_priority_idic(etos_task_handle task_handle, u32 new_priority)
+{
+    s32 ret;
+    u32 old_mask_val, new_mask_val;
+    etos_tcb_t *pt_os_task_tcb = (etos_tcb_t *)task_handle;
+
+    if (!ETOS_TASK_HANDLE_IS_VALID(task_handle)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    old_mask_val = 1 << (ETOS_MAX_PRIORITY_TASK_NUM - 1 - pt_os_task_tcb->priority);
+
+    ret = etos_task_bind_priority_idic(task_handle, new_priority);
+    if (ret != ETOS_RET_OK) {
+        return ret;
+    }
+
+    new_mask_val = 1 << (ETOS_MAX_PRIORITY_TASK_NUM - 1 - new_priority);
+
+    if (g_os_sched_original_mask & old_mask_val) {
+        g_os_sched_original_mask &= (~old_mask_val);
+        g_os_sched_original_mask |= new_mask_val;
+    }
+
+    if (_os_sched_priority_mask_between_2_intrs & old_mask_val) {
+        _os_sched_priority_mask_between_2_intrs &= (~old_mask_val);
+        _os_sched_priority_mask_between_2_intrs |= new_mask_val;
+    }
+
+    return ETOS_RET_OK;
+}
+
+
+
+/**
+ * swap the priorities of two tasks in disable interrupt context.
+ * exchange the effective priorities of two tasks, the schedule masks follow them
+ *
+ * @param[in]    task_handle_a
+ * @param[in]    task_handle_b
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @note  it is used by priority inheritance, the owner borrows the priority of
+ *        a pending waiter, and the waiter keeps the priority of the owner
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_sched_swap_priority_idic(etos_task_handle task_handle_a, etos_task_handle task_handle_b)
+{
+    s32 ret;
+    u32 mask_val_a, mask_val_b, bits;
+
+    if (!ETOS_TASK_HANDLE_IS_VALID(task_handle_a) || !ETOS_TASK_HANDLE_IS_VALID(task_handle_b)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    mask_val_a = 1 << (ETOS_MAX_PRIORITY_TASK_NUM - 1 - ((etos_tcb_t *)task_handle_a)->priority);
+    mask_val_b = 1 << (ETOS_MAX_PRIORITY_TASK_NUM - 1 - ((etos_tcb_t *)task_handle_b)->priority);
+
+    ret = etos_task_swap_priority_idic(task_handle_a, task_handle_b);
+    if (ret != ETOS_RET_OK) {
+        return ret;
+    }
+
+    bits = g_os_sched_original_mask & (mask_val_a | mask_val_b);
+    if ((bits == mask_val_a) || (bits == mask_val_b)) {
+        g_os_sched_original_mask ^= (mask_val_a | mask_val_b);
+    }
+
+    bits = _os_sched_priority_mask_between_2_intrs & (mask_val_a | mask_val_b);
+    if ((bits == mask_val_a) || (bits == mask_val_b)) {
+        _os_sched_priority_mask_between_2_intrs ^= (mask_val_a | mask_val_b);
+    }
 
     return ETOS_RET_OK;
 }
 
 
 
+/**
+ * move task to a priority in disable interrupt context.
+ * the task is moved to the priority if it is free, or swaps priority with the
+ * pending task which runs at the priority
+ *
+ * @param[in]    task_handle
+ * @param[in]    new_priority
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail, the priority is used by another schedulable task
+ *
+ * @see   etos_sched_swap_priority_idic()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_sched_set_priority_idic(etos_task_handle task_handle, u32 new_priority)
+{
+    etos_tcb_t *pt_os_task_tcb_occupant;
+
+    if (!ETOS_TASK_HANDLE_IS_VALID(task_handle) || (new_priority >= ETOS_MAX_PRIORITY_TASK_NUM)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    pt_os_task_tcb_occupant = etos_task_get_task(ETOS_MAX_PRIORITY_TASK_NUM - 1 - new_priority);
+
+    if ((pt_os_task_tcb_occupant == NULL) || (pt_os_task_tcb_occupant->task_handle == task_handle)) {
+        return etos_sched_change_priority_idic(task_handle, new_priority);
+    }
+
+    /*only the priority of a pending task can be borrowed*/
+    if (pt_os_task_tcb_occupant->task_state & (ETOS_TASK_CREATED | ETOS_TASK_RUNNING
+                                               | ETOS_TASK_INTERRUPTED | ETOS_TASK_READY)) {
+        return ETOS_RET_BUSY;
+    }
+
+    return etos_sched_swap_priority_idic(task_handle, pt_os_task_tcb_occupant->task_handle);
+}
+
+
+
+/**
+ * update task execution budget in interrupt service routine.
+ * account one tick to the interrupted task, and take the budget action
+ * when the task runs over its budget in current activation
+ *
+ * @param[in]    task_handle      the interrupted task, it may be zero (boot code)
+ *
+ * @return   none
+ *
+ * @note  it is called in tick ISR before reschedule
+ * @see   etos_task_set_budget()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+void etos_sched_update_budget_in_isr(etos_task_handle task_handle)
+{
+#if (ETOS_TASK_BUDGET_ENABLE)
+    u32 priority, mask_val;
+    etos_tcb_t *pt_os_task_tcb = (etos_tcb_t *)task_handle;
+
+    if (!ETOS_TASK_HANDLE_IS_VALID(task_handle)) {
+        return;
+    }
+
+    pt_os_task_tcb->run_ticks++;
+
+    /*only take action once in one activation*/
+    if ((pt_os_task_tcb->budget_ticks == 0)
+        || (pt_os_task_tcb->run_ticks != pt_os_task_tcb->budget_ticks + 1)) {
+        return;
+    }
+
+    pt_os_task_tcb->overrun_cnt++;
+
+    switch (pt_os_task_tcb->budget_action) {
+        case ETOS_BUDGET_ACTION_LOG:
+            xlogw(LOG_MODULE_ETOS, "task:%s overrun budget:%d cnt:%d\r\n", pt_os_task_tcb->task_name,
+                  pt_os_task_tcb->budget_ticks, pt_os_task_tcb->overrun_cnt);
+            break;
+        case ETOS_BUDGET_ACTION_DEMOTE:
+            /*find the nearest free priority from demote_priority*/
+            for (priority = pt_os_task_tcb->demote_priority; priority < pt_os_task_tcb->priority; priority++) {
+                if (etos_task_priority_is_free_idic(priority, task_handle)) {
+                    etos_sched_change_priority_idic(task_handle, priority);
+                    break;
+                }
+            }
+            break;
+        case ETOS_BUDGET_ACTION_SUSPEND:
+            mask_val = 1 << (ETOS_MAX_PRIORITY_TASK_NUM - 1 - pt_os_task_tcb->priority);
+            g_os_sched_original_mask &= (~mask_val);
+            _os_sched_priority_mask_between_2_intrs &= (~mask_val);
+            /*it is not schedulable any more, other pending reasons are kept*/
+            pt_os_task_tcb->task_state &= ~(ETOS_TASK_RUNNING | ETOS_TASK_INTERRUPTED | ETOS_TASK_READY);
+            pt_os_task_tcb->task_state |= ETOS_TASK_SUSPENDED;
+            /*the next activation starts when it is resumed*/
+            pt_os_task_tcb->run_ticks = 0;
+            if (g_os_running_task_num) {
+                g_os_running_task_num--;
+            }
+            ETOS_TRACE_IDIC(ETOS_TRACE_EVT_PEND, 0, ETOS_TASK_SUSPENDED);
+            break;
+        case ETOS_BUDGET_ACTION_HOOK:
+            if (pt_os_task_tcb->budget_hook) {
+                pt_os_task_tcb->budget_hook(task_handle, pt_os_task_tcb->run_ticks);
+            }
+            break;
+        default:
+            break;
+    }
+#else
+    task_handle = task_handle;
+#endif
+}
+
+
+
 /* EOF */
 
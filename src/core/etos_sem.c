@@ -0,0 +1,318 @@
+/******************************************************************************
+File    :  etos_sem.c
+
+This file is part of the ETOS distribution
+Copyright (c) 2026, ETOS Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+(version 2) as published by the Free Software Foundation. See
+the LICENSE file in the top-level directory for more details.
+
+Description:
+		counting and binary semaphore
+
+History:
+
+Date           Author       Notes
+----------     -------      -------------------------
+2026-10-19     deeve        Create
+2026-10-19     deeve        Use generic wait queue
+2026-10-19     deeve        Notify queue set
+
+*******************************************************************************/
+
+/******************************************************************************
+ *                                 Includes                                   *
+ ******************************************************************************/
+#include "etos_includes.h"
+
+/******************************************************************************
+ *                                 Defines                                    *
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                 Global Variables                           *
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                 Local Variables                            *
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                 Local Functions                            *
+ ******************************************************************************/
+
+#if (ETOS_SEM_ENABLE)
+
+static BOOL _etos_sem_is_valid(etos_sem_t *sem)
+{
+    return (sem && (sem->sem_check_flag == ETOS_SEM_CHECK_FLAG)) ? TRUE : FALSE;
+}
+
+
+#endif
+
+/******************************************************************************
+ *                                 Global Functions                           *
+ ******************************************************************************/
+
+/**
+ * create a semaphore.
+ *
+ * @param[in]    init_count    initial count, it must not be larger than max_count
+ * @param[in]    max_count     ETOS_SEM_BINARY for binary semaphore
+ * @param[out]   sem_handle    output handle for other semaphore API
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @see        etos_sem_destroy()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_sem_create(u32 init_count, u32 max_count, etos_sem_handle *sem_handle)
+{
+#if (ETOS_SEM_ENABLE)
+    etos_sem_t *sem;
+
+    if ((sem_handle == NULL) || (max_count == 0) || (init_count > max_count)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    sem = (etos_sem_t *)malloc(sizeof(etos_sem_t));
+    if (sem == NULL) {
+        return ETOS_NO_MEM;
+    }
+
+    etos_waitq_init(&sem->waitq, NULL);
+    sem->count = init_count;
+    sem->max_count = max_count;
+    sem->qset = NULL;
+    sem->sem_check_flag = ETOS_SEM_CHECK_FLAG;
+
+    *sem_handle = (etos_sem_handle)sem;
+
+    return ETOS_RET_OK;
+#else
+    init_count = init_count;
+    max_count = max_count;
+    sem_handle = sem_handle;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+
+/**
+ * destroy a semaphore.
+ *
+ * @param[in]    sem_handle
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail, a task is waiting for the semaphore or it is in a queue set
+ *
+ * @see        etos_sem_create()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_sem_destroy(etos_sem_handle sem_handle)
+{
+#if (ETOS_SEM_ENABLE)
+    etos_sem_t *sem = (etos_sem_t *)sem_handle;
+    etos_init_critical();
+
+    if (!_etos_sem_is_valid(sem)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    etos_enter_critical();
+
+    if (!etos_waitq_is_empty(&sem->waitq) || sem->qset) {
+        etos_exit_critical();
+        return ETOS_NOT_SUPPORT;
+    }
+
+    sem->sem_check_flag = 0;
+
+    etos_exit_critical();
+
+    free(sem);
+
+    return ETOS_RET_OK;
+#else
+    sem_handle = sem_handle;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+
+/**
+ * take a semaphore.
+ * the caller pends until the semaphore is given or timeout
+ *
+ * @param[in]    sem_handle
+ * @param[in]    timeout_ticks    0: do not wait, ETOS_WAIT_FOREVER: wait until it is given
+ *
+ * @return
+ * @retval 0                  success
+ * @retval ETOS_RET_BUSY      count is 0 and timeout_ticks is 0
+ * @retval ETOS_RET_TIMEOUT   timeout
+ * @retval other              fail
+ *
+ * @note       do not call this API in an interrupt context
+ * @see        etos_sem_give()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_sem_take(etos_sem_handle sem_handle, u32 timeout_ticks)
+{
+#if (ETOS_SEM_ENABLE)
+    s32 ret;
+    etos_sem_t *sem = (etos_sem_t *)sem_handle;
+    etos_init_critical();
+
+    if (!_etos_sem_is_valid(sem)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    etos_enter_critical();
+
+    if (sem->count > 0) {
+        sem->count--;
+        etos_exit_critical();
+        return ETOS_RET_OK;
+    }
+
+    if (timeout_ticks == 0) {
+        etos_exit_critical();
+        return ETOS_RET_BUSY;
+    }
+
+    /*pending itself, it is resumed by give or timeout*/
+    ret = etos_waitq_pend_idic(&sem->waitq, ETOS_TASK_PENDING_SEM, timeout_ticks, 0, 0);
+
+    etos_exit_critical();
+
+    return ret;
+#else
+    sem_handle = sem_handle;
+    timeout_ticks = timeout_ticks;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+
+/**
+ * give a semaphore.
+ * wake up the highest waiter, or increase the count if there is no waiter
+ *
+ * @param[in]    sem_handle
+ *
+ * @return
+ * @retval 0               success
+ * @retval ETOS_RET_BUSY   the count reaches max_count
+ * @retval other           fail
+ *
+ * @see        etos_sem_take()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_sem_give(etos_sem_handle sem_handle)
+{
+    s32 ret;
+    etos_init_critical();
+
+    etos_enter_critical();
+    ret = etos_sem_give_idic(sem_handle);
+    etos_exit_critical();
+
+    return ret;
+}
+
+
+
+/**
+ * give a semaphore in disable interrupt context.
+ * it can be called in ISR
+ *
+ * @param[in]    sem_handle
+ *
+ * @return
+ * @retval 0               success
+ * @retval ETOS_RET_BUSY   the count reaches max_count
+ * @retval other           fail
+ *
+ * @note       the woken task runs at next schedulable time
+ * @see        etos_sem_give()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_sem_give_idic(etos_sem_handle sem_handle)
+{
+#if (ETOS_SEM_ENABLE)
+    etos_sem_t *sem = (etos_sem_t *)sem_handle;
+
+    if (!_etos_sem_is_valid(sem)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    if (etos_waitq_is_empty(&sem->waitq)) {
+        if (sem->count >= sem->max_count) {
+            return ETOS_RET_BUSY;
+        }
+        sem->count++;
+        etos_qset_notify_idic(sem->qset);
+        return ETOS_RET_OK;
+    }
+
+    /*hand over to the highest waiter directly, count is not changed*/
+    etos_waitq_wake_one_idic(&sem->waitq, ETOS_RET_OK, 0);
+
+    return ETOS_RET_OK;
+#else
+    sem_handle = sem_handle;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+
+/**
+ * get the count of a semaphore.
+ *
+ * @param[in]    sem_handle
+ * @param[out]   count
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_sem_get_count(etos_sem_handle sem_handle, u32 *count)
+{
+#if (ETOS_SEM_ENABLE)
+    etos_sem_t *sem = (etos_sem_t *)sem_handle;
+
+    if (!_etos_sem_is_valid(sem) || (count == NULL)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    *count = sem->count;
+
+    return ETOS_RET_OK;
+#else
+    sem_handle = sem_handle;
+    count = count;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+/* EOF */
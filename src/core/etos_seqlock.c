@@ -0,0 +1,156 @@
+/******************************************************************************
+File    :  etos_seqlock.c
+
+This file is part of the ETOS distribution
+Copyright (c) 2026, ETOS Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+(version 2) as published by the Free Software Foundation. See
+the LICENSE file in the top-level directory for more details.
+
+Description:
+		sequence lock for multi-word state written by one context and read by many
+
+History:
+
+Date           Author       Notes
+----------     -------      -------------------------
+2026-10-19     deeve        Create
+
+*******************************************************************************/
+
+/******************************************************************************
+ *                                 Includes                                   *
+ ******************************************************************************/
+#include "etos_includes.h"
+
+/******************************************************************************
+ *                                 Defines                                    *
+ ******************************************************************************/
+
+/*
+ * the sequence must be changed before/after the state, single core only needs compiler barrier
+ */
+#define SEQLOCK_BARRIER()    __asm__ __volatile__ ("" : : : "memory")
+
+/******************************************************************************
+ *                                 Global Variables                           *
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                 Local Variables                            *
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                 Local Functions                            *
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                 Global Functions                           *
+ ******************************************************************************/
+
+/**
+ * init a seqlock.
+ *
+ * @param[in]    seqlock
+ *
+ * @return   none
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+void etos_seqlock_init(etos_seqlock_t *seqlock)
+{
+    seqlock->sequence = 0;
+}
+
+
+
+/**
+ * begin to update the protected state in disable interrupt context.
+ *
+ * @param[in]    seqlock
+ *
+ * @return   none
+ *
+ * @note       there must be only one writer, and no reader can interrupt the writer,
+ *             or the reader retries forever
+ * @see        etos_seqlock_write_end_idic()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+void etos_seqlock_write_begin_idic(etos_seqlock_t *seqlock)
+{
+    seqlock->sequence++;
+    SEQLOCK_BARRIER();
+}
+
+
+
+/**
+ * finish updating the protected state in disable interrupt context.
+ *
+ * @param[in]    seqlock
+ *
+ * @return   none
+ *
+ * @see        etos_seqlock_write_begin_idic()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+void etos_seqlock_write_end_idic(etos_seqlock_t *seqlock)
+{
+    SEQLOCK_BARRIER();
+    seqlock->sequence++;
+}
+
+
+
+/**
+ * begin to read the protected state.
+ * it can be called in task, ISR and disable interrupt context
+ *
+ * @param[in]    seqlock
+ *
+ * @return   sequence which is passed to etos_seqlock_read_retry()
+ *
+ * @see        etos_seqlock_read_retry()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+u32 etos_seqlock_read_begin(etos_seqlock_t *seqlock)
+{
+    u32 sequence = seqlock->sequence;
+
+    SEQLOCK_BARRIER();
+
+    return sequence;
+}
+
+
+
+/**
+ * check whether the state read is consistent.
+ *
+ * @param[in]    seqlock
+ * @param[in]    sequence    returned by etos_seqlock_read_begin()
+ *
+ * @return
+ * @retval TRUE    the writer updated the state during reading, read again
+ * @retval FALSE   the state read is consistent
+ *
+ * @note       do {seq = etos_seqlock_read_begin(l); read...} while (etos_seqlock_read_retry(l, seq));
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+BOOL etos_seqlock_read_retry(etos_seqlock_t *seqlock, u32 sequence)
+{
+    SEQLOCK_BARRIER();
+
+    /*odd: the reader interrupted the writer, it does not happen on single core unless the writer is preempted*/
+    return ((sequence & 1) || (seqlock->sequence != sequence)) ? TRUE : FALSE;
+}
+
+
+/* EOF */
@@ -18,6 +18,8 @@ Date           Author       Notes
 ----------     -------      -------------------------
 2014-11-2      deeve        Create
 2015-4-14      deeve        Add some comments
+2026-10-19     deeve        Index sleep block by base priority
+2026-10-19     deeve        Sleep on generic wait queue timeout
 
 *******************************************************************************/
 
@@ -38,14 +40,6 @@ Date           Author       Notes
  *                                 Local Variables                            *
  ******************************************************************************/
 
-#if 1
-static struct list_head _os_slp_ctrl_blk_head = {&_os_slp_ctrl_blk_head, &_os_slp_ctrl_blk_head};
-#else
-static LIST_HEAD(_os_slp_ctrl_blk_head);
-#endif
-
-static sleep_block_t _os_sleep_scb[ETOS_MAX_TASK_NUM];
-
 /******************************************************************************
  *                                 Local Functions                            *
  ******************************************************************************/
@@ -55,43 +49,6 @@ static sleep_block_t _os_sleep_scb[ETOS_MAX_TASK_NUM];
  ******************************************************************************/
 
 
-/**
- * update tick for sleep.
- * update tick for sleep in interrupt service routine
- *
- * @param[in]    current_tick
- *
- * @return   none
- *
- * @note   it is called in interrupt service routine
- * @authors    deeve
- * @date       2015/4/14
- */
-void etos_sleep_update_tick_in_isr(etos_tick current_tick)
-{
-    list_t *pt_entry, *pt_next;
-    sleep_block_t *pt_node;
-    list_t *pt_os_slp_ctrl_blk_head;
-
-    pt_os_slp_ctrl_blk_head = &_os_slp_ctrl_blk_head;
-    if (list_is_empty(pt_os_slp_ctrl_blk_head)) {
-        return;
-    }
-
-    list_for_each_safe(pt_entry, pt_next, pt_os_slp_ctrl_blk_head) {
-        pt_node = list_entry(pt_entry, sleep_block_t, list);
-        if (pt_node->wakeup_tick <= current_tick) {
-            /*remove it from sleep list*/
-            list_del_init(&pt_node->list);
-
-            /*make it can be rescheduled*/
-            etos_sched_resume_task_idic(pt_node->pt_os_task_tcb->task_handle, ETOS_TASK_PENDING_SLEEP);
-        }
-    }
-}
-
-
-
 /**
  * sleep some ticks.
  * sleep some ticks, it will cause task reschedule
@@ -108,43 +65,24 @@ void etos_sleep_update_tick_in_isr(etos_tick current_tick)
  */
 s32 etos_sleep_tick(u32 ticks)
 {
-    etos_task_handle task_handle;
-    u32 priority_id;
-    s32 ret = ETOS_RET_OK;
-    etos_tcb_t *pt_os_task_tcb_cur;
-    sleep_block_t *pt_os_sleep_scb;
+    s32 ret;
     etos_init_critical();
 
-    if (etos_intr_in_isr()) {
-        xlogf(LOG_MODULE_ETOS, "can not sleep in ISR\r\n");
-    }
-
-    task_handle = etos_sched_get_current_task();
-
     /*can not sleep in boot code*/
-    ASSERT(ETOS_TASK_HANDLE_IS_VALID(task_handle));
-
-    pt_os_task_tcb_cur = (etos_tcb_t *)task_handle;
-
-    priority_id = ETOS_MAX_PRIORITY_TASK_NUM - 1 - pt_os_task_tcb_cur->priority;
-    pt_os_sleep_scb = &_os_sleep_scb[priority_id];
-
-    pt_os_sleep_scb->pt_os_task_tcb = pt_os_task_tcb_cur;
-    pt_os_sleep_scb->sleep_ticks = ticks;
+    ASSERT(ETOS_TASK_HANDLE_IS_VALID(etos_sched_get_current_task()));
 
     etos_enter_critical();
 
-    pt_os_sleep_scb->wakeup_tick = etos_sched_get_tick() + ticks;
-    INIT_LIST_HEAD(&pt_os_sleep_scb->list);
-    list_add_tail(&pt_os_sleep_scb->list, &_os_slp_ctrl_blk_head); /*not sort them, just add to tail*/
+    /*sleep is a timeout wait without wait queue*/
+    ret = etos_waitq_pend_idic(NULL, ETOS_TASK_PENDING_SLEEP, ticks, 0, 0);
 
-    /*pending itself becasue of sleep*/
-    ret = etos_sched_pending_task(task_handle, ETOS_TASK_PENDING_SLEEP);
-    if (ret != ETOS_RET_OK) {
-        xlogf(LOG_MODULE_ETOS, "pending task for sleep fail:%d\r\n", ret);
+    etos_exit_critical();
+
+    if (ret == ETOS_RET_TIMEOUT) {
+        return ETOS_RET_OK;
     }
 
-    etos_exit_critical();
+    xlogf(LOG_MODULE_ETOS, "pending task for sleep fail:%d\r\n", ret);
 
     return ret;
 }
@@ -0,0 +1,435 @@
+/******************************************************************************
+File    :  etos_sporadic.c
+
+This file is part of the ETOS distribution
+Copyright (c) 2026, ETOS Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+(version 2) as published by the Free Software Foundation. See
+the LICENSE file in the top-level directory for more details.
+
+Description:
+		sporadic server for aperiodic task
+
+History:
+
+Date           Author       Notes
+----------     -------      -------------------------
+2026-10-19     deeve        Create
+
+*******************************************************************************/
+
+/******************************************************************************
+ *                                 Includes                                   *
+ ******************************************************************************/
+#include "etos_includes.h"
+
+/******************************************************************************
+ *                                 Defines                                    *
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                 Global Variables                           *
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                 Local Variables                            *
+ ******************************************************************************/
+
+#if (ETOS_SPORADIC_ENABLE)
+/*server control block, it is indexed by base priority_id of the task*/
+static etos_sporadic_scb_t _os_sporadic_scb[ETOS_MAX_TASK_NUM];
+
+/*one bit for one server, the same bit as base priority_id*/
+static u32 _os_sporadic_mask;
+#endif
+
+/******************************************************************************
+ *                                 Local Functions                            *
+ ******************************************************************************/
+
+#if (ETOS_SPORADIC_ENABLE)
+static etos_sporadic_scb_t *_etos_sporadic_get_scb(etos_task_handle task_handle)
+{
+    u32 priority_id;
+    etos_tcb_t *pt_os_task_tcb = (etos_tcb_t *)task_handle;
+
+    if (!ETOS_TASK_HANDLE_IS_VALID(task_handle)) {
+        return NULL;
+    }
+
+    priority_id = ETOS_MAX_PRIORITY_TASK_NUM - 1 - pt_os_task_tcb->base_priority;
+    if ((_os_sporadic_mask & (1 << priority_id))
+        && (_os_sporadic_scb[priority_id].pt_os_task_tcb == pt_os_task_tcb)) {
+        return &_os_sporadic_scb[priority_id];
+    }
+
+    return NULL;
+}
+
+
+/*post the replenishment of the capacity consumed since chunk start*/
+static void _etos_sporadic_post_chunk(etos_sporadic_scb_t *pt_scb)
+{
+    etos_sporadic_replenish_t *pt_replenish;
+
+    if (!pt_scb->chunk_open) {
+        return;
+    }
+
+    pt_scb->chunk_open = FALSE;
+
+    if (pt_scb->chunk_consumed == 0) {
+        return;
+    }
+
+    if (pt_scb->replenish_num < ETOS_SPORADIC_MAX_REPLENISH) {
+        pt_replenish = &pt_scb->replenish[pt_scb->replenish_num];
+        pt_replenish->replenish_tick = pt_scb->chunk_start + pt_scb->period;
+        pt_replenish->amount = pt_scb->chunk_consumed;
+        pt_scb->replenish_num++;
+    } else {
+        /*queue is full, merge it to the last one, it is replenished later but never earlier*/
+        pt_replenish = &pt_scb->replenish[ETOS_SPORADIC_MAX_REPLENISH - 1];
+        pt_replenish->replenish_tick = pt_scb->chunk_start + pt_scb->period;
+        pt_replenish->amount += pt_scb->chunk_consumed;
+    }
+
+    pt_scb->chunk_consumed = 0;
+}
+
+
+static void _etos_sporadic_demote(etos_sporadic_scb_t *pt_scb)
+{
+    u32 priority;
+    etos_tcb_t *pt_os_task_tcb = pt_scb->pt_os_task_tcb;
+
+    if (pt_scb->demoted) {
+        return;
+    }
+
+    for (priority = pt_scb->low_priority; priority < pt_os_task_tcb->base_priority; priority++) {
+        if (etos_task_priority_is_free_idic(priority, pt_os_task_tcb->task_handle)) {
+            if (etos_sched_change_priority_idic(pt_os_task_tcb->task_handle, priority) == ETOS_RET_OK) {
+                pt_scb->demoted = TRUE;
+            }
+            break;
+        }
+    }
+}
+
+
+static void _etos_sporadic_promote(etos_sporadic_scb_t *pt_scb)
+{
+    etos_tcb_t *pt_os_task_tcb = pt_scb->pt_os_task_tcb;
+
+    if (!pt_scb->demoted) {
+        return;
+    }
+
+    if (etos_sched_change_priority_idic(pt_os_task_tcb->task_handle, pt_os_task_tcb->base_priority) == ETOS_RET_OK) {
+        pt_scb->demoted = FALSE;
+    }
+}
+#endif
+
+/******************************************************************************
+ *                                 Global Functions                           *
+ ******************************************************************************/
+
+/**
+ * make a task sporadic server.
+ * the task runs at its base priority with capacity_ticks ticks in each period_ticks,
+ * it runs at low_priority once the capacity is exhausted until the capacity is replenished
+ *
+ * @param[in]    task_handle
+ * @param[in]    capacity_ticks    capacity C, must be less than period_ticks
+ * @param[in]    period_ticks      replenishment period T
+ * @param[in]    low_priority      background priority, the nearest free priority above it
+ *                                 is used if it is busy
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @note  capacity is accounted in tick, so the server is charged one tick whenever
+ *        it is interrupted by tick at high priority
+ * @see   etos_sporadic_clear()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_sporadic_set(etos_task_handle task_handle, u32 capacity_ticks, u32 period_ticks, u32 low_priority)
+{
+#if (ETOS_SPORADIC_ENABLE)
+    u32 priority_id;
+    etos_sporadic_scb_t *pt_scb;
+    etos_tcb_t *pt_os_task_tcb = (etos_tcb_t *)task_handle;
+    etos_init_critical();
+
+    if (!ETOS_TASK_HANDLE_IS_VALID(task_handle)
+        || (capacity_ticks == 0)
+        || (capacity_ticks >= period_ticks)
+        || (low_priority >= pt_os_task_tcb->base_priority)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    priority_id = ETOS_MAX_PRIORITY_TASK_NUM - 1 - pt_os_task_tcb->base_priority;
+    pt_scb = &_os_sporadic_scb[priority_id];
+
+    etos_enter_critical();
+
+    if (_etos_sporadic_get_scb(task_handle) == NULL) {
+        memset(pt_scb, 0, sizeof(etos_sporadic_scb_t));
+        pt_scb->pt_os_task_tcb = pt_os_task_tcb;
+        pt_scb->capacity = capacity_ticks;
+    } else if (pt_scb->capacity > capacity_ticks) {
+        pt_scb->capacity = capacity_ticks;
+    }
+
+    pt_scb->capacity_max = capacity_ticks;
+    pt_scb->period = period_ticks;
+    pt_scb->low_priority = low_priority;
+
+    _os_sporadic_mask |= (1 << priority_id);
+
+    etos_exit_critical();
+
+    return ETOS_RET_OK;
+#else
+    task_handle = task_handle;
+    capacity_ticks = capacity_ticks;
+    period_ticks = period_ticks;
+    low_priority = low_priority;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+
+/**
+ * make a sporadic server normal task.
+ * the task gets its base priority back
+ *
+ * @param[in]    task_handle
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @see   etos_sporadic_set()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_sporadic_clear(etos_task_handle task_handle)
+{
+    s32 ret;
+    etos_init_critical();
+
+    etos_enter_critical();
+    ret = etos_sporadic_clear_idic(task_handle);
+    etos_exit_critical();
+
+    return ret;
+}
+
+
+
+/**
+ * make a sporadic server normal task in disable interrupt context.
+ *
+ * @param[in]    task_handle
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @note  it is called when task is destroyed
+ * @see   etos_sporadic_clear()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_sporadic_clear_idic(etos_task_handle task_handle)
+{
+#if (ETOS_SPORADIC_ENABLE)
+    u32 priority_id;
+    etos_sporadic_scb_t *pt_scb;
+
+    pt_scb = _etos_sporadic_get_scb(task_handle);
+    if (pt_scb == NULL) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    _etos_sporadic_promote(pt_scb);
+
+    priority_id = ETOS_MAX_PRIORITY_TASK_NUM - 1 - pt_scb->pt_os_task_tcb->base_priority;
+    _os_sporadic_mask &= ~(1 << priority_id);
+    pt_scb->pt_os_task_tcb = NULL;
+
+    return ETOS_RET_OK;
+#else
+    task_handle = task_handle;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+
+/**
+ * get sporadic server statistics.
+ *
+ * @param[in]    task_handle
+ * @param[out]   capacity         remaining capacity, can be NULL
+ * @param[out]   exhausted_cnt    the count of capacity exhausted, can be NULL
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_sporadic_get_stat(etos_task_handle task_handle, u32 *capacity, u32 *exhausted_cnt)
+{
+#if (ETOS_SPORADIC_ENABLE)
+    etos_sporadic_scb_t *pt_scb;
+
+    pt_scb = _etos_sporadic_get_scb(task_handle);
+    if (pt_scb == NULL) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    if (capacity) {
+        *capacity = pt_scb->capacity;
+    }
+
+    if (exhausted_cnt) {
+        *exhausted_cnt = pt_scb->exhausted_cnt;
+    }
+
+    return ETOS_RET_OK;
+#else
+    task_handle = task_handle;
+    capacity = capacity;
+    exhausted_cnt = exhausted_cnt;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+
+/**
+ * update sporadic servers in interrupt service routine.
+ * charge the interrupted server one tick and replenish capacity
+ *
+ * @param[in]    task_handle      the interrupted task, it may be zero (boot code)
+ * @param[in]    current_tick
+ *
+ * @return   none
+ *
+ * @note  it is called in tick ISR before reschedule
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+void etos_sporadic_update_tick_in_isr(etos_task_handle task_handle, etos_tick current_tick)
+{
+#if (ETOS_SPORADIC_ENABLE)
+    u32 i, mask, priority_id;
+    etos_sporadic_scb_t *pt_scb;
+
+    if (_os_sporadic_mask == 0) {
+        return;
+    }
+
+    /*charge the interrupted server which runs at high priority*/
+    pt_scb = _etos_sporadic_get_scb(task_handle);
+    if (pt_scb && !pt_scb->demoted && (pt_scb->capacity > 0)) {
+        if (!pt_scb->chunk_open) {
+            /*it has run since last tick*/
+            pt_scb->chunk_open = TRUE;
+            pt_scb->chunk_start = current_tick - 1;
+            pt_scb->chunk_consumed = 0;
+        }
+
+        pt_scb->chunk_consumed++;
+        pt_scb->capacity--;
+
+        if (pt_scb->capacity == 0) {
+            _etos_sporadic_post_chunk(pt_scb);
+            pt_scb->exhausted_cnt++;
+            _etos_sporadic_demote(pt_scb);
+        }
+    }
+
+    /*replenish all servers*/
+    mask = _os_sporadic_mask;
+    while (mask) {
+        priority_id = etos_count_consecutive_0_in_lsb(mask);
+        mask &= ~(1 << priority_id);
+        pt_scb = &_os_sporadic_scb[priority_id];
+
+        while (pt_scb->replenish_num
+               && ((s32)(current_tick - pt_scb->replenish[0].replenish_tick) >= 0)) {
+            pt_scb->capacity += pt_scb->replenish[0].amount;
+            if (pt_scb->capacity > pt_scb->capacity_max) {
+                pt_scb->capacity = pt_scb->capacity_max;
+            }
+
+            pt_scb->replenish_num--;
+            for (i = 0; i < pt_scb->replenish_num; i++) {
+                pt_scb->replenish[i] = pt_scb->replenish[i + 1];
+            }
+        }
+
+        if (pt_scb->capacity > 0) {
+            _etos_sporadic_promote(pt_scb);
+        }
+    }
+#else
+    task_handle = task_handle;
+    current_tick = current_tick;
+#endif
+}
+
+
+
+/**
+ * sporadic server pending.
+ * the server blocks, post the replenishment of the capacity consumed
+ *
+ * @param[in]    task_handle      pending task
+ *
+ * @return
+ * @retval TRUE    the task is a sporadic server, its priority is managed by server
+ * @retval FALSE   normal task
+ *
+ * @note  it is called in disable interrupt context by etos_sched_pending_task()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+BOOL etos_sporadic_pending_idic(etos_task_handle task_handle)
+{
+#if (ETOS_SPORADIC_ENABLE)
+    etos_sporadic_scb_t *pt_scb;
+
+    pt_scb = _etos_sporadic_get_scb(task_handle);
+    if (pt_scb == NULL) {
+        return FALSE;
+    }
+
+    _etos_sporadic_post_chunk(pt_scb);
+
+    /*the demoted server keeps background priority until replenishment*/
+    if (pt_scb->capacity > 0) {
+        _etos_sporadic_promote(pt_scb);
+    }
+
+    return TRUE;
+#else
+    task_handle = task_handle;
+    return FALSE;
+#endif
+}
+
+
+/* EOF */
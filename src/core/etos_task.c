@@ -18,6 +18,15 @@ Date           Author       Notes
 ----------     -------      -------------------------
 2013-10-19     deeve        Create
 2015-4-15      deeve        Remove unnecessary code
+2026-10-19     deeve        Add execution budget and effective priority
+2026-10-19     deeve        Clear sporadic server when task is destroyed
+2026-10-19     deeve        Add priority swap for mutex priority inheritance
+2026-10-19     deeve        Init wait node of task
+2026-10-19     deeve        Init task notification value
+2026-10-19     deeve        Report task memory usage
+2026-10-19     deeve        Init ipc donation chain
+2026-10-19     deeve        Add etos_task_resume_suspended()
+2026-10-19     deeve        Count task stack to the new task, move memory usage of destroyed task to ISR account
 
 *******************************************************************************/
 
@@ -49,14 +58,22 @@ extern u32 g_os_sched_original_mask;    /*declared in etos_schedule.c*/
 /*
  * task priority mask, each priority occupy one bit
  * but priority 1 is in the bit 30
+ * the bit is set when a task runs at the priority (effective priority)
  */
 static u32 _os_task_priority_mask;
 
 
-/*task control block*/
+/*task control block, it is indexed by base priority_id*/
 static etos_tcb_t _os_task_tcb[ETOS_MAX_TASK_NUM];
 
 
+/* 按当前生效的优先级(priority_id)索引的task, 任务被降级或者提升优先级后，
+ * tcb的位置不变(task handle不变)，只是改变这里的绑定关系
+ */
+/*the task which runs at the priority_id*/
+static etos_tcb_t *_os_task_slot[ETOS_MAX_PRIORITY_TASK_NUM];
+
+
 /******************************************************************************
  *                                 Local Functions                            *
  ******************************************************************************/
@@ -97,6 +114,7 @@ s32 _add_task_by_tick(etos_tcb_t *pt_os_task_tcb, u32 schedule_tick, u32 bit_mas
 s32 etos_task_init(void)
 {
     _os_task_priority_mask = 0;
+    memset(_os_task_slot, 0, sizeof(_os_task_slot));
 
     return ETOS_RET_OK;
 }
@@ -122,6 +140,7 @@ s32 etos_task_deinit(void)
     _os_task_priority_mask = 0;
 
     memset(_os_task_tcb, 0, sizeof(_os_task_tcb));
+    memset(_os_task_slot, 0, sizeof(_os_task_slot));
 
     return ETOS_RET_OK;
 }
@@ -187,7 +206,7 @@ s32 etos_task_create(const char *task_name, u32 priority, void * (*task_entry)(v
     bit_mask = 1 << priority_id;
 
     /* had a task already */
-    if (bit_mask & _os_task_priority_mask) {
+    if (!etos_task_priority_is_free_idic(priority, 0)) {
         return ETOS_NOT_SUPPORT;
     }
 
@@ -203,10 +222,39 @@ s32 etos_task_create(const char *task_name, u32 priority, void * (*task_entry)(v
     pt_os_task_tcb->stack_len = stack_len;
 
     pt_os_task_tcb->priority = priority;
+    pt_os_task_tcb->base_priority = priority;
     pt_os_task_tcb->task_entry = task_entry;
     pt_os_task_tcb->arg = arg;
 
-    pt_os_task_tcb->task_handle = (etos_task_handle)pt_os_task_tcb;
+#if (ETOS_TASK_BUDGET_ENABLE)
+    pt_os_task_tcb->budget_ticks = 0;
+    pt_os_task_tcb->run_ticks = 0;
+    pt_os_task_tcb->overrun_cnt = 0;
+    pt_os_task_tcb->budget_action = ETOS_BUDGET_ACTION_NONE;
+    pt_os_task_tcb->demote_priority = 0;
+    pt_os_task_tcb->budget_hook = NULL;
+#endif
+
+#if (ETOS_MUTEX_ENABLE)
+    INIT_LIST_HEAD(&pt_os_task_tcb->mutex_held_list);
+    pt_os_task_tcb->mutex_boosted = FALSE;
+    pt_os_task_tcb->mutex_orig_priority = priority;
+#endif
+
+#if (ETOS_NOTIFY_ENABLE)
+    pt_os_task_tcb->notify_value = 0;
+    pt_os_task_tcb->notify_pending = FALSE;
+#endif
+
+#if (ETOS_IPC_ENABLE)
+    pt_os_task_tcb->ipc_donated = NULL;
+#endif
+
+    pt_os_task_tcb->wait_node.waitq = NULL;
+    pt_os_task_tcb->wait_node.pt_os_task_tcb = pt_os_task_tcb;
+    INIT_LIST_HEAD(&pt_os_task_tcb->wait_node.list);
+    INIT_LIST_HEAD(&pt_os_task_tcb->wait_node.timer_list);
+
     pt_os_task_tcb->task_state = ETOS_TASK_CREATED;
 
     if (task_name) {
@@ -220,12 +268,19 @@ s32 etos_task_create(const char *task_name, u32 priority, void * (*task_entry)(v
     etos_enter_critical();
 
     /* had a task already */
-    if (bit_mask & _os_task_priority_mask) {
+    if (!etos_task_priority_is_free_idic(priority, 0)) {
         free(pt_os_task_tcb->stack_begin_addr);
         etos_exit_critical();
         return ETOS_NOT_SUPPORT;
     }
 
+    pt_os_task_tcb->task_handle = (etos_task_handle)pt_os_task_tcb;
+#if (ETOS_MEM_ACCOUNT_ENABLE)
+    etos_mem_account_task_create_idic(pt_os_task_tcb->task_handle);
+    /*the stack is malloc-ed by the creator, count it to the new task*/
+    etos_mem_give_idic(pt_os_task_tcb->stack_begin_addr, pt_os_task_tcb->task_handle);
+#endif
+    _os_task_slot[priority_id] = pt_os_task_tcb;
     _os_task_priority_mask |= bit_mask;
     g_os_sched_original_mask |= bit_mask;
 
@@ -382,6 +437,11 @@ s32 etos_task_delete(etos_task_handle task_handle)
                 ((pt_os_task_tcb->stack_begin_addr + pt_os_task_tcb->stack_len)
                  == pt_os_task_tcb->register_stack_pointer)) {
                 pt_os_task_tcb->task_state = ETOS_TASK_INVALID;
+#if (ETOS_MEM_ACCOUNT_ENABLE)
+                etos_mem_account_task_destroy_idic(task_handle);
+#endif
+                pt_os_task_tcb->task_handle = 0;
+                _os_task_slot[priority_id] = NULL;
                 _os_task_priority_mask &= ~(1 << priority_id);
                 g_os_sched_original_mask &= ~(1 << priority_id);
                 ret = ETOS_RET_OK;
@@ -421,8 +481,11 @@ s32 etos_task_destroy_idic(etos_task_handle task_handle)
 
     if (ETOS_TASK_HANDLE_IS_VALID(task_handle)) {
         if (pt_os_task_tcb->priority < ETOS_MAX_PRIORITY_TASK_NUM) {
+            etos_sporadic_clear_idic(task_handle);
+
             priority_id = ETOS_MAX_PRIORITY_TASK_NUM - 1 - pt_os_task_tcb->priority;
 
+            _os_task_slot[priority_id] = NULL;
             _os_task_priority_mask &= ~(1 << priority_id);
             g_os_sched_original_mask &= ~(1 << priority_id);
 
@@ -431,6 +494,9 @@ s32 etos_task_destroy_idic(etos_task_handle task_handle)
             } else {
                 ASSERT(pt_os_task_tcb->stack_begin_addr);
             }
+#if (ETOS_MEM_ACCOUNT_ENABLE)
+            etos_mem_account_task_destroy_idic(task_handle);
+#endif
             memset(pt_os_task_tcb, 0, sizeof(etos_tcb_t));
             ret = ETOS_RET_OK;
         }
@@ -460,7 +526,7 @@ etos_tcb_t *etos_task_get_task(u32 priority_id)
     etos_tcb_t *ret = NULL;
 
     if (priority_id < ETOS_MAX_PRIORITY_TASK_NUM) {
-        ret = &_os_task_tcb[priority_id];
+        ret = _os_task_slot[priority_id];
     } else {
         ASSERT(priority_id < ETOS_MAX_PRIORITY_TASK_NUM);
     }
@@ -470,5 +536,339 @@ etos_tcb_t *etos_task_get_task(u32 priority_id)
 
 
 
+/**
+ * check priority is free.
+ * check whether a task can run at the priority, the priority is free if
+ * no task runs at it and it is not the base priority of another task
+ *
+ * @param[in]    priority
+ * @param[in]    task_handle    the task which wants to run at priority
+ *
+ * @return   TRUE or FALSE
+ *
+ * @note   it is called in disable interrupt context
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+BOOL etos_task_priority_is_free_idic(u32 priority, etos_task_handle task_handle)
+{
+    u32 priority_id;
+    etos_tcb_t *pt_os_task_tcb;
+
+    if (priority >= ETOS_MAX_PRIORITY_TASK_NUM) {
+        return FALSE;
+    }
+
+    priority_id = ETOS_MAX_PRIORITY_TASK_NUM - 1 - priority;
+
+    if (_os_task_priority_mask & (1 << priority_id)) {
+        return (_os_task_slot[priority_id] == (etos_tcb_t *)task_handle) ? TRUE : FALSE;
+    }
+
+    /*keep the base priority for the demoted task, it will come back*/
+    pt_os_task_tcb = &_os_task_tcb[priority_id];
+    if (ETOS_TASK_HANDLE_IS_VALID(pt_os_task_tcb->task_handle)
+        && (pt_os_task_tcb->task_handle != task_handle)) {
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+
+
+/**
+ * bind task to a new priority.
+ * change the effective priority of a task, the base priority is not changed
+ *
+ * @param[in]    task_handle
+ * @param[in]    new_priority   it must be free, see etos_task_priority_is_free_idic()
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @note   schedule mask is not changed, use etos_sched_change_priority_idic() instead
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_task_bind_priority_idic(etos_task_handle task_handle, u32 new_priority)
+{
+    u32 old_priority_id, new_priority_id;
+    etos_tcb_t *pt_os_task_tcb = (etos_tcb_t *)task_handle;
+
+    if (!ETOS_TASK_HANDLE_IS_VALID(task_handle) || (new_priority >= ETOS_MAX_PRIORITY_TASK_NUM)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    if (pt_os_task_tcb->priority == new_priority) {
+        return ETOS_RET_OK;
+    }
+
+    if (!etos_task_priority_is_free_idic(new_priority, task_handle)) {
+        return ETOS_NOT_SUPPORT;
+    }
+
+    old_priority_id = ETOS_MAX_PRIORITY_TASK_NUM - 1 - pt_os_task_tcb->priority;
+    new_priority_id = ETOS_MAX_PRIORITY_TASK_NUM - 1 - new_priority;
+
+    ASSERT(_os_task_slot[old_priority_id] == pt_os_task_tcb);
+
+    _os_task_slot[old_priority_id] = NULL;
+    _os_task_priority_mask &= ~(1 << old_priority_id);
+
+    _os_task_slot[new_priority_id] = pt_os_task_tcb;
+    _os_task_priority_mask |= (1 << new_priority_id);
+
+    pt_os_task_tcb->priority = new_priority;
+
+    return ETOS_RET_OK;
+}
+
+
+
+/**
+ * swap the priorities of two tasks.
+ * exchange the effective priorities of two tasks, the base priorities are not changed
+ *
+ * @param[in]    task_handle_a
+ * @param[in]    task_handle_b
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @note   schedule mask is not changed, use etos_sched_swap_priority_idic() instead
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_task_swap_priority_idic(etos_task_handle task_handle_a, etos_task_handle task_handle_b)
+{
+    u32 priority_id_a, priority_id_b, priority;
+    etos_tcb_t *pt_os_task_tcb_a = (etos_tcb_t *)task_handle_a;
+    etos_tcb_t *pt_os_task_tcb_b = (etos_tcb_t *)task_handle_b;
+
+    if (!ETOS_TASK_HANDLE_IS_VALID(task_handle_a) || !ETOS_TASK_HANDLE_IS_VALID(task_handle_b)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    if ((pt_os_task_tcb_a->priority >= ETOS_MAX_PRIORITY_TASK_NUM)
+        || (pt_os_task_tcb_b->priority >= ETOS_MAX_PRIORITY_TASK_NUM)) {
+        return ETOS_NOT_SUPPORT;
+    }
+
+    priority_id_a = ETOS_MAX_PRIORITY_TASK_NUM - 1 - pt_os_task_tcb_a->priority;
+    priority_id_b = ETOS_MAX_PRIORITY_TASK_NUM - 1 - pt_os_task_tcb_b->priority;
+
+    ASSERT(_os_task_slot[priority_id_a] == pt_os_task_tcb_a);
+    ASSERT(_os_task_slot[priority_id_b] == pt_os_task_tcb_b);
+
+    _os_task_slot[priority_id_a] = pt_os_task_tcb_b;
+    _os_task_slot[priority_id_b] = pt_os_task_tcb_a;
+
+    priority = pt_os_task_tcb_a->priority;
+    pt_os_task_tcb_a->priority = pt_os_task_tcb_b->priority;
+    pt_os_task_tcb_b->priority = priority;
+
+    return ETOS_RET_OK;
+}
+
+
+
+/**
+ * set task execution budget.
+ * the task can run at most budget_ticks ticks continuously after it is resumed,
+ * the tick interrupt takes the action when the task runs over its budget
+ *
+ * @param[in]    task_handle
+ * @param[in]    budget_ticks      0 means no budget
+ * @param[in]    action            ETOS_BUDGET_ACTION_XXX
+ * @param[in]    demote_priority   the lowest priority for ETOS_BUDGET_ACTION_DEMOTE,
+ *                                 the nearest free priority above it is used if it is busy
+ * @param[in]    hook              the hook for ETOS_BUDGET_ACTION_HOOK, it is called in ISR
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @note  the demoted task gets its priority back when it pending
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_task_set_budget(etos_task_handle task_handle, u32 budget_ticks, etos_budget_action_e action,
+                         u32 demote_priority, pfunc_budget_hook hook)
+{
+#if (ETOS_TASK_BUDGET_ENABLE)
+    etos_tcb_t *pt_os_task_tcb = (etos_tcb_t *)task_handle;
+    etos_init_critical();
+
+    if (!ETOS_TASK_HANDLE_IS_VALID(task_handle)
+        || (action > ETOS_BUDGET_ACTION_HOOK)
+        || ((action == ETOS_BUDGET_ACTION_DEMOTE) && (demote_priority >= pt_os_task_tcb->base_priority))
+        || ((action == ETOS_BUDGET_ACTION_HOOK) && (hook == NULL))) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    etos_enter_critical();
+    pt_os_task_tcb->budget_ticks = budget_ticks;
+    pt_os_task_tcb->budget_action = action;
+    pt_os_task_tcb->demote_priority = demote_priority;
+    pt_os_task_tcb->budget_hook = hook;
+    etos_exit_critical();
+
+    return ETOS_RET_OK;
+#else
+    task_handle = task_handle;
+    budget_ticks = budget_ticks;
+    action = action;
+    demote_priority = demote_priority;
+    hook = hook;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+
+/**
+ * get task budget statistics.
+ *
+ * @param[in]    task_handle
+ * @param[out]   run_ticks      ticks the task has run in current activation, can be NULL
+ * @param[out]   overrun_cnt    total overrun count, can be NULL
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_task_get_budget_stat(etos_task_handle task_handle, u32 *run_ticks, u32 *overrun_cnt)
+{
+#if (ETOS_TASK_BUDGET_ENABLE)
+    etos_tcb_t *pt_os_task_tcb = (etos_tcb_t *)task_handle;
+
+    if (!ETOS_TASK_HANDLE_IS_VALID(task_handle)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    if (run_ticks) {
+        *run_ticks = pt_os_task_tcb->run_ticks;
+    }
+
+    if (overrun_cnt) {
+        *overrun_cnt = pt_os_task_tcb->overrun_cnt;
+    }
+
+    return ETOS_RET_OK;
+#else
+    task_handle = task_handle;
+    run_ticks = run_ticks;
+    overrun_cnt = overrun_cnt;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+
+/**
+ * resume a task suspended by budget overrun.
+ * the task gets a new activation, so its budget is enforced again after it is resumed
+ *
+ * @param[in]    task_handle
+ *
+ * @return
+ * @retval 0                   success
+ * @retval ETOS_RET_BUSY       the task is not suspended
+ * @retval other               fail
+ *
+ * @see        etos_task_set_budget()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_task_resume_suspended(etos_task_handle task_handle)
+{
+#if (ETOS_TASK_BUDGET_ENABLE)
+    etos_tcb_t *pt_os_task_tcb = (etos_tcb_t *)task_handle;
+    etos_init_critical();
+
+    if (!ETOS_TASK_HANDLE_IS_VALID(task_handle)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    etos_enter_critical();
+
+    if (!(pt_os_task_tcb->task_state & ETOS_TASK_SUSPENDED)) {
+        etos_exit_critical();
+        return ETOS_RET_BUSY;
+    }
+
+    pt_os_task_tcb->run_ticks = 0;
+    etos_sched_resume_task_idic(task_handle, ETOS_TASK_SUSPENDED);
+
+    etos_exit_critical();
+
+    return ETOS_RET_OK;
+#else
+    task_handle = task_handle;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+
+/**
+ * report task statistics.
+ * print priority, state, budget and memory statistics of all tasks
+ *
+ * @param[in]    prompt   print header
+ *
+ * @return 0
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_task_report(const char *prompt)
+{
+    u32 i;
+    etos_tcb_t *pt_os_task_tcb;
+    const char *header;
+
+    if (prompt) {
+        header = prompt;
+    } else {
+        header = "etos task";
+    }
+
+    for (i = 0; i < ETOS_MAX_TASK_NUM; i++) {
+        pt_os_task_tcb = &_os_task_tcb[i];
+        if (!ETOS_TASK_HANDLE_IS_VALID(pt_os_task_tcb->task_handle)) {
+            continue;
+        }
+
+#if (ETOS_TASK_BUDGET_ENABLE)
+        xlogt(LOG_MODULE_ETOS, "%s: %-8s prio:%2d/%2d state:0x%03x budget:%d run:%d overrun:%d\r\n",
+              header, pt_os_task_tcb->task_name, pt_os_task_tcb->priority, pt_os_task_tcb->base_priority,
+              pt_os_task_tcb->task_state, pt_os_task_tcb->budget_ticks, pt_os_task_tcb->run_ticks,
+              pt_os_task_tcb->overrun_cnt);
+#else
+        xlogt(LOG_MODULE_ETOS, "%s: %-8s prio:%2d/%2d state:0x%03x\r\n",
+              header, pt_os_task_tcb->task_name, pt_os_task_tcb->priority, pt_os_task_tcb->base_priority,
+              pt_os_task_tcb->task_state);
+#endif
+
+#if (ETOS_MEM_ACCOUNT_ENABLE)
+        xlogt(LOG_MODULE_ETOS, "%s: %-8s mem live:%d peak:%d blocks:%d quota:%d quota_fail:%d\r\n",
+              header, pt_os_task_tcb->task_name, pt_os_task_tcb->mem_stat.live_bytes,
+              pt_os_task_tcb->mem_stat.peak_bytes, pt_os_task_tcb->mem_stat.block_num,
+              pt_os_task_tcb->mem_stat.quota_bytes, pt_os_task_tcb->mem_stat.quota_fail_cnt);
+#endif
+    }
+
+    return ETOS_RET_OK;
+}
+
+
+
 /* EOF */
 
@@ -0,0 +1,271 @@
+/******************************************************************************
+File    :  etos_trace.c
+
+This file is part of the ETOS distribution
+Copyright (c) 2026, ETOS Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+(version 2) as published by the Free Software Foundation. See
+the LICENSE file in the top-level directory for more details.
+
+Description:
+		binary trace ring buffer for ETOS kernel events
+
+History:
+
+Date           Author       Notes
+----------     -------      -------------------------
+2026-10-19     deeve        Create
+
+*******************************************************************************/
+
+/******************************************************************************
+ *                                 Includes                                   *
+ ******************************************************************************/
+#include "etos_includes.h"
+
+/******************************************************************************
+ *                                 Defines                                    *
+ ******************************************************************************/
+#define TRACE_RECORD_MASK      (ETOS_TRACE_RECORD_NUM - 1)
+
+/******************************************************************************
+ *                                 Global Variables                           *
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                 Local Variables                            *
+ ******************************************************************************/
+
+#if (ETOS_TRACE_ENABLE)
+static etos_trace_record_t _os_trace_records[ETOS_TRACE_RECORD_NUM];
+
+/*total records written, the write position is (_os_trace_write_cnt & TRACE_RECORD_MASK)*/
+static u32 _os_trace_write_cnt;
+
+static BOOL _os_trace_enabled = TRUE;
+#endif
+
+/******************************************************************************
+ *                                 Local Functions                            *
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                 Global Functions                           *
+ ******************************************************************************/
+
+/**
+ * enable or disable trace.
+ * the record is dropped silently when trace is disabled
+ *
+ * @param[in]    enable    TRUE or FALSE
+ *
+ * @return   none
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+void etos_trace_enable(BOOL enable)
+{
+#if (ETOS_TRACE_ENABLE)
+    _os_trace_enabled = enable;
+#else
+    enable = enable;
+#endif
+}
+
+
+
+/**
+ * clear trace ring buffer.
+ * reset write index and lost counter
+ *
+ * @param[in]    void
+ *
+ * @return   none
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+void etos_trace_reset(void)
+{
+#if (ETOS_TRACE_ENABLE)
+    etos_init_critical();
+
+    etos_enter_critical();
+    _os_trace_write_cnt = 0;
+    etos_exit_critical();
+#endif
+}
+
+
+
+/**
+ * get trace task id.
+ * convert a task handle to the task id which is saved in trace record
+ *
+ * @param[in]    task_handle
+ *
+ * @return   task base priority, or ETOS_TRACE_TASK_BOOT if task_handle is 0
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+u8 etos_trace_task_id(etos_task_handle task_handle)
+{
+    if (task_handle) {
+        return (u8)(((etos_tcb_t *)task_handle)->base_priority);
+    }
+
+    return ETOS_TRACE_TASK_BOOT;
+}
+
+
+
+/**
+ * record a trace event.
+ * write one record to trace ring buffer, the oldest record is overwritten
+ *
+ * @param[in]    event    ETOS_TRACE_EVT_XXX
+ * @param[in]    arg16    event argument
+ * @param[in]    arg      event argument
+ *
+ * @return   none
+ *
+ * @note  use ETOS_TRACE() instead of calling it directly
+ * @see   etos_trace_record_idic()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+void etos_trace_record(u8 event, u16 arg16, u32 arg)
+{
+#if (ETOS_TRACE_ENABLE)
+    etos_init_critical();
+
+    if (!_os_trace_enabled) {
+        return;
+    }
+
+    etos_enter_critical();
+    etos_trace_record_idic(event, arg16, arg);
+    etos_exit_critical();
+#endif
+}
+
+
+
+/**
+ * record a trace event in disable interrupt context.
+ * same as etos_trace_record(), but without critical section
+ *
+ * @param[in]    event    ETOS_TRACE_EVT_XXX
+ * @param[in]    arg16    event argument
+ * @param[in]    arg      event argument
+ *
+ * @return   none
+ *
+ * @note  use ETOS_TRACE_IDIC() instead of calling it directly
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+void etos_trace_record_idic(u8 event, u16 arg16, u32 arg)
+{
+#if (ETOS_TRACE_ENABLE)
+    register etos_trace_record_t *pt_record;
+
+    if (!_os_trace_enabled) {
+        return;
+    }
+
+    pt_record = &_os_trace_records[_os_trace_write_cnt & TRACE_RECORD_MASK];
+    _os_trace_write_cnt++;
+
+    pt_record->timestamp = etos_sched_get_timestamp();
+    pt_record->event = event;
+    pt_record->task_id = etos_trace_task_id(etos_sched_get_current_task());
+    pt_record->arg16 = arg16;
+    pt_record->arg = arg;
+#else
+    event = event;
+    arg16 = arg16;
+    arg = arg;
+#endif
+}
+
+
+
+/**
+ * dump trace ring buffer.
+ * print all records from the oldest one as hex text lines,
+ * tools/etos_trace2json.py converts the output to chrome trace json
+ *
+ * output format:
+ *     ETRC <version> <timestamp freq hz> <record num> <lost num>
+ *     ETN <task id> <task name>
+ *     ETR <timestamp> <event> <task id> <arg16> <arg>
+ *     ETRC END
+ *
+ * @param[in]    output_handle    gioi handle, eg: xlog_get_output_handle()
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @note  trace is paused during dump
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_trace_dump(u32 output_handle)
+{
+#if (ETOS_TRACE_ENABLE)
+    u32 i, write_cnt, record_num, lost_num;
+    BOOL enabled;
+    etos_tcb_t *pt_os_task_tcb;
+    etos_trace_record_t *pt_record;
+
+    if (output_handle == 0) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    enabled = _os_trace_enabled;
+    _os_trace_enabled = FALSE;
+
+    write_cnt = _os_trace_write_cnt;
+    if (write_cnt > ETOS_TRACE_RECORD_NUM) {
+        record_num = ETOS_TRACE_RECORD_NUM;
+        lost_num = write_cnt - ETOS_TRACE_RECORD_NUM;
+    } else {
+        record_num = write_cnt;
+        lost_num = 0;
+    }
+
+    printf(output_handle, "ETRC %d %u %u %u\r\n", ETOS_TRACE_VERSION,
+           etos_sched_get_timestamp_freq(), record_num, lost_num);
+
+    for (i = 0; i < ETOS_MAX_PRIORITY_TASK_NUM; i++) {
+        pt_os_task_tcb = etos_task_get_task(i);
+        if (pt_os_task_tcb && ETOS_TASK_HANDLE_IS_VALID(pt_os_task_tcb->task_handle)) {
+            printf(output_handle, "ETN %u %s\r\n", pt_os_task_tcb->base_priority, pt_os_task_tcb->task_name);
+        }
+    }
+
+    for (i = write_cnt - record_num; i != write_cnt; i++) {
+        pt_record = &_os_trace_records[i & TRACE_RECORD_MASK];
+        printf(output_handle, "ETR %08x %u %u %x %08x\r\n", pt_record->timestamp,
+               pt_record->event, pt_record->task_id, pt_record->arg16, pt_record->arg);
+    }
+
+    printf(output_handle, "ETRC END\r\n");
+
+    _os_trace_enabled = enabled;
+
+    return ETOS_RET_OK;
+#else
+    output_handle = output_handle;
+    return ETOS_NOT_SUPPORT;
+#endif
+}
+
+
+/* EOF */
@@ -0,0 +1,478 @@
+/******************************************************************************
+File    :  etos_waitq.c
+
+This file is part of the ETOS distribution
+Copyright (c) 2026, ETOS Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+(version 2) as published by the Free Software Foundation. See
+the LICENSE file in the top-level directory for more details.
+
+Description:
+		generic wait queue for all blocking objects
+
+History:
+
+Date           Author       Notes
+----------     -------      -------------------------
+2026-10-19     deeve        Create
+2026-10-19     deeve        Add etos_waitq_move_idic()
+
+*******************************************************************************/
+
+/******************************************************************************
+ *                                 Includes                                   *
+ ******************************************************************************/
+#include "etos_includes.h"
+
+/******************************************************************************
+ *                                 Defines                                    *
+ ******************************************************************************/
+
+/*tick a is before tick b, it works when tick wraps*/
+#define WAITQ_TICK_BEFORE(a, b)      ((s32)((a) - (b)) < 0)
+
+/******************************************************************************
+ *                                 Global Variables                           *
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                 Local Variables                            *
+ ******************************************************************************/
+
+/*all waiters with timeout, the earliest wakeup tick first*/
+static struct list_head _os_waitq_timer_head = {&_os_waitq_timer_head, &_os_waitq_timer_head};
+
+/******************************************************************************
+ *                                 Local Functions                            *
+ ******************************************************************************/
+
+/*higher priority first, FIFO in the same priority*/
+static void _etos_waitq_enqueue_idic(etos_waitq_t *waitq, etos_wait_node_t *pt_node)
+{
+    list_t *pt_entry;
+
+    list_for_each(pt_entry, &waitq->list) {
+        if (list_entry(pt_entry, etos_wait_node_t, list)->priority < pt_node->priority) {
+            break;
+        }
+    }
+
+    /*insert before pt_entry*/
+    list_add_tail(&pt_node->list, pt_entry);
+}
+
+
+static void _etos_waitq_start_timer_idic(etos_wait_node_t *pt_node, u32 ticks)
+{
+    list_t *pt_entry;
+
+    pt_node->wakeup_tick = etos_sched_get_tick() + ticks;
+
+    list_for_each(pt_entry, &_os_waitq_timer_head) {
+        if (WAITQ_TICK_BEFORE(pt_node->wakeup_tick,
+                              list_entry(pt_entry, etos_wait_node_t, timer_list)->wakeup_tick)) {
+            break;
+        }
+    }
+
+    list_add_tail(&pt_node->timer_list, pt_entry);
+}
+
+
+/*remove the node from wait queue and timeout list*/
+static void _etos_waitq_remove_idic(etos_wait_node_t *pt_node)
+{
+    if (!list_is_empty(&pt_node->timer_list)) {
+        list_del_init(&pt_node->timer_list);
+    }
+
+    if (pt_node->waitq) {
+        list_del_init(&pt_node->list);
+        pt_node->waitq = NULL;
+    }
+}
+
+/******************************************************************************
+ *                                 Global Functions                           *
+ ******************************************************************************/
+
+/**
+ * init a wait queue.
+ *
+ * @param[in]    waitq
+ * @param[in]    timeout_hook    called when a waiter times out, can be NULL
+ *
+ * @return   none
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+void etos_waitq_init(etos_waitq_t *waitq, pfunc_waitq_timeout timeout_hook)
+{
+    INIT_LIST_HEAD(&waitq->list);
+    waitq->timeout_hook = timeout_hook;
+}
+
+
+
+/**
+ * check whether any task is waiting in the queue.
+ *
+ * @param[in]    waitq
+ *
+ * @return   TRUE or FALSE
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+BOOL etos_waitq_is_empty(etos_waitq_t *waitq)
+{
+    return list_is_empty(&waitq->list);
+}
+
+
+
+/**
+ * queue current task on a wait queue in disable interrupt context.
+ * the task is queued by its current priority and the timeout starts, but it is not pended,
+ * it is used when the object needs to do something between queue and pend,
+ * eg: priority inheritance of mutex
+ *
+ * @param[in]    waitq            NULL: only wait timeout, eg: sleep
+ * @param[in]    reason           ETOS_TASK_PENDING_XXX
+ * @param[in]    timeout_ticks    ETOS_WAIT_FOREVER: no timeout
+ * @param[in]    wait_arg         object specific, saved in wait node
+ * @param[in]    wait_opt         object specific, saved in wait node
+ *
+ * @return   wait node of current task, NULL if it is not called in a task
+ *
+ * @note   etos_waitq_wait_idic() must be called after it without enabling interrupt
+ * @see    etos_waitq_wait_idic()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+etos_wait_node_t *etos_waitq_prepare_idic(etos_waitq_t *waitq, u32 reason, u32 timeout_ticks,
+                                          u32 wait_arg, u32 wait_opt)
+{
+    etos_task_handle task_handle;
+    etos_tcb_t *pt_os_task_tcb;
+    etos_wait_node_t *pt_node;
+
+    if (etos_intr_in_isr()) {
+        xlogf(LOG_MODULE_ETOS, "can not wait in ISR\r\n");
+    }
+
+    task_handle = etos_sched_get_current_task();
+
+    /*can not wait in boot code*/
+    if (!ETOS_TASK_HANDLE_IS_VALID(task_handle)) {
+        return NULL;
+    }
+
+    pt_os_task_tcb = (etos_tcb_t *)task_handle;
+    pt_node = &pt_os_task_tcb->wait_node;
+
+    pt_node->pt_os_task_tcb = pt_os_task_tcb;
+    pt_node->waitq = waitq;
+    pt_node->priority = pt_os_task_tcb->priority;
+    pt_node->reason = reason;
+    pt_node->result = ETOS_RET_FAIL;
+    pt_node->wait_arg = wait_arg;
+    pt_node->wait_opt = wait_opt;
+    pt_node->wake_value = 0;
+    INIT_LIST_HEAD(&pt_node->list);
+    INIT_LIST_HEAD(&pt_node->timer_list);
+
+    if (waitq) {
+        _etos_waitq_enqueue_idic(waitq, pt_node);
+    }
+
+    if (timeout_ticks != ETOS_WAIT_FOREVER) {
+        _etos_waitq_start_timer_idic(pt_node, timeout_ticks);
+    }
+
+    return pt_node;
+}
+
+
+
+/**
+ * pend current task which is queued by etos_waitq_prepare_idic().
+ *
+ * @param[in]    pt_node    returned by etos_waitq_prepare_idic()
+ *
+ * @return   wake result
+ * @retval ETOS_RET_TIMEOUT   timeout
+ * @retval other              the result given by waker
+ *
+ * @see    etos_waitq_prepare_idic()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_waitq_wait_idic(etos_wait_node_t *pt_node)
+{
+    s32 ret;
+
+    if (pt_node == NULL) {
+        return ETOS_NOT_SUPPORT;
+    }
+
+    /*it is resumed by waker or timeout*/
+    ret = etos_sched_pending_task(pt_node->pt_os_task_tcb->task_handle, (etos_task_state_e)pt_node->reason);
+    if (ret != ETOS_RET_OK) {
+        xlogf(LOG_MODULE_ETOS, "pending task fail:%d reason:0x%x\r\n", ret, pt_node->reason);
+        _etos_waitq_remove_idic(pt_node);
+        return ret;
+    }
+
+    return pt_node->result;
+}
+
+
+
+/**
+ * pend current task on a wait queue in disable interrupt context.
+ * the task is queued by its current priority and pended until it is woken up or timeout
+ *
+ * @param[in]    waitq            NULL: only wait timeout, eg: sleep
+ * @param[in]    reason           ETOS_TASK_PENDING_XXX
+ * @param[in]    timeout_ticks    ETOS_WAIT_FOREVER: no timeout
+ * @param[in]    wait_arg         object specific, saved in wait node
+ * @param[in]    wait_opt         object specific, saved in wait node
+ *
+ * @return   wake result
+ * @retval ETOS_RET_TIMEOUT   timeout
+ * @retval other              the result given by waker
+ *
+ * @note   it can not be called in ISR, etos_waitq_get_node() gets wake_value after it returns
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_waitq_pend_idic(etos_waitq_t *waitq, u32 reason, u32 timeout_ticks, u32 wait_arg, u32 wait_opt)
+{
+    return etos_waitq_wait_idic(etos_waitq_prepare_idic(waitq, reason, timeout_ticks, wait_arg, wait_opt));
+}
+
+
+
+/**
+ * get the wait node of a task.
+ *
+ * @param[in]    task_handle
+ *
+ * @return   wait node, NULL if the task handle is invalid
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+etos_wait_node_t *etos_waitq_get_node(etos_task_handle task_handle)
+{
+    if (!ETOS_TASK_HANDLE_IS_VALID(task_handle)) {
+        return NULL;
+    }
+
+    return &((etos_tcb_t *)task_handle)->wait_node;
+}
+
+
+
+/**
+ * get the highest priority waiter in disable interrupt context.
+ *
+ * @param[in]    waitq
+ *
+ * @return   wait node, NULL if there is no waiter
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+etos_wait_node_t *etos_waitq_peek_idic(etos_waitq_t *waitq)
+{
+    if (list_is_empty(&waitq->list)) {
+        return NULL;
+    }
+
+    return list_entry(waitq->list.next, etos_wait_node_t, list);
+}
+
+
+
+/**
+ * wake up a waiter in disable interrupt context.
+ * remove it from the wait queue and timeout list, then resume it
+ *
+ * @param[in]    pt_node      the waiter
+ * @param[in]    result       returned by etos_waitq_pend_idic()
+ * @param[in]    wake_value   object specific value for the waiter
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @note   it can be called in ISR
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_waitq_wake_node_idic(etos_wait_node_t *pt_node, s32 result, u32 wake_value)
+{
+    if ((pt_node == NULL) || (pt_node->pt_os_task_tcb == NULL)) {
+        return ETOS_INVALID_PARAM;
+    }
+
+    _etos_waitq_remove_idic(pt_node);
+
+    pt_node->result = result;
+    pt_node->wake_value = wake_value;
+
+    return etos_sched_resume_task_idic(pt_node->pt_os_task_tcb->task_handle, (etos_task_state_e)pt_node->reason);
+}
+
+
+
+/**
+ * wake up the highest priority waiter in disable interrupt context.
+ *
+ * @param[in]    waitq
+ * @param[in]    result       returned by etos_waitq_pend_idic()
+ * @param[in]    wake_value   object specific value for the waiter
+ *
+ * @return   the woken task, 0 if there is no waiter
+ *
+ * @note   it can be called in ISR
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+etos_task_handle etos_waitq_wake_one_idic(etos_waitq_t *waitq, s32 result, u32 wake_value)
+{
+    etos_wait_node_t *pt_node = etos_waitq_peek_idic(waitq);
+
+    if (pt_node == NULL) {
+        return 0;
+    }
+
+    etos_waitq_wake_node_idic(pt_node, result, wake_value);
+
+    return pt_node->pt_os_task_tcb->task_handle;
+}
+
+
+
+/**
+ * wake up all waiters in disable interrupt context.
+ *
+ * @param[in]    waitq
+ * @param[in]    result       returned by etos_waitq_pend_idic()
+ * @param[in]    wake_value   object specific value for the waiters
+ *
+ * @return   the number of woken tasks
+ *
+ * @note   it can be called in ISR
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+u32 etos_waitq_wake_all_idic(etos_waitq_t *waitq, s32 result, u32 wake_value)
+{
+    u32 num = 0;
+    etos_wait_node_t *pt_node;
+
+    while ((pt_node = etos_waitq_peek_idic(waitq)) != NULL) {
+        etos_waitq_wake_node_idic(pt_node, result, wake_value);
+        num++;
+    }
+
+    return num;
+}
+
+
+
+/**
+ * change the waiting priority of a waiter in disable interrupt context.
+ * the waiter is requeued by the new priority
+ *
+ * @param[in]    pt_node
+ * @param[in]    priority
+ *
+ * @return   none
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+void etos_waitq_requeue_idic(etos_wait_node_t *pt_node, u32 priority)
+{
+    pt_node->priority = priority;
+
+    if (pt_node->waitq) {
+        list_del_init(&pt_node->list);
+        _etos_waitq_enqueue_idic(pt_node->waitq, pt_node);
+    }
+}
+
+
+
+/**
+ * move a waiter to another wait queue in disable interrupt context.
+ * the task keeps pending and its timeout is not changed
+ *
+ * @param[in]    pt_node
+ * @param[in]    waitq      NULL: the waiter is not in any wait queue, it is only woken by etos_waitq_wake_node_idic()
+ *
+ * @return   none
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+void etos_waitq_move_idic(etos_wait_node_t *pt_node, etos_waitq_t *waitq)
+{
+    if (pt_node->waitq) {
+        list_del_init(&pt_node->list);
+    }
+
+    pt_node->waitq = waitq;
+
+    if (waitq) {
+        _etos_waitq_enqueue_idic(waitq, pt_node);
+    }
+}
+
+
+
+/**
+ * update tick for wait queue timeout in interrupt service routine.
+ * the waiters which time out are resumed with ETOS_RET_TIMEOUT
+ *
+ * @param[in]    current_tick
+ *
+ * @return   none
+ *
+ * @note   it is called in tick ISR
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+void etos_waitq_update_tick_in_isr(etos_tick current_tick)
+{
+    etos_waitq_t *waitq;
+    etos_wait_node_t *pt_node;
+
+    /*sorted by wakeup tick, only the expired nodes at head are visited*/
+    while (!list_is_empty(&_os_waitq_timer_head)) {
+        pt_node = list_entry(_os_waitq_timer_head.next, etos_wait_node_t, timer_list);
+        if (WAITQ_TICK_BEFORE(current_tick, pt_node->wakeup_tick)) {
+            break;
+        }
+
+        waitq = pt_node->waitq;
+        _etos_waitq_remove_idic(pt_node);
+        pt_node->result = ETOS_RET_TIMEOUT;
+
+        if (waitq && waitq->timeout_hook) {
+            waitq->timeout_hook(waitq, pt_node->pt_os_task_tcb);
+        }
+
+        etos_sched_resume_task_idic(pt_node->pt_os_task_tcb->task_handle, (etos_task_state_e)pt_node->reason);
+    }
+}
+
+
+/* EOF */
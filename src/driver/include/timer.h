@@ -17,6 +17,8 @@ History:
 Date           Author       Notes
 ----------     -------      -------------------------
 2015-3-14      deeve        Create
+2026-10-19     deeve        Add timer_hw_get_timestamp()
+2026-10-19     deeve        Add profiler sampling timer
 
 *******************************************************************************/
 #ifndef __TIMER_H__
@@ -162,6 +164,16 @@ s32 timer_hw_start_timer(u32 timer_no);
 
 s32 timer_hw_stop_timer(u32 timer_no);
 
+/*timer4 based free running timestamp, it is used as etos timestamp source*/
+u32 timer_hw_get_timestamp(void);
+
+u32 timer_hw_get_timestamp_freq(void);
+
+/*timer_no: 4 = sample in system tick, 0 = dedicated ~1ms timer*/
+s32 timer_hw_start_profiler(u32 timer_no);
+
+s32 timer_hw_stop_profiler(void);
+
 
 #endif  /* __TIMER_H__ */
 
@@ -17,6 +17,11 @@ History:
 Date           Author       Notes
 ----------     -------      -------------------------
 2015-3-14      deeve        Create
+2026-10-19     deeve        Add timer_hw_get_timestamp()
+2026-10-19     deeve        Support timer0 as profiler sampling timer
+2026-10-19     deeve        Read timestamp by tick seqlock without disable interrupt
+2026-10-19     deeve        Keep the monotonic check of timestamp in critical section
+2026-10-19     deeve        Owe the tick in timer4 ISR, read timestamp without disable interrupt
 
 *******************************************************************************/
 
@@ -33,8 +38,11 @@ Date           Author       Notes
 #define PRESCALER1_TIMER234         (250)
 
 
+#define TCFG1_MUX0_VALUE            (3)   /*1/16*/
 #define TCFG1_MUX4_VALUE            (3)   /*1/16*/
 /* ~25KHz*/
+#define TIMER0_COUNT_FREQ           (101250000 / (PRESCALER0_TIMER01 + 1) / 16)
+#define TIMER4_COUNT_FREQ           (101250000 / (PRESCALER1_TIMER234 + 1) / 16)
 
 #if 0
 #define TCNTB4_VALUE                (50000)
@@ -44,6 +52,11 @@ Date           Author       Notes
 /* ~16ms */
 #endif
 
+#define TCNTB0_VALUE                (25)
+/* ~1ms, it is only used by profiler */
+
+#define TIMER_NONE                  (0xff)
+
 /******************************************************************************
  *                                 Global Variables                           *
  ******************************************************************************/
@@ -57,6 +70,9 @@ static u32 _timer_intr_cnt;
 
 static u32 _timer_intr_flag;
 
+/*the timer which drives profiler*/
+static u32 _timer_prof_timer_no = TIMER_NONE;
+
 /******************************************************************************
  *                                 Local Functions                            *
  ******************************************************************************/
@@ -68,6 +84,10 @@ etos_isr_ret_e module_timer_isr_idic(u32 current_tick, void *arg)
 
     current_tick = current_tick;
 
+    if (timer_no == _timer_prof_timer_no) {
+        etos_prof_sample_in_isr();
+    }
+
     _timer_intr_cnt++;
 
     switch (timer_no) {
@@ -96,6 +116,8 @@ etos_isr_ret_e module_timer_isr_idic(u32 current_tick, void *arg)
                 }
             }
 #endif
+            /*the interrupt is cleared before the tick is updated, timestamp counts the owed tick*/
+            etos_sched_owe_tick_idic();
             ret = ETOS_ISR_RESCHEDULE_UPDATE_TICK | ETOS_ISR_RESCHEDULE_ENABLE;
             break;
         default:
@@ -143,7 +165,12 @@ s32 timer_hw_config_timer(u32 timer_no)
 
     switch (timer_no) {
         case 0:
-            ret = ETOS_NOT_SUPPORT;
+            REG_SET_FIELD(TCFG0, TCFG0_PRESCALER0_FROM, TCFG0_PRESCALER0_BITS, PRESCALER0_TIMER01);
+            REG_SET_FIELD(TCFG1, TCFG1_MUX0_FROM, TCFG1_MUX0_BITS, TCFG1_MUX0_VALUE);
+            REG_SET_FIELD(TCFG1, TCFG1_DMA_MODE_FROM, TCFG1_DMA_MODE_BITS, 0);
+            REG_SET_VALUE(TCNTB0, TCNTB0_VALUE);
+            REG_SET_VALUE(TCMPB0, 0);
+            ret = ETOS_RET_OK;
             break;
         case 1:
             ret = ETOS_NOT_SUPPORT;
@@ -176,7 +203,17 @@ s32 timer_hw_start_timer(u32 timer_no)
 
     switch (timer_no) {
         case 0:
-            ret = ETOS_NOT_SUPPORT;
+            REG_SET_BIT(TCON, TCON_TIMER0_MANUAL_UPDATE_BIT);
+            REG_CLR_BIT(TCON, TCON_TIMER0_OUTPUT_INVERTER_BIT);
+
+            ret = board_interrupt_register_intr_routine(INT_TIMER0_NO, module_timer_isr_idic, (void *)timer_no);
+            ret += interrupt_hw_clear_intr(INT_TIMER0_NO);
+            ret += interrupt_hw_unmask_intr(INT_TIMER0_NO);
+
+            REG_SET_BIT(TCON, TCON_TIMER0_START_BIT);
+            REG_CLR_BIT(TCON, TCON_TIMER0_MANUAL_UPDATE_BIT);
+            REG_SET_BIT(TCON, TCON_TIMER0_AUTO_RELOAD_BIT);
+
             break;
         case 1:
             ret = ETOS_NOT_SUPPORT;
@@ -208,6 +245,41 @@ s32 timer_hw_start_timer(u32 timer_no)
 }
 
 
+/*
+ * timestamp = tick * TCNTB4_VALUE + counted value in current tick
+ * the tick which timer4 ISR acknowledged but not added yet is owed, it is counted.
+ * if timer4 reloaded but the ISR does not run yet(interrupt pending), add one tick.
+ * tick, owed tick and count are read again if the tick is updated during reading,
+ * so interrupt is not disabled and timestamp does not go back
+ */
+u32 timer_hw_get_timestamp(void)
+{
+    u32 sequence, tick, owed, cnt;
+
+    do {
+        sequence = etos_sched_tick_read_begin();
+        tick = etos_sched_get_tick();
+        owed = etos_sched_get_owed_tick();
+        cnt = REG(TCNTO4);
+        if (owed) {
+            /*the pending bit, if it is not cleared yet, is the owed tick*/
+            tick += owed;
+        } else if (REG_GET_BIT(SRCPND, INTRCTL_INT_TIMER4_BIT)) {
+            tick++;
+            cnt = REG(TCNTO4);
+        }
+    } while (etos_sched_tick_read_retry(sequence));
+
+    return tick * TCNTB4_VALUE + (TCNTB4_VALUE - cnt);
+}
+
+
+u32 timer_hw_get_timestamp_freq(void)
+{
+    return TIMER4_COUNT_FREQ;
+}
+
+
 s32 timer_hw_stop_timer(u32 timer_no)
 {
     s32 ret = ETOS_INVALID_PARAM;
@@ -232,6 +304,57 @@ s32 timer_hw_stop_timer(u32 timer_no)
 }
 
 
+/*
+ * timer_no = 4: sample in system tick interrupt
+ * timer_no = 0: sample in a dedicated ~1ms timer interrupt
+ */
+s32 timer_hw_start_profiler(u32 timer_no)
+{
+    s32 ret;
+    u32 rate_hz;
+
+    if (_timer_prof_timer_no != TIMER_NONE) {
+        return ETOS_RET_FAIL;
+    }
+
+    switch (timer_no) {
+        case 0:
+            rate_hz = TIMER0_COUNT_FREQ / TCNTB0_VALUE;
+            ret = timer_hw_config_timer(0);
+            ret += timer_hw_start_timer(0);
+            break;
+        case 4:
+            rate_hz = TIMER4_COUNT_FREQ / TCNTB4_VALUE;
+            ret = ETOS_RET_OK;
+            break;
+        default:
+            return ETOS_NOT_SUPPORT;
+    }
+
+    if (ret == ETOS_RET_OK) {
+        ret = etos_prof_start(rate_hz);
+        _timer_prof_timer_no = timer_no;
+    }
+
+    return ret;
+}
+
+
+s32 timer_hw_stop_profiler(void)
+{
+    etos_prof_stop();
+
+    if (_timer_prof_timer_no == 0) {
+        interrupt_hw_mask_intr(INT_TIMER0_NO);
+        timer_hw_stop_timer(0);
+    }
+
+    _timer_prof_timer_no = TIMER_NONE;
+
+    return ETOS_RET_OK;
+}
+
+
 
 
 /* EOF */
@@ -17,6 +17,7 @@ History:
 Date           Author       Notes
 ----------     -------      -------------------------
 2015-2-25      deeve        Create
+2026-10-19     deeve        Use lock-free ring for rx buffer
 
 *******************************************************************************/
 
@@ -28,6 +29,8 @@ Date           Author       Notes
  *                                 Defines                                    *
  ******************************************************************************/
 
+#define UART_HW_RX_FIFO_SIZE    (64)
+
 /******************************************************************************
  *                                 Global Variables                           *
  ******************************************************************************/
@@ -47,9 +50,8 @@ static u32 _uart_tx_buf_write_id;
 static u32 _uart_tx_buf_free_len;
 static u32 _uart_tx_buf_read_id;
 
-static u32 _uart_rx_buf_write_id;
-static u32 _uart_rx_buf_received_len;
-static u32 _uart_rx_buf_read_id;
+/*rx ISR is the producer, the reader of gioi is the consumer*/
+static etos_ring_t _uart_rx_ring0;
 
 
 pfunc_rx_notifier uart_rx_nofier[UART_PORT_MAX];
@@ -84,9 +86,7 @@ s32 uart_open(u32 port)
         _uart_tx_buf_read_id = 0;
 
         memset(_uart_rx_buffer0, 0, sizeof(_uart_rx_buffer0));
-        _uart_rx_buf_write_id = 0;
-        _uart_rx_buf_read_id = 0;
-        _uart_rx_buf_received_len = 0;
+        etos_ring_init(&_uart_rx_ring0, _uart_rx_buffer0, UART_RX_BUF_SIZE);
 
         _uart_need_send_min_size = 64;
         _uart_need_send = FALSE;
@@ -385,7 +385,7 @@ s32 uart_rx_buf_length(u32 port, u32 *len)
 
     if (port == 0) {
         if (len) {
-            *len = _uart_rx_buf_received_len;
+            *len = etos_ring_count(&_uart_rx_ring0);
         }
         ret = ETOS_RET_OK;
     } else if (port == 1) {
@@ -418,18 +418,10 @@ s32 uart_reg_rx_notifier(u32 port, pfunc_rx_notifier rx_nfy)
 s32 uart_get_char(u32 port, u8 *ch)
 {
     s32 ret = ETOS_INVALID_PARAM;
-    etos_init_critical();
 
     if (port == 0) {
         if (ch) {
-            etos_enter_critical();
-            _uart_rx_buf_read_id = _uart_rx_buf_read_id % UART_RX_BUF_SIZE;
-            if (_uart_rx_buf_received_len) {
-                _uart_rx_buf_received_len--;
-                *ch = _uart_rx_buffer0[_uart_rx_buf_read_id];
-                _uart_rx_buf_read_id++;
-            }
-            etos_exit_critical();
+            etos_ring_get(&_uart_rx_ring0, ch, 1);
             ret = ETOS_RET_OK;
         }
     } else if (port == 1) {
@@ -444,35 +436,11 @@ s32 uart_get_char(u32 port, u8 *ch)
 
 u32 uart_get_bytes(u32 port, u8 *buf, u32 len)
 {
-    u32 recved_len, copy_len;
     u32 ret_send_len = 0;
-    etos_init_critical();
 
     if (port == 0) {
-        recved_len = _uart_rx_buf_received_len;
-        if (len <= recved_len) {
-            ret_send_len = len;
-
-            etos_enter_critical();
-
-            copy_len = UART_RX_BUF_SIZE - _uart_rx_buf_read_id;
-            if (copy_len >= len) {
-                memcpy(buf, &_uart_rx_buffer0[_uart_rx_buf_read_id], len);
-                _uart_rx_buf_read_id += len;
-            } else {
-                memcpy(buf, &_uart_rx_buffer0[_uart_rx_buf_read_id], copy_len);
-                buf += copy_len;
-                copy_len = len - copy_len;
-                memcpy(buf, &_uart_rx_buffer0[0], copy_len);
-                _uart_rx_buf_read_id = copy_len;
-            }
-
-            _uart_rx_buf_received_len -= len;
-
-            etos_exit_critical();
-        } else {
-            ASSERT(len <= recved_len);
-        }
+        ASSERT(len <= etos_ring_count(&_uart_rx_ring0));
+        ret_send_len = etos_ring_get(&_uart_rx_ring0, buf, len);
     } else if (port == 1) {
         ret_send_len = 0;
     } else if (port == 2) {
@@ -487,6 +455,8 @@ etos_isr_ret_e module_uart_isr_idic(u32 current_tick, void *arg)
 {
 
     u32 reg_val, data_len;
+    u32 space, rx_len, received_len;
+    u8 rx_fifo[UART_HW_RX_FIFO_SIZE];
     s32 all_ret_val = ETOS_RET_OK;
     u32 port = (u32)arg;
     gioi_rx_nfy_e rx_nfy_type = RX_NOTIFY_MAX;
@@ -530,40 +500,46 @@ etos_isr_ret_e module_uart_isr_idic(u32 current_tick, void *arg)
             /*save to rx buffer*/
             data_len = uart_hw_recved_cnt(PORT_0_UART_0);
 
-            if ((UART_RX_BUF_SIZE - _uart_rx_buf_received_len) < data_len) {
-                data_len = UART_RX_BUF_SIZE - _uart_rx_buf_received_len;
+            space = etos_ring_space(&_uart_rx_ring0);
+            if (space < data_len) {
+                data_len = space;
             }
 
             do {
-                while (data_len) {
-                    _uart_rx_buf_write_id = _uart_rx_buf_write_id % UART_RX_BUF_SIZE;
-                    _uart_rx_buf_received_len++;
-                    all_ret_val += uart_hw_recv_char(port, &_uart_rx_buffer0[_uart_rx_buf_write_id]);
-                    _uart_rx_buf_write_id++;
+                /*drain hw fifo to stack first, then publish to ring at once*/
+                rx_len = 0;
+                while (data_len && (rx_len < UART_HW_RX_FIFO_SIZE)) {
+                    all_ret_val += uart_hw_recv_char(port, &rx_fifo[rx_len]);
+                    rx_len++;
                     data_len--;
                     real_recved = TRUE;
                 }
 
+                etos_ring_put(&_uart_rx_ring0, rx_fifo, rx_len);
+
                 data_len = uart_hw_recved_cnt(PORT_0_UART_0);
 
-                if ((UART_RX_BUF_SIZE - _uart_rx_buf_received_len) < data_len) {
-                    data_len = UART_RX_BUF_SIZE - _uart_rx_buf_received_len;
+                space = etos_ring_space(&_uart_rx_ring0);
+                if (space < data_len) {
+                    data_len = space;
                 }
-            } while (data_len && (_uart_rx_buf_received_len != UART_RX_BUF_SIZE));
+            } while (data_len && space);
+
+            received_len = etos_ring_count(&_uart_rx_ring0);
 
             if (real_recved) {
                 rx_nfy_type = RX_LENGTH_UPDATE;
-                if ((_uart_rx_buf_received_len << 2) > (UART_RX_BUF_SIZE * 3)) {
-                    rx_nfy_type = CLOSE_TO_OVERFLOW;   /* _uart_rx_buf_received_len > (3/4 x UART_RX_BUF_SIZE) */
+                if ((received_len << 2) > (UART_RX_BUF_SIZE * 3)) {
+                    rx_nfy_type = CLOSE_TO_OVERFLOW;   /* received_len > (3/4 x UART_RX_BUF_SIZE) */
                 }
 
                 /*notify up layer*/
-                all_ret_val += uart_rx_nofier[0](PORT_0_UART_0, rx_nfy_type, _uart_rx_buf_received_len);
+                all_ret_val += uart_rx_nofier[0](PORT_0_UART_0, rx_nfy_type, received_len);
             } else {
                 /*rx timeout interrupt*/
-                if (_uart_rx_buf_received_len > 0) {
+                if (received_len > 0) {
                     /*notify up layer*/
-                    all_ret_val += uart_rx_nofier[0](PORT_0_UART_0, RX_LENGTH_UPDATE, _uart_rx_buf_received_len);
+                    all_ret_val += uart_rx_nofier[0](PORT_0_UART_0, RX_LENGTH_UPDATE, received_len);
                 }
                 xlogt(LOG_MODULE_DRV, "RXTM\r\n");
             }
@@ -0,0 +1,275 @@
+/******************************************************************************
+File    :  etos_actor.h
+
+This file is part of the ETOS distribution
+Copyright (c) 2026, ETOS Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+(version 2) as published by the Free Software Foundation. See
+the LICENSE file in the top-level directory for more details.
+
+Description:
+		actor, a task owning a message queue and a handler table
+		消息带类型头，actor的task循环接收消息并按type查表调用handler，
+		不再逐个比较字符串; request/response用correlation id对应
+
+History:
+
+Date           Author       Notes
+----------     -------      -------------------------
+2026-10-19     deeve        Create
+
+*******************************************************************************/
+#ifndef __ETOS_ACTOR_H__
+#define __ETOS_ACTOR_H__
+
+/******************************************************************************
+ *                                 Include Files                              *
+ ******************************************************************************/
+#include "etos_cfg.h"
+#include "etos_types.h"
+#include "etos_listop.h"
+#include "etos_msgq.h"
+
+/******************************************************************************
+ *                                 Macros/Defines/Structures                  *
+ ******************************************************************************/
+typedef u32 etos_actor_handle;
+
+
+#define ETOS_ACTOR_CHECK_FLAG          (0x20080808)
+
+
+/*header of every actor message, it is at the beginning of the message queue buffer*/
+typedef struct _etos_actor_msg {
+    u32               type;             /*index of the handler table of the receiver*/
+    u32               corr_id;          /*0: not a request, or id shared by a request and its response*/
+    etos_actor_handle reply_to;         /*0: no response, or the actor receiving the response*/
+    u32               len;              /*length of data*/
+    u8                data[0];
+} etos_actor_msg_t;
+
+
+typedef s32 (*pfunc_actor_handler)(etos_actor_handle actor_handle, etos_actor_msg_t *msg);
+
+
+/*an entry of handler table, the table is usually a const array indexed by message type*/
+typedef struct _etos_actor_handler {
+    pfunc_actor_handler handler;        /*NULL: the type is not handled*/
+    const char        *name;
+} etos_actor_handler_t;
+
+
+/*execution time is in timestamp unit (etos_sched_get_timestamp_freq())*/
+typedef struct _etos_actor_stat {
+    u32               call_cnt;
+    u32               max_time;
+    u32               avg_time;         /*running average, avg += (time - avg) / 8*/
+} etos_actor_stat_t;
+
+
+typedef struct _etos_actor {
+    list_t            list;             /*node of all actors list*/
+    etos_msg_handle   msg_handle;       /*queue owned by the actor*/
+    const etos_actor_handler_t *handlers;
+    u32               handler_num;
+    etos_actor_stat_t *stat;            /*handler_num entries, follow the actor in the same memory*/
+    u32               unknown_cnt;      /*messages without handler*/
+    char              name[ETOS_MAX_TASK_NAME_LEN];
+    u32               actor_check_flag;
+} etos_actor_t;
+
+
+/******************************************************************************
+ *                                 Declar Functions                           *
+ ******************************************************************************/
+
+/**
+ * create an actor.
+ * the message queue of the actor is created, the caller runs it in a task by etos_actor_run()
+ *
+ * @param[in]    name          actor name
+ * @param[in]    handlers      handler table indexed by message type, it must be kept valid
+ * @param[in]    handler_num   number of entries of handlers
+ * @param[out]   actor_handle  output handle for other actor API
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @see        etos_actor_destroy()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_actor_create(const char *name, const etos_actor_handler_t *handlers, u32 handler_num,
+                      etos_actor_handle *actor_handle);
+
+
+
+/**
+ * destroy an actor.
+ *
+ * @param[in]    actor_handle
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail, the actor task is waiting for message
+ *
+ * @see        etos_actor_create()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_actor_destroy(etos_actor_handle actor_handle);
+
+
+
+/**
+ * allocate a message for an actor.
+ *
+ * @param[in]    actor_handle    the receiver
+ * @param[in]    type            message type
+ * @param[in]    len             length of data
+ *
+ * @return   the message, NULL if it fails
+ *
+ * @note       it can be called in ISR
+ * @see        etos_actor_send()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+etos_actor_msg_t *etos_actor_alloc_msg(etos_actor_handle actor_handle, u32 type, u32 len);
+
+
+
+/**
+ * free a message which is not sent.
+ *
+ * @param[in]    actor_handle    the actor the message is allocated for
+ * @param[in]    msg
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @see        etos_actor_alloc_msg()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_actor_free_msg(etos_actor_handle actor_handle, etos_actor_msg_t *msg);
+
+
+
+/**
+ * send a message to an actor.
+ *
+ * @param[in]    actor_handle    the receiver
+ * @param[in]    msg             which is returned by etos_actor_alloc_msg()
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail, the caller still owns the message
+ *
+ * @note       it can be called in ISR
+ * @see        etos_actor_request()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_actor_send(etos_actor_handle actor_handle, etos_actor_msg_t *msg);
+
+
+
+/**
+ * send a request to an actor.
+ * the response comes to reply_to with the same correlation id
+ *
+ * @param[in]    actor_handle    the receiver
+ * @param[in]    msg             which is returned by etos_actor_alloc_msg()
+ * @param[in]    reply_to        the actor receiving the response
+ * @param[out]   corr_id         correlation id of the request, can be NULL
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail, the caller still owns the message
+ *
+ * @see        etos_actor_reply()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_actor_request(etos_actor_handle actor_handle, etos_actor_msg_t *msg, etos_actor_handle reply_to,
+                       u32 *corr_id);
+
+
+
+/**
+ * send the response of a request.
+ * it is called in the handler of the request
+ *
+ * @param[in]    request    the request being handled
+ * @param[in]    type       message type of the response
+ * @param[in]    data       response data, can be NULL
+ * @param[in]    len        length of data
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @see        etos_actor_request()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_actor_reply(etos_actor_msg_t *request, u32 type, const u8 *data, u32 len);
+
+
+
+/**
+ * run an actor.
+ * receive messages and call the handler of their type, it is the loop of the actor task
+ *
+ * @param[in]    actor_handle
+ *
+ * @return   it returns only when it fails
+ *
+ * @note       do not call this API in an interrupt context
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_actor_run(etos_actor_handle actor_handle);
+
+
+
+/**
+ * get handler statistics.
+ *
+ * @param[in]    actor_handle
+ * @param[in]    type            message type
+ * @param[out]   stat
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_actor_get_stat(etos_actor_handle actor_handle, u32 type, etos_actor_stat_t *stat);
+
+
+
+/**
+ * report actor statistics.
+ * print call count and execution time of every handler of all actors
+ *
+ * @param[in]    prompt   print header
+ *
+ * @return 0
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_actor_report(const char *prompt);
+
+
+#endif  /* __ETOS_ACTOR_H__ */
+
+/* EOF */
@@ -0,0 +1,276 @@
+/******************************************************************************
+File    :  etos_bus.h
+
+This file is part of the ETOS distribution
+Copyright (c) 2026, ETOS Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+(version 2) as published by the Free Software Foundation. See
+the LICENSE file in the top-level directory for more details.
+
+Description:
+		topic based publish/subscribe bus
+		publisher申请一个带引用计数的buffer，publish时只把buffer指针放入每个订阅者的
+		有界队列(不拷贝payload)，最后一个订阅者release时释放buffer;
+		订阅者队列满时丢弃并计数
+
+History:
+
+Date           Author       Notes
+----------     -------      -------------------------
+2026-10-19     deeve        Create
+
+*******************************************************************************/
+#ifndef __ETOS_BUS_H__
+#define __ETOS_BUS_H__
+
+/******************************************************************************
+ *                                 Include Files                              *
+ ******************************************************************************/
+#include "etos_cfg.h"
+#include "etos_types.h"
+#include "etos_listop.h"
+#include "etos_waitq.h"
+
+/******************************************************************************
+ *                                 Macros/Defines/Structures                  *
+ ******************************************************************************/
+typedef u32 etos_bus_sub_handle;
+
+
+#define ETOS_BUS_CHECK_FLAG            (0x19900520)
+
+
+/*topic IDs of kernel and drivers, 0 ~ (ETOS_BUS_MAX_TOPICS - 1)*/
+typedef enum _etos_bus_topic_e {
+    ETOS_BUS_TOPIC_UART_RX = 0,        /* a line received by uart, payload is '\0' terminated */
+    ETOS_BUS_TOPIC_USER,               /* first topic of application */
+} etos_bus_topic_e;
+
+
+typedef struct _etos_bus_buf {
+    u32               ref_cnt;          /*publisher and every subscriber queue holding it*/
+    u32               topic;
+    u32               len;
+    u32               bus_check_flag;
+    u8                data[0];
+} etos_bus_buf_t;
+
+
+typedef struct _etos_bus_stat {
+    u32               deliver_cnt;      /*messages put into the subscriber queue*/
+    u32               drop_cnt;         /*messages dropped because the queue is full*/
+    u32               max_depth;
+} etos_bus_stat_t;
+
+
+typedef struct _etos_bus_sub {
+    list_t            list;             /*node of all subscribers*/
+    u32               topic_mask;       /*bit n: subscribe topic n*/
+    etos_waitq_t      waitq;            /*tasks waiting for message*/
+    u32               queue_len;
+    u32               head;             /*free running, depth = head - tail, index = counter % queue_len*/
+    u32               tail;
+    etos_bus_stat_t   stat;
+    u32               bus_check_flag;
+    etos_bus_buf_t    *queue[0];        /*bounded queue of buffer reference*/
+} etos_bus_sub_t;
+
+
+/******************************************************************************
+ *                                 Declar Functions                           *
+ ******************************************************************************/
+
+/**
+ * create a bus subscriber.
+ *
+ * @param[in]    queue_len    max number of messages queued in the subscriber
+ * @param[out]   sub_handle   output handle for other bus API
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @see        etos_bus_sub_destroy()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_bus_sub_create(u32 queue_len, etos_bus_sub_handle *sub_handle);
+
+
+
+/**
+ * destroy a bus subscriber.
+ * all topics are unsubscribed and the queued messages are released
+ *
+ * @param[in]    sub_handle
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail, a task is waiting for message
+ *
+ * @see        etos_bus_sub_create()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_bus_sub_destroy(etos_bus_sub_handle sub_handle);
+
+
+
+/**
+ * subscribe a topic.
+ *
+ * @param[in]    sub_handle
+ * @param[in]    topic        0 ~ (ETOS_BUS_MAX_TOPICS - 1)
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @see        etos_bus_unsubscribe()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_bus_subscribe(etos_bus_sub_handle sub_handle, u32 topic);
+
+
+
+/**
+ * unsubscribe a topic.
+ * the messages of the topic queued already are still received
+ *
+ * @param[in]    sub_handle
+ * @param[in]    topic        0 ~ (ETOS_BUS_MAX_TOPICS - 1)
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @see        etos_bus_subscribe()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_bus_unsubscribe(etos_bus_sub_handle sub_handle, u32 topic);
+
+
+
+/**
+ * get a bus buffer.
+ * the publisher fills the buffer and publishes it
+ *
+ * @param[in]    len    payload length
+ *
+ * @return    the payload pointer
+ * @retval other   success
+ * @retval 0       fail
+ *
+ * @note       it can be called in ISR
+ * @see        etos_bus_publish()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+u8 *etos_bus_get_buf(u32 len);
+
+
+
+/**
+ * publish a bus buffer to all subscribers of the topic.
+ * the buffer reference is queued to every subscriber, the payload is not copied
+ *
+ * @param[in]    topic    0 ~ (ETOS_BUS_MAX_TOPICS - 1)
+ * @param[in]    buf      which is returned by etos_bus_get_buf()
+ *
+ * @return
+ * @retval 0       success, the buffer is owned by the bus even if no subscriber gets it
+ * @retval other   fail, the buffer is still owned by the caller
+ *
+ * @note       it can be called in ISR
+ * @see        etos_bus_recv()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_bus_publish(u32 topic, u8 *buf);
+
+
+
+/**
+ * publish a bus buffer in disable interrupt context.
+ *
+ * @param[in]    topic    0 ~ (ETOS_BUS_MAX_TOPICS - 1)
+ * @param[in]    buf      which is returned by etos_bus_get_buf()
+ *
+ * @return
+ * @retval 0       success, the buffer is owned by the bus even if no subscriber gets it
+ * @retval other   fail, the buffer is still owned by the caller
+ *
+ * @see        etos_bus_publish()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_bus_publish_idic(u32 topic, u8 *buf);
+
+
+
+/**
+ * receive a bus message.
+ * do not call this API in an interrupt context
+ *
+ * @param[in]    sub_handle
+ * @param[out]   topic            can be NULL
+ * @param[out]   buf_ptr          payload, it must be released by etos_bus_release_buf()
+ * @param[out]   len              payload length, can be NULL
+ * @param[in]    timeout_ticks    0: do not wait, ETOS_WAIT_FOREVER: wait until a message is published
+ *
+ * @return
+ * @retval 0                  success
+ * @retval ETOS_RET_BUSY      there is no message and timeout_ticks is 0
+ * @retval ETOS_RET_TIMEOUT   timeout
+ * @retval other              fail
+ *
+ * @see        etos_bus_publish()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_bus_recv(etos_bus_sub_handle sub_handle, u32 *topic, u8 **buf_ptr, u32 *len, u32 timeout_ticks);
+
+
+
+/**
+ * release a bus buffer.
+ * the buffer is freed when the last reference is released
+ *
+ * @param[in]    buf    which is received by etos_bus_recv()
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @note       it can be called in ISR
+ * @see        etos_bus_recv()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_bus_release_buf(u8 *buf);
+
+
+
+/**
+ * get subscriber statistics.
+ *
+ * @param[in]    sub_handle
+ * @param[out]   stat
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_bus_get_stat(etos_bus_sub_handle sub_handle, etos_bus_stat_t *stat);
+
+
+#endif  /* __ETOS_BUS_H__ */
+
+/* EOF */
@@ -43,6 +43,11 @@ Date           Author       Notes
 
 #define ETOS_MAX_TASK_NUM     ETOS_MAX_PRIORITY_TASK_NUM
 
+#define ETOS_TASK_BUDGET_ENABLE                  (1)  /*check task execution budget in tick interrupt*/
+
+#define ETOS_SPORADIC_ENABLE                     (1)  /*sporadic server scheduling*/
+#define ETOS_SPORADIC_MAX_REPLENISH              (4)  /*pending replenishments per server*/
+
 /* <--  ETOS TASK defines  <-- end*/
 
 
@@ -58,22 +63,123 @@ Date           Author       Notes
 
 /* -->  ETOS memory defines  --> start*/
 
+#define ETOS_MEM_ACCOUNT_ENABLE                  (1)  /*per task memory accounting and quota*/
+
+#define ETOS_MEM_BUDDY_ENABLE                    (1)  /*buddy pool for large buffers and used up block sizes*/
+#define ETOS_MEM_BUDDY_MIN_BLOCK_SIZE            (64) /*power of 2, including block header*/
+
 /* <--  ETOS memory defines  <-- end*/
 
 
 
+/* -->  ETOS mutex defines  --> start*/
+
+#define ETOS_MUTEX_ENABLE                        (1)  /*mutex with priority inheritance*/
+#define ETOS_MUTEX_MAX_NESTING                   (8)  /*max depth of priority inheritance chain*/
+
+/* <--  ETOS mutex defines  <-- end*/
+
+
+
+/* -->  ETOS semaphore defines  --> start*/
+
+#define ETOS_SEM_ENABLE                          (1)  /*counting and binary semaphore*/
+
+/* <--  ETOS semaphore defines  <-- end*/
+
+
+
+/* -->  ETOS event group defines  --> start*/
+
+#define ETOS_EVENT_ENABLE                        (1)  /*32 bits event flag group*/
+
+/* <--  ETOS event group defines  <-- end*/
+
+
+
 /* -->  ETOS message queue defines  --> start*/
 
+#define ETOS_MSGQ_PRIO_BANDS                      (4)   /*message priority 0 ~ (ETOS_MSGQ_PRIO_BANDS - 1), higher first*/
+
 /* <--  ETOS message queue defines  <-- end*/
 
 
 
+/* -->  ETOS queue set defines  --> start*/
+
+#define ETOS_QSET_ENABLE                         (1)  /*wait on multiple message queues and semaphores*/
+#define ETOS_QSET_MAX_MEMBERS                    (8)
+
+/* <--  ETOS queue set defines  <-- end*/
+
+
+
+/* -->  ETOS task notify defines  --> start*/
+
+#define ETOS_NOTIFY_ENABLE                       (1)  /*notification value in each task, no kernel object*/
+
+/* <--  ETOS task notify defines  <-- end*/
+
+
+
+/* -->  ETOS bus defines  --> start*/
+
+#define ETOS_BUS_ENABLE                          (1)  /*topic based publish/subscribe bus*/
+#define ETOS_BUS_MAX_TOPICS                      (32) /*do not let is larger than 32, topics of a subscriber is a u32 mask*/
+
+/* <--  ETOS bus defines  <-- end*/
+
+
+
+/* -->  ETOS actor defines  --> start*/
+
+#define ETOS_ACTOR_ENABLE                        (1)  /*actor task with typed message handler table*/
+
+/* <--  ETOS actor defines  <-- end*/
+
+
+
+/* -->  ETOS ipc defines  --> start*/
+
+#define ETOS_IPC_ENABLE                          (1)  /*synchronous send/receive/reply with priority donation*/
+
+/* <--  ETOS ipc defines  <-- end*/
+
+
+
+/* -->  ETOS ring defines  --> start*/
+
+#define ETOS_CACHE_LINE_SIZE                      (32)  /*arm920t data cache line, producer and consumer index are separated by it*/
+
+/* <--  ETOS ring defines  <-- end*/
+
+
+
 /* -->  ETOS hw op defines  --> start*/
 
 /* <--  ETOS hw op defines  <-- end*/
 
 
 
+/* -->  ETOS trace defines  --> start*/
+
+#define ETOS_TRACE_ENABLE                         (1)   /*binary scheduler trace ring buffer*/
+#define ETOS_TRACE_RECORD_NUM                     (1024) /*must be power of 2, 12 bytes per record*/
+
+#define ETOS_SCHED_VERBOSE_LOG                    (0)   /*xlogi in schedule path, very slow, only for debug*/
+
+/* <--  ETOS trace defines  <-- end*/
+
+
+/* -->  ETOS profiler defines  --> start*/
+
+#define ETOS_PROF_ENABLE                          (1)   /*statistical PC sampling profiler*/
+#define ETOS_PROF_SAMPLE_NUM                      (2048) /*5 bytes per sample, stop sampling when it is full*/
+
+/* <--  ETOS profiler defines  <-- end*/
+
+
+
 /* -->  ETOS random defines  --> start*/
 
 #define ETOS_RANDOM_USE_MORE_MEMORY               (0)
@@ -0,0 +1,215 @@
+/******************************************************************************
+File    :  etos_event.h
+
+This file is part of the ETOS distribution
+Copyright (c) 2026, ETOS Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+(version 2) as published by the Free Software Foundation. See
+the LICENSE file in the top-level directory for more details.
+
+Description:
+		32 bits event flag group
+		task可以同时等待多个条件(wait any / wait all)，set时一次唤醒所有满足条件的task
+
+History:
+
+Date           Author       Notes
+----------     -------      -------------------------
+2026-10-19     deeve        Create
+2026-10-19     deeve        Use generic wait queue
+
+*******************************************************************************/
+#ifndef __ETOS_EVENT_H__
+#define __ETOS_EVENT_H__
+
+/******************************************************************************
+ *                                 Include Files                              *
+ ******************************************************************************/
+#include "etos_cfg.h"
+#include "etos_types.h"
+#include "etos_listop.h"
+#include "etos_task.h"
+#include "etos_waitq.h"
+
+/******************************************************************************
+ *                                 Macros/Defines/Structures                  *
+ ******************************************************************************/
+typedef u32 etos_event_handle;
+
+
+#define ETOS_EVENT_CHECK_FLAG          (0x19920805)
+
+/*options of etos_event_wait()*/
+#define ETOS_EVENT_WAIT_ANY            (0x00)    /*any bit of wait_bits is set*/
+#define ETOS_EVENT_WAIT_ALL            (0x01)    /*all bits of wait_bits are set*/
+#define ETOS_EVENT_AUTO_CLEAR          (0x02)    /*clear wait_bits when the wait is satisfied*/
+
+
+typedef struct _etos_event {
+    etos_waitq_t      waitq;            /*wait_arg: wait bits, wait_opt: options, wake_value: matched bits*/
+    u32               bits;
+    u32               event_check_flag;
+} etos_event_t;
+
+
+/******************************************************************************
+ *                                 Declar Functions                           *
+ ******************************************************************************/
+
+/**
+ * create an event group.
+ *
+ * @param[in]    init_bits
+ * @param[out]   event_handle    output handle for other event API
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @see        etos_event_destroy()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_event_create(u32 init_bits, etos_event_handle *event_handle);
+
+
+
+/**
+ * destroy an event group.
+ *
+ * @param[in]    event_handle
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail, a task is waiting for the event group
+ *
+ * @see        etos_event_create()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_event_destroy(etos_event_handle event_handle);
+
+
+
+/**
+ * set event bits.
+ * all waiters satisfied by the new bits are woken up in one pass
+ *
+ * @param[in]    event_handle
+ * @param[in]    bits
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @see        etos_event_wait()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_event_set(etos_event_handle event_handle, u32 bits);
+
+
+
+/**
+ * set event bits in disable interrupt context.
+ * it can be called in ISR
+ *
+ * @param[in]    event_handle
+ * @param[in]    bits
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @note       the woken tasks run at next schedulable time
+ * @see        etos_event_set()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_event_set_idic(etos_event_handle event_handle, u32 bits);
+
+
+
+/**
+ * clear event bits.
+ *
+ * @param[in]    event_handle
+ * @param[in]    bits
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_event_clear(etos_event_handle event_handle, u32 bits);
+
+
+
+/**
+ * clear event bits in disable interrupt context.
+ * it can be called in ISR
+ *
+ * @param[in]    event_handle
+ * @param[in]    bits
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @see        etos_event_clear()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_event_clear_idic(etos_event_handle event_handle, u32 bits);
+
+
+
+/**
+ * wait event bits.
+ * the caller pends until the wait is satisfied or timeout
+ *
+ * @param[in]    event_handle
+ * @param[in]    wait_bits
+ * @param[in]    options          ETOS_EVENT_WAIT_ANY or ETOS_EVENT_WAIT_ALL, | ETOS_EVENT_AUTO_CLEAR
+ * @param[out]   matched_bits     event bits when the wait is satisfied (before auto clear), can be NULL
+ * @param[in]    timeout_ticks    0: do not wait, ETOS_WAIT_FOREVER: wait until it is satisfied
+ *
+ * @return
+ * @retval 0                  success
+ * @retval ETOS_RET_BUSY      not satisfied and timeout_ticks is 0
+ * @retval ETOS_RET_TIMEOUT   timeout
+ * @retval other              fail
+ *
+ * @note       do not call this API in an interrupt context
+ * @see        etos_event_set()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_event_wait(etos_event_handle event_handle, u32 wait_bits, u32 options,
+                    u32 *matched_bits, u32 timeout_ticks);
+
+
+
+/**
+ * get event bits.
+ *
+ * @param[in]    event_handle
+ * @param[out]   bits
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_event_get(etos_event_handle event_handle, u32 *bits);
+
+
+#endif  /* __ETOS_EVENT_H__ */
+
+/* EOF */
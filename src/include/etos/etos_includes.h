@@ -29,15 +29,29 @@ Date           Author       Notes
 #include "etos_types.h"
 #include "etos_listop.h"
 #include "etos_mem.h"
+#include "etos_waitq.h"
 #include "etos_task.h"
 #include "etos_schedule.h"
 #include "etos_interrupt.h"
 #include "etos_msgq.h"
+#include "etos_ring.h"
+#include "etos_seqlock.h"
+#include "etos_qset.h"
+#include "etos_bus.h"
+#include "etos_actor.h"
+#include "etos_ipc.h"
 #include "etos_sleep.h"
+#include "etos_sporadic.h"
+#include "etos_mutex.h"
+#include "etos_sem.h"
+#include "etos_event.h"
+#include "etos_notify.h"
 #include "etos_utility.h"
 #include "etos_hw_op.h"
 #include "etos_gioi_interface.h"
 #include "etos_random.h"
+#include "etos_trace.h"
+#include "etos_prof.h"
 #include "printf.h"
 #include "xlog.h"
 
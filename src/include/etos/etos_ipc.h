@@ -0,0 +1,179 @@
+/******************************************************************************
+File    :  etos_ipc.h
+
+This file is part of the ETOS distribution
+Copyright (c) 2026, ETOS Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+(version 2) as published by the Free Software Foundation. See
+the LICENSE file in the top-level directory for more details.
+
+Description:
+		synchronous send/receive/reply ipc
+		client调用etos_ipc_call()后阻塞，server receive时得到request的指针(不拷贝)，
+		服务期间server使用client的优先级，reply把response拷贝到client的buffer并唤醒client
+		server同时服务多个client时, donation按receive的顺序串联, 任意顺序reply都能还原优先级
+
+History:
+
+Date           Author       Notes
+----------     -------      -------------------------
+2026-10-19     deeve        Create
+2026-10-19     deeve        Unwind nested priority donation of a server
+
+*******************************************************************************/
+#ifndef __ETOS_IPC_H__
+#define __ETOS_IPC_H__
+
+/******************************************************************************
+ *                                 Include Files                              *
+ ******************************************************************************/
+#include "etos_cfg.h"
+#include "etos_types.h"
+#include "etos_waitq.h"
+
+/******************************************************************************
+ *                                 Macros/Defines/Structures                  *
+ ******************************************************************************/
+typedef u32 etos_ipc_handle;
+
+
+#define ETOS_IPC_CHECK_FLAG            (0x20010911)
+
+
+/*a call in progress, it is on the stack of the blocked client*/
+typedef struct _etos_ipc_call {
+    const void        *req;
+    u32               req_len;
+    void              *resp;
+    u32               resp_size;        /*size of resp buffer*/
+    u32               resp_len;         /*length written by reply*/
+    etos_task_handle  server;           /*0: not received yet*/
+    BOOL              donated;          /*the server runs at the priority of the client*/
+    etos_task_handle  client;
+    u32               client_priority;  /*priority of the client before donation*/
+    struct _etos_ipc_call *prev_donated;  /*call donated to the same server before this one*/
+} etos_ipc_call_t;
+
+
+typedef struct _etos_ipc {
+    etos_waitq_t      send_waitq;       /*clients not received yet, higher priority first*/
+    etos_waitq_t      recv_waitq;       /*servers waiting for client*/
+    u32               serving_cnt;      /*clients received but not replied*/
+    u32               ipc_check_flag;
+} etos_ipc_t;
+
+
+/******************************************************************************
+ *                                 Declar Functions                           *
+ ******************************************************************************/
+
+/**
+ * create an ipc channel.
+ *
+ * @param[out]   ipc_handle    output handle for other ipc API
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @see        etos_ipc_destroy()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_ipc_create(etos_ipc_handle *ipc_handle);
+
+
+
+/**
+ * destroy an ipc channel.
+ *
+ * @param[in]    ipc_handle
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail, a client or server is using the channel
+ *
+ * @see        etos_ipc_create()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_ipc_destroy(etos_ipc_handle ipc_handle);
+
+
+
+/**
+ * call the server of an ipc channel.
+ * the caller blocks until the server replies, the request is passed by reference
+ *
+ * @param[in]     ipc_handle
+ * @param[in]     req          request, it is read by server directly
+ * @param[in]     req_len
+ * @param[out]    resp         response buffer, can be NULL
+ * @param[inout]  resp_len     in: size of resp, out: length of response, can be NULL
+ *
+ * @return   the status given by etos_ipc_reply(), or fail code of call
+ *
+ * @note       do not call this API in an interrupt context, it has no timeout because
+ *             the server may be using the request
+ * @see        etos_ipc_receive()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_ipc_call(etos_ipc_handle ipc_handle, const void *req, u32 req_len, void *resp, u32 *resp_len);
+
+
+
+/**
+ * receive a call.
+ * the server runs at the priority of the client until it replies if the client is higher
+ *
+ * @param[in]    ipc_handle
+ * @param[out]   client           the client to reply
+ * @param[out]   req              request of the client
+ * @param[out]   req_len          can be NULL
+ * @param[in]    timeout_ticks    0: do not wait, ETOS_WAIT_FOREVER: wait until a client calls
+ *
+ * @return
+ * @retval 0                  success
+ * @retval ETOS_RET_BUSY      there is no client and timeout_ticks is 0
+ * @retval ETOS_RET_TIMEOUT   timeout
+ * @retval other              fail
+ *
+ * @note       do not call this API in an interrupt context
+ * @see        etos_ipc_reply()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_ipc_receive(etos_ipc_handle ipc_handle, etos_task_handle *client, const void **req, u32 *req_len,
+                     u32 timeout_ticks);
+
+
+
+/**
+ * reply a client.
+ * the response is copied to the buffer of the client, the client is resumed and
+ * the server gets its own priority back
+ *
+ * @param[in]    ipc_handle
+ * @param[in]    client      which is returned by etos_ipc_receive()
+ * @param[in]    status      returned by etos_ipc_call()
+ * @param[in]    resp        can be NULL
+ * @param[in]    resp_len    it is truncated to the size of client buffer
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail, the client is not received by the caller
+ *
+ * @see        etos_ipc_receive()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_ipc_reply(etos_ipc_handle ipc_handle, etos_task_handle client, s32 status, const void *resp,
+                   u32 resp_len);
+
+
+#endif  /* __ETOS_IPC_H__ */
+
+/* EOF */
@@ -18,6 +18,12 @@ Date           Author       Notes
 ----------     -------      -------------------------
 2013-10-19     deeve        Create
 2015-4-14      deeve        Add some comments
+2026-10-19     deeve        Limit block sizes to 32 for non-empty bitmap
+2026-10-19     deeve        Add per task memory accounting and quota
+2026-10-19     deeve        Add buddy memory pool
+2026-10-19     deeve        Add etos_mem_get_block_size()
+2026-10-19     deeve        Move memory usage of destroyed task to ISR account
+2026-10-19     deeve        Add etos_mem_buddy_select()
 
 *******************************************************************************/
 #ifndef __ETOS_MEM_H__
@@ -26,6 +32,8 @@ Date           Author       Notes
 /******************************************************************************
  *                                 Include Files                              *
  ******************************************************************************/
+#include "etos_cfg.h"
+#include "etos_types.h"
 #include "etos_listop.h"
 
 /******************************************************************************
@@ -46,6 +54,36 @@ typedef struct _mem_pool_item {
 } mem_pool_item_t;
 
 
+#define ETOS_MEM_OWNER_ISR       (0)   /*owner of blocks malloc-ed in ISR or boot code, or left by destroyed task*/
+
+
+/*memory usage of a task, in block size (not user length)*/
+typedef struct _etos_mem_stat {
+    u32 live_bytes;
+    u32 peak_bytes;
+    u32 block_num;
+    u32 quota_bytes;             /*0: no limit*/
+    u32 quota_fail_cnt;          /*malloc failed because of quota*/
+} etos_mem_stat_t;
+
+
+/*
+ * buddy pool statistics, the block size includes block header
+ * external fragmentation in percent = 100 - largest_free_bytes * 100 / free_bytes
+ */
+typedef struct _etos_mem_buddy_stat {
+    u32 total_bytes;
+    u32 free_bytes;
+    u32 min_free_bytes;
+    u32 largest_free_bytes;      /*the largest length can be malloc-ed is it minus block header*/
+    u32 used_block_num;
+    u32 waste_bytes;             /*internal fragmentation: block size - user length of used blocks*/
+    u32 split_cnt;
+    u32 merge_cnt;
+    u32 fail_cnt;
+} etos_mem_buddy_stat_t;
+
+
 /******************************************************************************
  *                                 Declar Functions                           *
  ******************************************************************************/
@@ -65,6 +103,7 @@ u32 etos_log_base_2(u32 n);
  * @retval 0                success
  * @retval other value      fail
  *
+ * @note   at most 32 block sizes
  * @authors    deeve
  * @date       2013/10/19
  */
@@ -110,6 +149,27 @@ s32 etos_mem_pool_add(u8 *mem_start, u8 *mem_end, u32 blk_size);
 
 
 
+/**
+ * init buddy memory pool.
+ * the memory is split and merged on demand, etos_mem_malloc() uses it when the length is
+ * larger than the largest block size, or the block size is used up
+ *
+ * @param[in]    mem_start    the start address of buddy memory
+ * @param[in]    mem_end      the end address of buddy memory
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @note   there is only one buddy region, it is shared by the block sizes selected by
+ *         etos_mem_buddy_select() and the fallback, the memory is freed by etos_mem_free()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_mem_buddy_init(u8 *mem_start, u8 *mem_end);
+
+
+
 /**
  * malloc a memory from memory pool.
  * just malloc a memory, it usage is same as malloc()
@@ -120,7 +180,7 @@ s32 etos_mem_pool_add(u8 *mem_start, u8 *mem_end, u32 blk_size);
  * @retval 0(NULL)        fail
  * @retval other value    success
  *
- * @note none
+ * @note   it fails when the memory quota of current task is used up, see etos_mem_set_quota()
  * @see        etos_mem_free()
  * @authors    deeve
  * @date       2013/10/19
@@ -139,7 +199,7 @@ void *etos_mem_malloc(u32 len);
  * @retval 0(NULL)        fail
  * @retval other value    success
  *
- * @note none
+ * @note   it fails when the memory quota of current context is used up
  * @see        etos_mem_malloc()
  * @authors    deeve
  * @date       2013/10/19
@@ -148,6 +208,45 @@ void *etos_mem_malloc_idic(u32 len);
 
 
 
+/**
+ * malloc a memory from buddy memory pool.
+ * the fixed block size pool is not used, eg: for large buffers and benchmark
+ *
+ * @param[in]    len   the length of memory
+ *
+ * @return
+ * @retval 0(NULL)        fail
+ * @retval other value    success
+ *
+ * @see        etos_mem_free()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+void *etos_mem_buddy_malloc(u32 len);
+
+
+
+/**
+ * select buddy pool for a block size of the fixed block size pool.
+ * etos_mem_malloc() of a length which uses blk_size block is taken from buddy pool first,
+ * the fixed blocks are the fallback, eg: for bursty lengths which the fixed count can not serve
+ *
+ * @param[in]    blk_size    block size given in pool items of etos_mem_pool_init()
+ * @param[in]    enable      TRUE: buddy pool first, FALSE: fixed blocks first
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @note   the selected blocks are freed by etos_mem_free() as well
+ * @see        etos_mem_buddy_init()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_mem_buddy_select(u32 blk_size, BOOL enable);
+
+
+
 /**
  * free the memory of ptr.
  * return the memory to the memory pool,the ptr is the return value of etos_mem_malloc()
@@ -187,6 +286,151 @@ s32 etos_mem_free_idic(void *ptr);
 
 
 
+/**
+ * get the block size of ptr.
+ * the size of the block which holds the memory, it is not less than the length of malloc
+ *
+ * @param[in]    ptr    the return value of etos_mem_malloc()
+ *
+ * @return   block size, 0 if ptr is NULL
+ *
+ * @note       the block size is counted by memory quota
+ * @see        etos_mem_malloc()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+u32 etos_mem_get_block_size(void *ptr);
+
+
+/**
+ * set memory quota of a task.
+ * etos_mem_malloc() fails when the task would use more than quota bytes of blocks
+ *
+ * @param[in]    task_handle    task, or ETOS_MEM_OWNER_ISR for ISR and boot code
+ * @param[in]    quota_bytes    0: no limit
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @note       the block size is counted, eg: malloc(100) uses 128 bytes
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_mem_set_quota(etos_task_handle task_handle, u32 quota_bytes);
+
+
+
+/**
+ * get memory usage of a task.
+ *
+ * @param[in]    task_handle    task, or ETOS_MEM_OWNER_ISR for ISR and boot code
+ * @param[out]   stat
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_mem_get_stat(etos_task_handle task_handle, etos_mem_stat_t *stat);
+
+
+
+/**
+ * give a memory to another task in disable interrupt context.
+ * the memory is counted to the new owner from now on
+ *
+ * @param[in]    ptr            the return value of etos_mem_malloc()
+ * @param[in]    task_handle    new owner, or ETOS_MEM_OWNER_ISR
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @note       quota of the new owner is not checked, it only fails its next malloc
+ * @see        etos_mem_take_idic()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_mem_give_idic(void *ptr, etos_task_handle task_handle);
+
+
+
+/**
+ * take a memory to current context in disable interrupt context.
+ * eg: receiver of a message buffer takes it
+ *
+ * @param[in]    ptr    the return value of etos_mem_malloc()
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @see        etos_mem_give_idic()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_mem_take_idic(void *ptr);
+
+
+
+/**
+ * start memory account of a new task in disable interrupt context.
+ * clear its statistics and give it a new owner id
+ *
+ * @param[in]    task_handle    the task just created
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @note       called by etos_task_create() after the task handle is valid
+ * @see        etos_mem_account_task_destroy_idic()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_mem_account_task_create_idic(etos_task_handle task_handle);
+
+
+
+/**
+ * end memory account of a task in disable interrupt context.
+ * the blocks which the task does not free are counted to ISR account
+ *
+ * @param[in]    task_handle    the task to be destroyed
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @note       called before the task handle is invalid, the blocks are uncharged from
+ *             ISR account when they are freed
+ * @see        etos_mem_account_task_create_idic()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_mem_account_task_destroy_idic(etos_task_handle task_handle);
+
+
+
+/**
+ * get statistics of buddy memory pool.
+ *
+ * @param[out]   stat
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_mem_buddy_get_stat(etos_mem_buddy_stat_t *stat);
+
+
+
 /**
  * report memory statistics.
  * print memory statistics for monitor memory usage
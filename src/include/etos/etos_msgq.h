@@ -18,6 +18,15 @@ Date           Author       Notes
 ----------     -------      -------------------------
 2013-10-20     deeve        Create
 2015-4-14      deeve        Add some comments
+2026-10-19     deeve        Receivers wait on generic wait queue
+2026-10-19     deeve        Add etos_msgq_recv_timeout()
+2026-10-19     deeve        Hand over message to one of multiple receivers
+2026-10-19     deeve        Add static message queue with buffer slab
+2026-10-19     deeve        Add message priority bands
+2026-10-19     deeve        Add batch receive and release
+2026-10-19     deeve        Notify queue set
+2026-10-19     deeve        Add depth, throughput and latency statistics
+2026-10-19     deeve        Add queue capacity and blocking send
 
 *******************************************************************************/
 #ifndef __ETOS_MSGQ_H__
@@ -27,6 +36,7 @@ Date           Author       Notes
  *                                 Include Files                              *
  ******************************************************************************/
 #include "etos_mem.h"
+#include "etos_waitq.h"
 
 /******************************************************************************
  *                                 Macros/Defines/Structures                  *
@@ -37,10 +47,50 @@ typedef u32 etos_msg_handle;
 
 #define ETOS_MSG_CHECK_FLAG          (0x19851123)
 
+#define ETOS_MSGQ_PRIO_NORMAL        (0)                           /*priority of etos_msgq_send()*/
+#define ETOS_MSGQ_PRIO_URGENT        (ETOS_MSGQ_PRIO_BANDS - 1)
+
+
+/*what a sender does when the queue reaches its capacity*/
+typedef enum _etos_msgq_full_policy_e {
+    ETOS_MSGQ_FULL_BLOCK = 0,          /* task sender waits, ISR sender gets ETOS_RET_FULL */
+    ETOS_MSGQ_FULL_DROP_OLDEST,        /* drop the oldest message of the lowest band and send */
+} etos_msgq_full_policy_e;
+
+
+/*
+ * latency is from send to receive in timestamp unit (etos_sched_get_timestamp_freq()),
+ * a message handed over to a waiting receiver is measured when the receiver runs
+ */
+typedef struct _etos_msgq_stat {
+    u32               band_depth[ETOS_MSGQ_PRIO_BANDS];      /*messages queued in each priority band*/
+    u32               band_max_depth[ETOS_MSGQ_PRIO_BANDS];
+    u32               depth;            /*messages queued in all bands*/
+    u32               max_depth;        /*high watermark of depth*/
+    u32               sent_cnt;
+    u32               recv_cnt;
+    u32               latency_min;
+    u32               latency_max;
+    u32               latency_avg;      /*running average, avg += (latency - avg) / 8*/
+    u32               reject_cnt;       /*send failed because the queue is full*/
+    u32               drop_cnt;         /*queued messages dropped by ETOS_MSGQ_FULL_DROP_OLDEST*/
+} etos_msgq_stat_t;
+
+
 typedef struct _etos_msgq_head {
-    list_t            list;
+    list_t            list;             /*node of all message queues list*/
+    list_t            msg_list[ETOS_MSGQ_PRIO_BANDS];        /*FIFO of each priority band*/
     etos_msg_type     msg_type;
-    etos_task_handle  recv_task;
+    etos_waitq_t      recv_waitq;       /*receivers, each message is handed over to the highest one*/
+    etos_waitq_t      send_waitq;       /*senders waiting for room*/
+    u32               capacity;         /*0: unbounded, or max queued messages*/
+    u32               full_policy;      /*etos_msgq_full_policy_e*/
+    list_t            free_list;        /*free buffers in slab of static queue*/
+    u32               msg_size;         /*0: buffers are malloc-ed, or max message length of static queue*/
+    u32               msg_count;        /*buffer number in slab*/
+    u32               free_cnt;
+    etos_msgq_stat_t  stat;
+    struct _etos_qset *qset;            /*queue set it belongs to, can be NULL*/
     u32               msg_check_flag;
 } etos_msgq_head_t;
 
@@ -48,6 +98,8 @@ typedef struct _etos_msgq_head {
 typedef struct _etos_msgq_buf {
     list_t            list;
     etos_task_handle  send_task;
+    etos_msgq_head_t  *slab_head;    /*NULL: malloc-ed buffer, or the static queue which owns it*/
+    u32               send_timestamp;
     u32               msg_check_flag;
     u8                msg_data[0];   /*msg content*/
 } etos_msgq_buf_t;
@@ -78,6 +130,30 @@ s32 etos_msgq_create(etos_msg_type msg_type, etos_msg_handle *msg_handle);
 
 
 
+/**
+ * create a static message queue.
+ * all buffers are preallocated in a slab with the queue, etos_msgq_get_buf() and
+ * etos_msgq_release_buf() just pop and push the free list
+ *
+ * @param[in]    msg_type
+ * @param[in]    msg_size    max length of a message
+ * @param[in]    msg_count   number of buffers
+ * @param[out]   msg_handle  output handle for other message queue API
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @note       a buffer got from a static queue can be sent to another queue,
+ *             it goes back to its own slab when it is released
+ * @see        etos_msgq_destroy()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_msgq_create_static(etos_msg_type msg_type, u32 msg_size, u32 msg_count, etos_msg_handle *msg_handle);
+
+
+
 /**
  * destroy a message queue.
  * destroy a message queue which is created by etos_msgq_create
@@ -86,7 +162,7 @@ s32 etos_msgq_create(etos_msg_type msg_type, etos_msg_handle *msg_handle);
  *
  * @return
  * @retval 0       success
- * @retval other   fail
+ * @retval other   fail, a task is waiting for message or it is in a queue set
  *
  * @note none
  * @see        etos_msgq_create()
@@ -159,6 +235,52 @@ s32 etos_msgq_send(etos_msg_handle msg_handle, u8 *msg_buf);
 
 
 
+/**
+ * send a message queue buffer with priority.
+ * send a message queue buffer to the task which is wait to receive massge queue
+ *
+ * @param[in]    msg_handle
+ * @param[in]    msg_buf      which is returned by etos_msgq_get_buf()
+ * @param[in]    prio         0 ~ (ETOS_MSGQ_PRIO_BANDS - 1), higher priority message is received first
+ *
+ * @return
+ * @retval 0               success
+ * @retval ETOS_RET_FULL   the queue is full and it is called in ISR
+ * @retval other           fail
+ *
+ * @note       messages in the same priority are FIFO, a task waits for room when the queue is full
+ * @see        etos_msgq_recv()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_msgq_send_prio(etos_msg_handle msg_handle, u8 *msg_buf, u32 prio);
+
+
+
+/**
+ * send a message queue buffer with priority and timeout.
+ * the caller waits for room when the queue is full
+ *
+ * @param[in]    msg_handle
+ * @param[in]    msg_buf          which is returned by etos_msgq_get_buf()
+ * @param[in]    prio             0 ~ (ETOS_MSGQ_PRIO_BANDS - 1), higher priority message is received first
+ * @param[in]    timeout_ticks    0: do not wait, ETOS_WAIT_FOREVER: wait until there is room
+ *
+ * @return
+ * @retval 0                  success
+ * @retval ETOS_RET_FULL      the queue is full and timeout_ticks is 0 or it is called in ISR
+ * @retval ETOS_RET_TIMEOUT   timeout
+ * @retval other              fail
+ *
+ * @note       the caller still owns the buffer when it fails
+ * @see        etos_msgq_set_capacity()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_msgq_send_timeout(etos_msg_handle msg_handle, u8 *msg_buf, u32 prio, u32 timeout_ticks);
+
+
+
 /**
  * send a message queue buffer.
  * send a message queue buffer to the task which is wait to receive massge queue
@@ -180,6 +302,26 @@ s32 etos_msgq_send_idic(etos_msg_handle msg_handle, u8 *msg_buf);
 
 
 
+/**
+ * send a message queue buffer with priority in disable interrupt context.
+ *
+ * @param[in]    msg_handle
+ * @param[in]    msg_buf      which is returned by etos_msgq_get_buf()
+ * @param[in]    prio         0 ~ (ETOS_MSGQ_PRIO_BANDS - 1), higher priority message is received first
+ *
+ * @return
+ * @retval 0               success
+ * @retval ETOS_RET_FULL   the queue is full
+ * @retval other           fail
+ *
+ * @see        etos_msgq_send_prio()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_msgq_send_prio_idic(etos_msg_handle msg_handle, u8 *msg_buf, u32 prio);
+
+
+
 /**
  * receive a message queue buffer.
  * receive a message queue buffer, maybe it will cause task reschedule when
@@ -203,6 +345,31 @@ s32 etos_msgq_recv(etos_msg_handle msg_handle, u8 **msg_buf_ptr, etos_task_handl
 
 
 
+/**
+ * receive a message queue buffer with timeout.
+ * the caller pends until a message queue buffer is sent or timeout
+ * do not call this API in an interrupt context
+ *
+ * @param[in]    msg_handle
+ * @param[out]   msg_buf_ptr       output message queue buffer, NULL if it fails
+ * @param[out]   send_task         output send message queue buffer task
+ * @param[in]    timeout_ticks     0: do not wait, ETOS_WAIT_FOREVER: wait until a message is sent
+ *
+ * @return
+ * @retval 0                  success
+ * @retval ETOS_RET_BUSY      there is no message and timeout_ticks is 0
+ * @retval ETOS_RET_TIMEOUT   timeout
+ * @retval other              fail
+ *
+ * @see        etos_msgq_send()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_msgq_recv_timeout(etos_msg_handle msg_handle, u8 **msg_buf_ptr, etos_task_handle *send_task,
+                           u32 timeout_ticks);
+
+
+
 /**
  * receive a message queue buffer.
  * receive a message queue buffer, it won't be blocking when
@@ -226,6 +393,119 @@ s32 etos_msgq_recv_no_block(etos_msg_handle msg_handle, u8 **msg_buf_ptr, etos_t
 
 
 
+/**
+ * receive a batch of message queue buffers.
+ * the caller pends until there is a message, then all queued messages (at most max_num)
+ * are drained in one critical section
+ * do not call this API in an interrupt context
+ *
+ * @param[in]    msg_handle
+ * @param[out]   msg_bufs       output message queue buffers, higher priority first
+ * @param[in]    max_num        size of msg_bufs
+ * @param[out]   recv_num       number of received buffers
+ *
+ * @return
+ * @retval 0       success, recv_num is at least 1
+ * @retval other   fail
+ *
+ * @see        etos_msgq_release_buf_batch()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_msgq_recv_batch(etos_msg_handle msg_handle, u8 *msg_bufs[], u32 max_num, u32 *recv_num);
+
+
+
+/**
+ * release a batch of buffers.
+ * release message queue buffers got from etos_msgq_recv_batch() in one critical section
+ *
+ * @param[in]    msg_handle
+ * @param[in]    msg_bufs
+ * @param[in]    num
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail, the buffers before the invalid one are released
+ *
+ * @see        etos_msgq_recv_batch()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_msgq_release_buf_batch(etos_msg_handle msg_handle, u8 *msg_bufs[], u32 num);
+
+
+
+/**
+ * get message queue statistics.
+ *
+ * @param[in]    msg_handle
+ * @param[out]   stat
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_msgq_get_stat(etos_msg_handle msg_handle, etos_msgq_stat_t *stat);
+
+
+
+/**
+ * set the capacity of a message queue.
+ *
+ * @param[in]    msg_handle
+ * @param[in]    capacity       0: unbounded, or max queued messages
+ * @param[in]    full_policy    etos_msgq_full_policy_e
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @note       messages handed over to a waiting receiver are not queued, they are not counted
+ * @see        etos_msgq_send_timeout()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_msgq_set_capacity(etos_msg_handle msg_handle, u32 capacity, u32 full_policy);
+
+
+
+/**
+ * enumerate all message queues.
+ *
+ * @param[in]    msg_handle    0: get the first queue, or the queue got last time
+ *
+ * @return   the next message queue
+ * @retval 0       there is no more queue
+ * @retval other   handle of the next queue
+ *
+ * @note       do not destroy the queue during enumeration
+ * @see        etos_msgq_get_stat()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+etos_msg_handle etos_msgq_get_next(etos_msg_handle msg_handle);
+
+
+
+/**
+ * report message queue statistics.
+ * print depth, throughput and latency of all message queues
+ *
+ * @param[in]    prompt   print header
+ *
+ * @return 0
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_msgq_report(const char *prompt);
+
+
+
 #endif  /* __ETOS_MSGQ_H__ */
 
 /* EOF */
@@ -0,0 +1,201 @@
+/******************************************************************************
+File    :  etos_mutex.h
+
+This file is part of the ETOS distribution
+Copyright (c) 2026, ETOS Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+(version 2) as published by the Free Software Foundation. See
+the LICENSE file in the top-level directory for more details.
+
+Description:
+		mutex with priority inheritance
+		owner借用等待者中最高的优先级运行(和等待者交换priority slot)，
+		释放所有mutex后恢复原来的优先级
+
+History:
+
+Date           Author       Notes
+----------     -------      -------------------------
+2026-10-19     deeve        Create
+2026-10-19     deeve        Use generic wait queue
+
+*******************************************************************************/
+#ifndef __ETOS_MUTEX_H__
+#define __ETOS_MUTEX_H__
+
+/******************************************************************************
+ *                                 Include Files                              *
+ ******************************************************************************/
+#include "etos_cfg.h"
+#include "etos_types.h"
+#include "etos_listop.h"
+#include "etos_task.h"
+#include "etos_waitq.h"
+
+/******************************************************************************
+ *                                 Macros/Defines/Structures                  *
+ ******************************************************************************/
+typedef u32 etos_mutex_handle;
+
+
+#define ETOS_MUTEX_CHECK_FLAG          (0x19870521)
+
+
+typedef struct _etos_mutex_stat {
+    u32 acquire_cnt;              /*successful lock, recursive lock is not counted*/
+    u32 contended_cnt;            /*lock found the mutex owned by another task*/
+    u32 timeout_cnt;
+    u32 max_hold_time;            /*in timestamp unit, see etos_sched_get_timestamp_freq()*/
+} etos_mutex_stat_t;
+
+
+typedef struct _etos_mutex {
+    list_t            list;             /*all mutexes, for report*/
+    list_t            held_list;        /*mutexes held by owner*/
+    etos_waitq_t      waitq;            /*tasks waiting for the mutex*/
+    etos_tcb_t        *owner;
+    u32               lock_cnt;         /*recursive lock count*/
+    BOOL              recursive;
+    u32               lock_timestamp;
+    etos_mutex_stat_t stat;
+    char              name[ETOS_MAX_TASK_NAME_LEN];
+    u32               mutex_check_flag;
+} etos_mutex_t;
+
+
+/******************************************************************************
+ *                                 Declar Functions                           *
+ ******************************************************************************/
+
+/**
+ * create a mutex.
+ *
+ * @param[in]    name          mutex name, max length is ETOS_MAX_TASK_NAME_LEN
+ * @param[in]    recursive     TRUE: the owner can lock it again
+ * @param[out]   mutex_handle  output handle for other mutex API
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @see        etos_mutex_destroy()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_mutex_create(const char *name, BOOL recursive, etos_mutex_handle *mutex_handle);
+
+
+
+/**
+ * destroy a mutex.
+ *
+ * @param[in]    mutex_handle
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail, the mutex is owned by a task
+ *
+ * @see        etos_mutex_create()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_mutex_destroy(etos_mutex_handle mutex_handle);
+
+
+
+/**
+ * lock a mutex.
+ * the caller pends until the mutex is unlocked or timeout, the owner runs at
+ * the priority of the highest waiter until it unlocks all mutexes
+ *
+ * @param[in]    mutex_handle
+ * @param[in]    timeout_ticks    0: do not wait, ETOS_WAIT_FOREVER: wait until it is unlocked
+ *
+ * @return
+ * @retval 0                  success
+ * @retval ETOS_RET_BUSY      the mutex is owned by another task and timeout_ticks is 0
+ * @retval ETOS_RET_TIMEOUT   timeout
+ * @retval other              fail
+ *
+ * @note       do not call this API in an interrupt context
+ * @see        etos_mutex_unlock()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_mutex_lock(etos_mutex_handle mutex_handle, u32 timeout_ticks);
+
+
+
+/**
+ * try to lock a mutex.
+ *
+ * @param[in]    mutex_handle
+ *
+ * @return
+ * @retval 0                  success
+ * @retval ETOS_RET_BUSY      the mutex is owned by another task
+ * @retval other              fail
+ *
+ * @see        etos_mutex_lock()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_mutex_trylock(etos_mutex_handle mutex_handle);
+
+
+
+/**
+ * unlock a mutex.
+ * the mutex is handed over to the highest waiter, which runs at next schedulable time
+ *
+ * @param[in]    mutex_handle
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail, the caller is not the owner
+ *
+ * @note       the owner must unlock all mutexes before its task ends
+ * @see        etos_mutex_lock()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_mutex_unlock(etos_mutex_handle mutex_handle);
+
+
+
+/**
+ * get mutex contention statistics.
+ *
+ * @param[in]    mutex_handle
+ * @param[out]   stat
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_mutex_get_stat(etos_mutex_handle mutex_handle, etos_mutex_stat_t *stat);
+
+
+
+/**
+ * report mutex statistics.
+ * print owner and contention statistics of all mutexes
+ *
+ * @param[in]    prompt   print header
+ *
+ * @return 0
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_mutex_report(const char *prompt);
+
+
+#endif  /* __ETOS_MUTEX_H__ */
+
+/* EOF */
@@ -0,0 +1,142 @@
+/******************************************************************************
+File    :  etos_notify.h
+
+This file is part of the ETOS distribution
+Copyright (c) 2026, ETOS Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+(version 2) as published by the Free Software Foundation. See
+the LICENSE file in the top-level directory for more details.
+
+Description:
+		direct to task notification
+		每个task的TCB里有一个32 bits的notification value，ISR或task直接写它并唤醒task，
+		不需要malloc，也不需要单独的内核对象
+
+History:
+
+Date           Author       Notes
+----------     -------      -------------------------
+2026-10-19     deeve        Create
+2026-10-19     deeve        Add etos_task_notify_take() for counting semaphore
+
+*******************************************************************************/
+#ifndef __ETOS_NOTIFY_H__
+#define __ETOS_NOTIFY_H__
+
+/******************************************************************************
+ *                                 Include Files                              *
+ ******************************************************************************/
+#include "etos_cfg.h"
+#include "etos_types.h"
+
+/******************************************************************************
+ *                                 Macros/Defines/Structures                  *
+ ******************************************************************************/
+
+#define ETOS_NOTIFY_CLEAR_ALL          (0xFFFFFFFF)   /*clear_bits of etos_task_notify_wait()*/
+
+
+typedef enum _etos_notify_action_e {
+    ETOS_NOTIFY_SET_BITS = 0,          /* value |= arg, eg: event bits */
+    ETOS_NOTIFY_INCREMENT,             /* value++, arg is ignored, eg: counting semaphore taken by etos_task_notify_take() */
+    ETOS_NOTIFY_OVERWRITE,             /* value = arg even if the last one is not taken, eg: mailbox */
+    ETOS_NOTIFY_NO_OVERWRITE,          /* value = arg, fail if the last one is not taken */
+} etos_notify_action_e;
+
+
+/******************************************************************************
+ *                                 Declar Functions                           *
+ ******************************************************************************/
+
+/**
+ * notify a task.
+ * update the notification value of the task and wake it up if it is waiting
+ *
+ * @param[in]    task_handle
+ * @param[in]    value
+ * @param[in]    action     etos_notify_action_e
+ *
+ * @return
+ * @retval 0               success
+ * @retval ETOS_RET_BUSY   ETOS_NOTIFY_NO_OVERWRITE and the last value is not taken
+ * @retval other           fail
+ *
+ * @note       it can be called in ISR
+ * @see        etos_task_notify_wait()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_task_notify(etos_task_handle task_handle, u32 value, u32 action);
+
+
+
+/**
+ * notify a task in disable interrupt context.
+ *
+ * @param[in]    task_handle
+ * @param[in]    value
+ * @param[in]    action     etos_notify_action_e
+ *
+ * @return
+ * @retval 0               success
+ * @retval ETOS_RET_BUSY   ETOS_NOTIFY_NO_OVERWRITE and the last value is not taken
+ * @retval other           fail
+ *
+ * @see        etos_task_notify()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_task_notify_idic(etos_task_handle task_handle, u32 value, u32 action);
+
+
+
+/**
+ * wait notification of current task.
+ * the value is output and the clear_bits of it are cleared when it returns
+ *
+ * @param[in]    clear_bits       bits cleared on exit, ETOS_NOTIFY_CLEAR_ALL: clear the whole value
+ * @param[out]   value            notification value before clear, can be NULL
+ * @param[in]    timeout_ticks    0: do not wait, ETOS_WAIT_FOREVER: wait until notified
+ *
+ * @return
+ * @retval 0                  success
+ * @retval ETOS_RET_BUSY      there is no notification and timeout_ticks is 0
+ * @retval ETOS_RET_TIMEOUT   timeout
+ * @retval other              fail
+ *
+ * @note       do not call this API in an interrupt context
+ * @see        etos_task_notify()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_task_notify_wait(u32 clear_bits, u32 *value, u32 timeout_ticks);
+
+
+
+/**
+ * take one count of notification of current task.
+ * the notification value is used as a counting semaphore given by ETOS_NOTIFY_INCREMENT,
+ * the value is decreased by one, and it keeps pending while the value is not zero
+ *
+ * @param[out]   count            notification value before take, can be NULL
+ * @param[in]    timeout_ticks    0: do not wait, ETOS_WAIT_FOREVER: wait until notified
+ *
+ * @return
+ * @retval 0                  success
+ * @retval ETOS_RET_BUSY      the value is zero and timeout_ticks is 0
+ * @retval ETOS_RET_TIMEOUT   timeout
+ * @retval other              fail
+ *
+ * @note       do not call this API in an interrupt context
+ * @see        etos_task_notify()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_task_notify_take(u32 *count, u32 timeout_ticks);
+
+
+#endif  /* __ETOS_NOTIFY_H__ */
+
+/* EOF */
@@ -0,0 +1,129 @@
+/******************************************************************************
+File    :  etos_prof.h
+
+This file is part of the ETOS distribution
+Copyright (c) 2026, ETOS Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+(version 2) as published by the Free Software Foundation. See
+the LICENSE file in the top-level directory for more details.
+
+Description:
+		statistical PC sampling profiler
+		在timer中断里记录被中断的PC和当前task，host端工具根据map文件统计函数热点
+
+History:
+
+Date           Author       Notes
+----------     -------      -------------------------
+2026-10-19     deeve        Create
+
+*******************************************************************************/
+#ifndef __ETOS_PROF_H__
+#define __ETOS_PROF_H__
+
+/******************************************************************************
+ *                                 Include Files                              *
+ ******************************************************************************/
+#include "etos_cfg.h"
+#include "etos_types.h"
+
+/******************************************************************************
+ *                                 Macros/Defines/Structures                  *
+ ******************************************************************************/
+
+#define ETOS_PROF_VERSION            (1)
+
+/*task id in sample, task base priority is used for normal task*/
+#define ETOS_PROF_TASK_BOOT          (0xff)   /*boot code (idle)*/
+
+
+/******************************************************************************
+ *                                 Declar Functions                           *
+ ******************************************************************************/
+
+/**
+ * start profiler.
+ * start to record samples, the samples recorded before are kept
+ *
+ * @param[in]    sample_rate_hz    the rate of etos_prof_sample_in_isr() is called,
+ *                                 it is only used by host tool
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @see   etos_prof_stop()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_prof_start(u32 sample_rate_hz);
+
+
+
+/**
+ * stop profiler.
+ *
+ * @param[in]    void
+ *
+ * @return   none
+ *
+ * @see   etos_prof_start()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+void etos_prof_stop(void);
+
+
+
+/**
+ * clear all samples.
+ *
+ * @param[in]    void
+ *
+ * @return   none
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+void etos_prof_reset(void);
+
+
+
+/**
+ * record one sample.
+ * record the interrupted PC and task from the saved IRQ frame
+ *
+ * @param[in]    void
+ *
+ * @return   none
+ *
+ * @note  it must be called in ISR, eg: timer interrupt service routine
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+void etos_prof_sample_in_isr(void);
+
+
+
+/**
+ * dump samples.
+ * print all samples as text lines, tools/etos_prof.py maps them to functions
+ *
+ * @param[in]    output_handle    gioi handle, eg: xlog_get_output_handle()
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @note  profiler is stopped during dump
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_prof_dump(u32 output_handle);
+
+
+#endif  /* __ETOS_PROF_H__ */
+
+/* EOF */
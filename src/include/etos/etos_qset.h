@@ -0,0 +1,181 @@
+/******************************************************************************
+File    :  etos_qset.h
+
+This file is part of the ETOS distribution
+Copyright (c) 2026, ETOS Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+(version 2) as published by the Free Software Foundation. See
+the LICENSE file in the top-level directory for more details.
+
+Description:
+		queue set, wait on multiple message queues and semaphores at once
+		message queue或semaphore变为可取时通知它所在的queue set，
+		select返回一个ready的成员，再用recv_no_block/take(0)取出
+
+History:
+
+Date           Author       Notes
+----------     -------      -------------------------
+2026-10-19     deeve        Create
+
+*******************************************************************************/
+#ifndef __ETOS_QSET_H__
+#define __ETOS_QSET_H__
+
+/******************************************************************************
+ *                                 Include Files                              *
+ ******************************************************************************/
+#include "etos_cfg.h"
+#include "etos_types.h"
+#include "etos_waitq.h"
+
+/******************************************************************************
+ *                                 Macros/Defines/Structures                  *
+ ******************************************************************************/
+typedef u32 etos_qset_handle;
+
+
+#define ETOS_QSET_CHECK_FLAG           (0x19930917)
+
+
+typedef enum _etos_qset_member_e {
+    ETOS_QSET_MEMBER_MSGQ = 1,         /*etos_msg_handle*/
+    ETOS_QSET_MEMBER_SEM,              /*etos_sem_handle*/
+} etos_qset_member_e;
+
+
+typedef struct _etos_qset_member {
+    u32               type;             /*etos_qset_member_e*/
+    u32               handle;
+} etos_qset_member_t;
+
+
+typedef struct _etos_qset {
+    etos_waitq_t      waitq;            /*tasks selecting the set*/
+    etos_qset_member_t members[ETOS_QSET_MAX_MEMBERS];
+    u32               member_num;
+    u32               next_member;      /*start point of next ready check, members are served round robin*/
+    u32               qset_check_flag;
+} etos_qset_t;
+
+
+/******************************************************************************
+ *                                 Declar Functions                           *
+ ******************************************************************************/
+
+/**
+ * create a queue set.
+ *
+ * @param[out]   qset_handle    output handle for other queue set API
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @see        etos_qset_destroy()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_qset_create(etos_qset_handle *qset_handle);
+
+
+
+/**
+ * destroy a queue set.
+ * all members are removed from the set
+ *
+ * @param[in]    qset_handle
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail, a task is selecting the set
+ *
+ * @see        etos_qset_create()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_qset_destroy(etos_qset_handle qset_handle);
+
+
+
+/**
+ * add a message queue or semaphore to a queue set.
+ *
+ * @param[in]    qset_handle
+ * @param[in]    type      etos_qset_member_e
+ * @param[in]    handle    etos_msg_handle or etos_sem_handle
+ *
+ * @return
+ * @retval 0               success
+ * @retval ETOS_RET_BUSY   the member is in a queue set already
+ * @retval other           fail
+ *
+ * @note       an object can be a member of only one queue set
+ * @see        etos_qset_remove()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_qset_add(etos_qset_handle qset_handle, u32 type, u32 handle);
+
+
+
+/**
+ * remove a member from a queue set.
+ *
+ * @param[in]    qset_handle
+ * @param[in]    handle    etos_msg_handle or etos_sem_handle
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @see        etos_qset_add()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_qset_remove(etos_qset_handle qset_handle, u32 handle);
+
+
+
+/**
+ * wait until a member of a queue set is ready.
+ * a message queue is ready when it has messages, a semaphore is ready when its count is not 0
+ *
+ * @param[in]    qset_handle
+ * @param[out]   ready_handle     the ready member
+ * @param[in]    timeout_ticks    0: do not wait, ETOS_WAIT_FOREVER: wait until a member is ready
+ *
+ * @return
+ * @retval 0                  success
+ * @retval ETOS_RET_BUSY      no member is ready and timeout_ticks is 0
+ * @retval ETOS_RET_TIMEOUT   timeout
+ * @retval other              fail
+ *
+ * @note       the caller gets the message or semaphore by etos_msgq_recv_no_block() or
+ *             etos_sem_take(h, 0), it may fail if another task gets it first
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_qset_select(etos_qset_handle qset_handle, u32 *ready_handle, u32 timeout_ticks);
+
+
+
+/**
+ * notify a queue set that a member may be ready in disable interrupt context.
+ * it is called by message queue and semaphore
+ *
+ * @param[in]    qset    the set of the member, can be NULL
+ *
+ * @return   none
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+void etos_qset_notify_idic(struct _etos_qset *qset);
+
+
+#endif  /* __ETOS_QSET_H__ */
+
+/* EOF */
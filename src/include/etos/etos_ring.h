@@ -0,0 +1,162 @@
+/******************************************************************************
+File    :  etos_ring.h
+
+This file is part of the ETOS distribution
+Copyright (c) 2026, ETOS Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+(version 2) as published by the Free Software Foundation. See
+the LICENSE file in the top-level directory for more details.
+
+Description:
+		lock-free single producer / single consumer byte ring
+		producer(通常是ISR)只写head，consumer(task)只读写tail，快速路径不关中断;
+		只有consumer阻塞等待数据时才用wait queue
+
+History:
+
+Date           Author       Notes
+----------     -------      -------------------------
+2026-10-19     deeve        Create
+
+*******************************************************************************/
+#ifndef __ETOS_RING_H__
+#define __ETOS_RING_H__
+
+/******************************************************************************
+ *                                 Include Files                              *
+ ******************************************************************************/
+#include "etos_cfg.h"
+#include "etos_types.h"
+#include "etos_waitq.h"
+
+/******************************************************************************
+ *                                 Macros/Defines/Structures                  *
+ ******************************************************************************/
+
+/*
+ * head and tail are free running counters, count = head - tail, index = counter & mask,
+ * they are in different cache lines so that producer and consumer do not share a line
+ */
+typedef struct _etos_ring {
+    volatile u32      head;             /*written by producer only*/
+    u8                head_pad[ETOS_CACHE_LINE_SIZE - sizeof(u32)];
+    volatile u32      tail;             /*written by consumer only*/
+    u8                tail_pad[ETOS_CACHE_LINE_SIZE - sizeof(u32)];
+    u32               mask;             /*size - 1*/
+    u8                *buf;
+    etos_waitq_t      waitq;            /*the consumer waiting for data*/
+} etos_ring_t;
+
+
+/******************************************************************************
+ *                                 Declar Functions                           *
+ ******************************************************************************/
+
+/**
+ * init a ring.
+ *
+ * @param[in]    ring
+ * @param[in]    buf
+ * @param[in]    size    buffer size, it must be power of 2
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_ring_init(etos_ring_t *ring, u8 *buf, u32 size);
+
+
+
+/**
+ * get the number of bytes in a ring.
+ *
+ * @param[in]    ring
+ *
+ * @return   bytes can be read
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+u32 etos_ring_count(etos_ring_t *ring);
+
+
+
+/**
+ * get the free space of a ring.
+ *
+ * @param[in]    ring
+ *
+ * @return   bytes can be written
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+u32 etos_ring_space(etos_ring_t *ring);
+
+
+
+/**
+ * write bytes to a ring.
+ * it is called by the only producer, it can be called in ISR
+ *
+ * @param[in]    ring
+ * @param[in]    data
+ * @param[in]    len
+ *
+ * @return   bytes written, it is less than len when the ring is full
+ *
+ * @note       interrupt is disabled only when the consumer is waiting
+ * @see        etos_ring_get()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+u32 etos_ring_put(etos_ring_t *ring, const u8 *data, u32 len);
+
+
+
+/**
+ * read bytes from a ring.
+ * it is called by the only consumer
+ *
+ * @param[in]    ring
+ * @param[out]   buf
+ * @param[in]    len
+ *
+ * @return   bytes read, 0 if the ring is empty
+ *
+ * @see        etos_ring_put()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+u32 etos_ring_get(etos_ring_t *ring, u8 *buf, u32 len);
+
+
+
+/**
+ * wait until a ring is not empty.
+ * it is called by the only consumer
+ *
+ * @param[in]    ring
+ * @param[in]    timeout_ticks    0: do not wait, ETOS_WAIT_FOREVER: wait until data comes
+ *
+ * @return
+ * @retval 0                  success, some data can be read
+ * @retval ETOS_RET_BUSY      the ring is empty and timeout_ticks is 0
+ * @retval ETOS_RET_TIMEOUT   timeout
+ * @retval other              fail
+ *
+ * @note       do not call this API in an interrupt context
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_ring_wait(etos_ring_t *ring, u32 timeout_ticks);
+
+
+#endif  /* __ETOS_RING_H__ */
+
+/* EOF */
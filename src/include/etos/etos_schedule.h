@@ -18,6 +18,12 @@ Date           Author       Notes
 ----------     -------      -------------------------
 2013-10-20     deeve        Create
 2015-4-15      deeve        Add some comments
+2026-10-19     deeve        Add timestamp source for trace
+2026-10-19     deeve        Add priority change and budget check
+2026-10-19     deeve        Add priority swap for mutex priority inheritance
+2026-10-19     deeve        Add 64 bit tick protected by seqlock
+2026-10-19     deeve        Add timestamp to us conversion
+2026-10-19     deeve        Add owed tick for time base
 
 *******************************************************************************/
 #ifndef __ETOS_SCHEDULE_H__
@@ -34,6 +40,9 @@ Date           Author       Notes
  *                                 Macros/Defines/Structures                  *
  ******************************************************************************/
 
+/*high resolution timestamp source, it is provided by board (eg: timer count)*/
+typedef u32 (*pfunc_timestamp)(void);
+
 
 /******************************************************************************
  *                                 Declar Functions                           *
@@ -114,7 +123,8 @@ etos_tick etos_sched_get_tick(void);
  *
  * @return  none
  *
- * @note none
+ * @note the 64 bit tick moves by the signed difference from current tick, it carries or borrows
+ *       the high 32 bits like etos_sched_adjust_tick()
  * @authors    deeve
  * @date       2015/4/15
  */
@@ -130,7 +140,7 @@ void etos_sched_set_tick(etos_tick tick);
  *
  * @return   none
  *
- * @note none
+ * @note the ticks owed by etos_sched_owe_tick_idic() are paid by a positive offset
  * @authors    deeve
  * @date       2015/4/15
  */
@@ -138,6 +148,162 @@ void etos_sched_adjust_tick(s32 offset);
 
 
 
+/**
+ * owe a tick in the tick timer ISR.
+ * the tick timer ISR acknowledges the hardware before the tick is added by etos_sched_adjust_tick(),
+ * the tick is owed in between, so a time base which combines the tick and the hardware counter
+ * counts it and does not go back
+ *
+ * @param[in]    void
+ *
+ * @return   none
+ *
+ * @note  call it in the ISR which returns ETOS_ISR_RESCHEDULE_UPDATE_TICK, before the interrupt is cleared
+ * @see   etos_sched_get_owed_tick()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+void etos_sched_owe_tick_idic(void);
+
+
+
+/**
+ * get owed tick.
+ * read it with etos_sched_get_tick() between etos_sched_tick_read_begin() and etos_sched_tick_read_retry()
+ *
+ * @param[in]    void
+ *
+ * @return   ticks owed by etos_sched_owe_tick_idic() and not added to the tick yet
+ *
+ * @see   etos_sched_owe_tick_idic()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+u32 etos_sched_get_owed_tick(void);
+
+
+
+/**
+ * get 64 bit tick.
+ * the tick does not wrap around, it is read without disable interrupt
+ *
+ * @param[in]    void
+ *
+ * @return  64 bit tick, the low 32 bits is etos_sched_get_tick()
+ *
+ * @note  do not call it in the context which interrupts the tick update
+ * @see   etos_sched_tick_read_begin()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+u64 etos_sched_get_tick64(void);
+
+
+
+/**
+ * begin to read the time base.
+ * a time source which combines the tick and a hardware counter reads them between
+ * etos_sched_tick_read_begin() and etos_sched_tick_read_retry(), and reads again if it is retry
+ *
+ * @param[in]    void
+ *
+ * @return   sequence which is passed to etos_sched_tick_read_retry()
+ *
+ * @see   etos_sched_tick_read_retry()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+u32 etos_sched_tick_read_begin(void);
+
+
+
+/**
+ * check whether the tick is updated during reading the time base.
+ *
+ * @param[in]    sequence    returned by etos_sched_tick_read_begin()
+ *
+ * @return
+ * @retval TRUE    the tick is updated, read again
+ * @retval FALSE   the values read are consistent
+ *
+ * @see   etos_sched_tick_read_begin()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+BOOL etos_sched_tick_read_retry(u32 sequence);
+
+
+
+/**
+ * register timestamp source.
+ * register a high resolution free running counter which is used by trace
+ * and statistics, the system tick is used if there is no timestamp source
+ *
+ * @param[in]    pfunc_ts     function pointer which returns current timestamp
+ * @param[in]    freq_hz      timestamp counter frequency
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @note  pfunc_ts may be called in ISR and disable interrupt context
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_sched_register_timestamp(pfunc_timestamp pfunc_ts, u32 freq_hz);
+
+
+
+/**
+ * get timestamp.
+ * get current timestamp from the registered timestamp source
+ *
+ * @param[in]    void
+ *
+ * @return   timestamp
+ *
+ * @note  it wraps around, use (u32)(end - begin) to get the duration
+ * @see   etos_sched_get_timestamp_freq()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+u32 etos_sched_get_timestamp(void);
+
+
+
+/**
+ * get timestamp frequency.
+ * get the count of timestamp in one second
+ *
+ * @param[in]    void
+ *
+ * @return   frequency in Hz
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+u32 etos_sched_get_timestamp_freq(void);
+
+
+
+/**
+ * convert timestamp count to us.
+ * the duration measured by timestamp is converted with 32 bit division only, armv4 has no
+ * divide instruction and the 64 bit division of libgcc is much slower than the 32 bit one
+ *
+ * @param[in]    count    timestamp count, eg: (u32)(end - begin)
+ *
+ * @return   us
+ *
+ * @note  it wraps around if the duration is longer than about 4294 seconds
+ * @see   etos_sched_get_timestamp_freq()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+u32 etos_sched_timestamp_to_us(u32 count);
+
+
+
 /**
  * get current task handle.
  * get current running task handle, it is zero in the condition of boot or task end
@@ -361,6 +527,83 @@ s32 etos_sched_resume_task_idic(etos_task_handle task_handle, etos_task_state_e
 
 
 
+/**
+ * change task priority in disable interrupt context.
+ * change the effective priority of a task, the schedule mask follows the new priority
+ *
+ * @param[in]    task_handle
+ * @param[in]    new_priority     it must be free, see etos_task_priority_is_free_idic()
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @note  the new priority takes effect at next schedulable time
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_sched_change_priority_idic(etos_task_handle task_handle, u32 new_priority);
+
+
+
+/**
+ * swap the priorities of two tasks in disable interrupt context.
+ * exchange the effective priorities of two tasks, the schedule masks follow them
+ *
+ * @param[in]    task_handle_a
+ * @param[in]    task_handle_b
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @note  it is used by priority inheritance, the owner borrows the priority of
+ *        a pending waiter, and the waiter keeps the priority of the owner
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_sched_swap_priority_idic(etos_task_handle task_handle_a, etos_task_handle task_handle_b);
+
+
+
+/**
+ * move task to a priority in disable interrupt context.
+ * the task is moved to the priority if it is free, or swaps priority with the
+ * pending task which runs at the priority
+ *
+ * @param[in]    task_handle
+ * @param[in]    new_priority
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail, the priority is used by another schedulable task
+ *
+ * @see   etos_sched_swap_priority_idic()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_sched_set_priority_idic(etos_task_handle task_handle, u32 new_priority);
+
+
+
+/**
+ * update task execution budget in interrupt service routine.
+ * account one tick to the interrupted task, and take the budget action
+ * when the task runs over its budget in current activation
+ *
+ * @param[in]    task_handle      the interrupted task, it may be zero (boot code)
+ *
+ * @return   none
+ *
+ * @note  it is called in tick ISR before reschedule
+ * @see   etos_task_set_budget()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+void etos_sched_update_budget_in_isr(etos_task_handle task_handle);
+
+
+
 #endif  /* __ETOS_SCHEDULE_H__ */
 
 /* EOF */
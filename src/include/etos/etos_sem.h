@@ -0,0 +1,176 @@
+/******************************************************************************
+File    :  etos_sem.h
+
+This file is part of the ETOS distribution
+Copyright (c) 2026, ETOS Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+(version 2) as published by the Free Software Foundation. See
+the LICENSE file in the top-level directory for more details.
+
+Description:
+		counting and binary semaphore
+		give不分配内存，可以在ISR中调用(_idic)，用来代替只为唤醒task而发送的message
+
+History:
+
+Date           Author       Notes
+----------     -------      -------------------------
+2026-10-19     deeve        Create
+2026-10-19     deeve        Use generic wait queue
+2026-10-19     deeve        Notify queue set
+
+*******************************************************************************/
+#ifndef __ETOS_SEM_H__
+#define __ETOS_SEM_H__
+
+/******************************************************************************
+ *                                 Include Files                              *
+ ******************************************************************************/
+#include "etos_cfg.h"
+#include "etos_types.h"
+#include "etos_listop.h"
+#include "etos_task.h"
+#include "etos_waitq.h"
+
+/******************************************************************************
+ *                                 Macros/Defines/Structures                  *
+ ******************************************************************************/
+typedef u32 etos_sem_handle;
+
+
+#define ETOS_SEM_CHECK_FLAG            (0x19900214)
+
+#define ETOS_SEM_BINARY                (1)    /*max count of binary semaphore*/
+
+
+typedef struct _etos_sem {
+    etos_waitq_t      waitq;            /*tasks waiting for the semaphore*/
+    u32               count;
+    u32               max_count;
+    struct _etos_qset *qset;            /*queue set it belongs to, can be NULL*/
+    u32               sem_check_flag;
+} etos_sem_t;
+
+
+/******************************************************************************
+ *                                 Declar Functions                           *
+ ******************************************************************************/
+
+/**
+ * create a semaphore.
+ *
+ * @param[in]    init_count    initial count, it must not be larger than max_count
+ * @param[in]    max_count     ETOS_SEM_BINARY for binary semaphore
+ * @param[out]   sem_handle    output handle for other semaphore API
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @see        etos_sem_destroy()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_sem_create(u32 init_count, u32 max_count, etos_sem_handle *sem_handle);
+
+
+
+/**
+ * destroy a semaphore.
+ *
+ * @param[in]    sem_handle
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail, a task is waiting for the semaphore or it is in a queue set
+ *
+ * @see        etos_sem_create()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_sem_destroy(etos_sem_handle sem_handle);
+
+
+
+/**
+ * take a semaphore.
+ * the caller pends until the semaphore is given or timeout
+ *
+ * @param[in]    sem_handle
+ * @param[in]    timeout_ticks    0: do not wait, ETOS_WAIT_FOREVER: wait until it is given
+ *
+ * @return
+ * @retval 0                  success
+ * @retval ETOS_RET_BUSY      count is 0 and timeout_ticks is 0
+ * @retval ETOS_RET_TIMEOUT   timeout
+ * @retval other              fail
+ *
+ * @note       do not call this API in an interrupt context
+ * @see        etos_sem_give()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_sem_take(etos_sem_handle sem_handle, u32 timeout_ticks);
+
+
+
+/**
+ * give a semaphore.
+ * wake up the highest waiter, or increase the count if there is no waiter
+ *
+ * @param[in]    sem_handle
+ *
+ * @return
+ * @retval 0               success
+ * @retval ETOS_RET_BUSY   the count reaches max_count
+ * @retval other           fail
+ *
+ * @see        etos_sem_take()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_sem_give(etos_sem_handle sem_handle);
+
+
+
+/**
+ * give a semaphore in disable interrupt context.
+ * it can be called in ISR
+ *
+ * @param[in]    sem_handle
+ *
+ * @return
+ * @retval 0               success
+ * @retval ETOS_RET_BUSY   the count reaches max_count
+ * @retval other           fail
+ *
+ * @note       the woken task runs at next schedulable time
+ * @see        etos_sem_give()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_sem_give_idic(etos_sem_handle sem_handle);
+
+
+
+/**
+ * get the count of a semaphore.
+ *
+ * @param[in]    sem_handle
+ * @param[out]   count
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_sem_get_count(etos_sem_handle sem_handle, u32 *count);
+
+
+#endif  /* __ETOS_SEM_H__ */
+
+/* EOF */
@@ -18,6 +18,7 @@ Date           Author       Notes
 ----------     -------      -------------------------
 2014-11-2      deeve        Create
 2015-4-14      deeve        Add some comments
+2026-10-19     deeve        Sleep on generic wait queue timeout
 
 *******************************************************************************/
 #ifndef __ETOS_SLEEP_H__
@@ -41,34 +42,10 @@ Date           Author       Notes
 #define ms_to_tick(ms)          ((ms) * TICK_COUNT_IN_16_MILLISECONDS / 16)
 
 
-typedef struct _sleep_block {
-    list_t  list;
-    etos_tcb_t *pt_os_task_tcb;
-    u32 wakeup_tick;          /*wakeup after this tick*/
-    u32 sleep_ticks;          /*duration*/
-} sleep_block_t;
-
-
 /******************************************************************************
  *                                 Declar Functions                           *
  ******************************************************************************/
 
-/**
- * update tick for sleep.
- * update tick for sleep in interrupt service routine
- *
- * @param[in]    current_tick
- *
- * @return   none
- *
- * @note   it is called in interrupt service routine
- * @authors    deeve
- * @date       2015/4/14
- */
-void etos_sleep_update_tick_in_isr(etos_tick current_tick);
-
-
-
 /**
  * sleep some ticks.
  * sleep some ticks, it will cause task reschedule
@@ -0,0 +1,179 @@
+/******************************************************************************
+File    :  etos_sporadic.h
+
+This file is part of the ETOS distribution
+Copyright (c) 2026, ETOS Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+(version 2) as published by the Free Software Foundation. See
+the LICENSE file in the top-level directory for more details.
+
+Description:
+		sporadic server for aperiodic task
+		task在capacity内以高优先级(base priority)运行，capacity用完后降到后台优先级，
+		消耗的capacity在本次开始运行后的一个period后补充
+
+History:
+
+Date           Author       Notes
+----------     -------      -------------------------
+2026-10-19     deeve        Create
+
+*******************************************************************************/
+#ifndef __ETOS_SPORADIC_H__
+#define __ETOS_SPORADIC_H__
+
+/******************************************************************************
+ *                                 Include Files                              *
+ ******************************************************************************/
+#include "etos_cfg.h"
+#include "etos_types.h"
+#include "etos_task.h"
+
+/******************************************************************************
+ *                                 Macros/Defines/Structures                  *
+ ******************************************************************************/
+
+typedef struct _etos_sporadic_replenish {
+    etos_tick replenish_tick;     /*add amount to capacity at this tick*/
+    u32 amount;
+} etos_sporadic_replenish_t;
+
+
+typedef struct _etos_sporadic_scb {
+    etos_tcb_t *pt_os_task_tcb;
+    u32 capacity_max;             /*C: ticks at high priority in one period*/
+    u32 period;                   /*T: replenishment period in ticks*/
+    u32 low_priority;             /*background priority when capacity is exhausted*/
+    u32 capacity;                 /*remaining capacity*/
+    BOOL chunk_open;              /*running at high priority since chunk_start*/
+    etos_tick chunk_start;
+    u32 chunk_consumed;
+    BOOL demoted;
+    u32 replenish_num;
+    etos_sporadic_replenish_t replenish[ETOS_SPORADIC_MAX_REPLENISH];
+    u32 exhausted_cnt;            /*statistics*/
+} etos_sporadic_scb_t;
+
+
+/******************************************************************************
+ *                                 Declar Functions                           *
+ ******************************************************************************/
+
+/**
+ * make a task sporadic server.
+ * the task runs at its base priority with capacity_ticks ticks in each period_ticks,
+ * it runs at low_priority once the capacity is exhausted until the capacity is replenished
+ *
+ * @param[in]    task_handle
+ * @param[in]    capacity_ticks    capacity C, must be less than period_ticks
+ * @param[in]    period_ticks      replenishment period T
+ * @param[in]    low_priority      background priority, the nearest free priority above it
+ *                                 is used if it is busy
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @note  capacity is accounted in tick, so the server is charged one tick whenever
+ *        it is interrupted by tick at high priority
+ * @see   etos_sporadic_clear()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_sporadic_set(etos_task_handle task_handle, u32 capacity_ticks, u32 period_ticks, u32 low_priority);
+
+
+
+/**
+ * make a sporadic server normal task.
+ * the task gets its base priority back
+ *
+ * @param[in]    task_handle
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @see   etos_sporadic_set()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_sporadic_clear(etos_task_handle task_handle);
+
+
+
+/**
+ * make a sporadic server normal task in disable interrupt context.
+ *
+ * @param[in]    task_handle
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @note  it is called when task is destroyed
+ * @see   etos_sporadic_clear()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_sporadic_clear_idic(etos_task_handle task_handle);
+
+
+
+/**
+ * get sporadic server statistics.
+ *
+ * @param[in]    task_handle
+ * @param[out]   capacity         remaining capacity, can be NULL
+ * @param[out]   exhausted_cnt    the count of capacity exhausted, can be NULL
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_sporadic_get_stat(etos_task_handle task_handle, u32 *capacity, u32 *exhausted_cnt);
+
+
+
+/**
+ * update sporadic servers in interrupt service routine.
+ * charge the interrupted server one tick and replenish capacity
+ *
+ * @param[in]    task_handle      the interrupted task, it may be zero (boot code)
+ * @param[in]    current_tick
+ *
+ * @return   none
+ *
+ * @note  it is called in tick ISR before reschedule
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+void etos_sporadic_update_tick_in_isr(etos_task_handle task_handle, etos_tick current_tick);
+
+
+
+/**
+ * sporadic server pending.
+ * the server blocks, post the replenishment of the capacity consumed
+ *
+ * @param[in]    task_handle      pending task
+ *
+ * @return
+ * @retval TRUE    the task is a sporadic server, its priority is managed by server
+ * @retval FALSE   normal task
+ *
+ * @note  it is called in disable interrupt context by etos_sched_pending_task()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+BOOL etos_sporadic_pending_idic(etos_task_handle task_handle);
+
+
+#endif  /* __ETOS_SPORADIC_H__ */
+
+/* EOF */
@@ -18,6 +18,20 @@ Date           Author       Notes
 ----------     -------      -------------------------
 2013-10-19     deeve        Create
 2015-4-15      deeve        Remove unnecessary code and add comments
+2026-10-19     deeve        Add execution budget and effective priority
+2026-10-19     deeve        Add mutex pending state and inheritance fields
+2026-10-19     deeve        Add semaphore pending state
+2026-10-19     deeve        Add event group pending state
+2026-10-19     deeve        Add wait node for generic wait queue
+2026-10-19     deeve        Add stream pending state
+2026-10-19     deeve        Add queue set pending state
+2026-10-19     deeve        Add task notification value
+2026-10-19     deeve        Add bus pending state
+2026-10-19     deeve        Add ipc pending state
+2026-10-19     deeve        Add memory usage statistics
+2026-10-19     deeve        Add ipc donation chain
+2026-10-19     deeve        Add etos_task_resume_suspended()
+2026-10-19     deeve        Add owner id of memory account
 
 
 *******************************************************************************/
@@ -28,6 +42,7 @@ Date           Author       Notes
  *                                 Include Files                              *
  ******************************************************************************/
 #include "etos_mem.h"
+#include "etos_waitq.h"
 
 /******************************************************************************
  *                                 Macros/Defines/Structures                  *
@@ -47,12 +62,33 @@ typedef enum _etos_task_state_e {
     ETOS_TASK_PENDING_SELF = 0x20,     /* release cpu by itself manually */
     ETOS_TASK_PENDING_MSG = 0x40,      /* pending because of receive message */
     ETOS_TASK_END = 0x80,              /* task function reach to its end (return)*/
+    ETOS_TASK_SUSPENDED = 0x100,       /* suspended because of budget overrun */
+    ETOS_TASK_PENDING_MUTEX = 0x200,   /* pending because of lock mutex */
+    ETOS_TASK_PENDING_SEM = 0x400,     /* pending because of take semaphore */
+    ETOS_TASK_PENDING_EVENT = 0x800,   /* pending because of wait event flags */
+    ETOS_TASK_PENDING_STREAM = 0x1000, /* pending because of wait data of ring */
+    ETOS_TASK_PENDING_QSET = 0x2000,   /* pending because of select queue set */
+    ETOS_TASK_PENDING_NOTIFY = 0x4000, /* pending because of wait task notification */
+    ETOS_TASK_PENDING_BUS = 0x8000,    /* pending because of receive bus message */
+    ETOS_TASK_PENDING_IPC = 0x10000,   /* pending because of ipc call or receive */
 #if (ETOS_ENABLE_EXACT_TASK)
     ETOS_TASK_PEND
 #endif
 } etos_task_state_e;
 
 
+/*the action when a task runs over its execution budget*/
+typedef enum _etos_budget_action_e {
+    ETOS_BUDGET_ACTION_NONE = 0,       /* only count overrun */
+    ETOS_BUDGET_ACTION_LOG,            /* count and print warning log */
+    ETOS_BUDGET_ACTION_DEMOTE,         /* run at lower priority until it pending */
+    ETOS_BUDGET_ACTION_SUSPEND,        /* suspend, resume by etos_task_resume_suspended() */
+    ETOS_BUDGET_ACTION_HOOK,           /* invoke user hook in ISR */
+} etos_budget_action_e;
+
+typedef void (*pfunc_budget_hook)(etos_task_handle task_handle, u32 run_ticks);
+
+
 typedef struct _etos_tcb_t {
     u32  *register_stack_pointer;     //task 当前的堆栈指针
     u32  *stack_begin_addr;           //task 的堆栈
@@ -62,12 +98,38 @@ typedef struct _etos_tcb_t {
     u32  schedule_tick;               //just for exact task，精确调用该task的时间:tick
     BOOL auto_expand;
 #endif
-    u32  priority;                    //值越大，优先级越高.但是和mask不是按bit对应的
+    u32  priority;                    //值越大，优先级越高.但是和mask不是按bit对应的, 当前生效的优先级
+    u32  base_priority;               //创建task时的优先级, tcb和sleep block按它存放
     func_entry task_entry;            //task 的函数入口
     void *arg;                        //传给task_entry的参数
     etos_task_handle  task_handle;    //create task的返回值
     etos_task_state_e  task_state;    //task 的状态
     char task_name[ETOS_MAX_TASK_NAME_LEN];
+    etos_wait_node_t wait_node;       //等待sleep, msgq, mutex等对象时使用
+#if (ETOS_TASK_BUDGET_ENABLE)
+    u32  budget_ticks;                //每次激活后最多连续执行的tick数, 0表示不限制
+    u32  run_ticks;                   //本次激活后已经连续执行的tick数, pending时清零
+    u32  overrun_cnt;                 //超出budget的次数
+    etos_budget_action_e budget_action;
+    u32  demote_priority;             //ETOS_BUDGET_ACTION_DEMOTE 降到的优先级
+    pfunc_budget_hook budget_hook;    //ETOS_BUDGET_ACTION_HOOK 调用的函数
+#endif
+#if (ETOS_MUTEX_ENABLE)
+    list_t mutex_held_list;           //持有的mutex(etos_mutex_t.held_list)
+    BOOL mutex_boosted;               //优先级被mutex继承提升
+    u32  mutex_orig_priority;         //提升前的优先级, 释放所有mutex后恢复
+#endif
+#if (ETOS_NOTIFY_ENABLE)
+    u32  notify_value;                //task notification value
+    BOOL notify_pending;              //有未被取走的notification
+#endif
+#if (ETOS_IPC_ENABLE)
+    struct _etos_ipc_call *ipc_donated;  //最近一次donate优先级给它的ipc call, 通过prev_donated串联
+#endif
+#if (ETOS_MEM_ACCOUNT_ENABLE)
+    etos_mem_stat_t mem_stat;         //malloc的block统计和quota
+    u32 mem_owner_id;                 //每次create不同, block记录它以区分复用同一tcb的task
+#endif
 } etos_tcb_t;
 
 
@@ -202,9 +264,9 @@ s32 etos_task_destroy_idic(etos_task_handle task_handle);
  *
  * @param[in]    priority_id
  *
- * @return   task control block prointer
+ * @return   task control block prointer, NULL if no task runs at this priority
  *
- * @note none
+ * @note  the priority is the current effective priority of the task
  * @see
  * @authors    deeve
  * @date       2015/4/15
@@ -213,6 +275,139 @@ etos_tcb_t *etos_task_get_task(u32 priority_id);
 
 
 
+/**
+ * check priority is free.
+ * check whether a task can run at the priority, the priority is free if
+ * no task runs at it and it is not the base priority of another task
+ *
+ * @param[in]    priority
+ * @param[in]    task_handle    the task which wants to run at priority
+ *
+ * @return   TRUE or FALSE
+ *
+ * @note   it is called in disable interrupt context
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+BOOL etos_task_priority_is_free_idic(u32 priority, etos_task_handle task_handle);
+
+
+
+/**
+ * bind task to a new priority.
+ * change the effective priority of a task, the base priority is not changed
+ *
+ * @param[in]    task_handle
+ * @param[in]    new_priority   it must be free, see etos_task_priority_is_free_idic()
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @note   schedule mask is not changed, use etos_sched_change_priority_idic() instead
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_task_bind_priority_idic(etos_task_handle task_handle, u32 new_priority);
+
+
+
+/**
+ * swap the priorities of two tasks.
+ * exchange the effective priorities of two tasks, the base priorities are not changed
+ *
+ * @param[in]    task_handle_a
+ * @param[in]    task_handle_b
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @note   schedule mask is not changed, use etos_sched_swap_priority_idic() instead
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_task_swap_priority_idic(etos_task_handle task_handle_a, etos_task_handle task_handle_b);
+
+
+
+/**
+ * set task execution budget.
+ * the task can run at most budget_ticks ticks continuously after it is resumed,
+ * the tick interrupt takes the action when the task runs over its budget
+ *
+ * @param[in]    task_handle
+ * @param[in]    budget_ticks      0 means no budget
+ * @param[in]    action            ETOS_BUDGET_ACTION_XXX
+ * @param[in]    demote_priority   the lowest priority for ETOS_BUDGET_ACTION_DEMOTE,
+ *                                 the nearest free priority above it is used if it is busy
+ * @param[in]    hook              the hook for ETOS_BUDGET_ACTION_HOOK, it is called in ISR
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @note  the demoted task gets its priority back when it pending
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_task_set_budget(etos_task_handle task_handle, u32 budget_ticks, etos_budget_action_e action,
+                         u32 demote_priority, pfunc_budget_hook hook);
+
+
+
+/**
+ * get task budget statistics.
+ *
+ * @param[in]    task_handle
+ * @param[out]   run_ticks      ticks the task has run in current activation, can be NULL
+ * @param[out]   overrun_cnt    total overrun count, can be NULL
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_task_get_budget_stat(etos_task_handle task_handle, u32 *run_ticks, u32 *overrun_cnt);
+
+
+
+/**
+ * resume a task suspended by budget overrun.
+ * the task gets a new activation, so its budget is enforced again after it is resumed
+ *
+ * @param[in]    task_handle
+ *
+ * @return
+ * @retval 0                   success
+ * @retval ETOS_RET_BUSY       the task is not suspended
+ * @retval other               fail
+ *
+ * @see        etos_task_set_budget()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_task_resume_suspended(etos_task_handle task_handle);
+
+
+
+/**
+ * report task statistics.
+ * print priority, state, budget and memory statistics of all tasks
+ *
+ * @param[in]    prompt   print header
+ *
+ * @return 0
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_task_report(const char *prompt);
+
+
+
 #endif  /* __ETOS_TASK_H__ */
 
 /* EOF */
@@ -0,0 +1,179 @@
+/******************************************************************************
+File    :  etos_trace.h
+
+This file is part of the ETOS distribution
+Copyright (c) 2026, ETOS Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+(version 2) as published by the Free Software Foundation. See
+the LICENSE file in the top-level directory for more details.
+
+Description:
+		binary trace ring buffer for ETOS kernel events
+		每个事件是一个固定长度的record，只写RAM，dump的时候才格式化输出
+
+History:
+
+Date           Author       Notes
+----------     -------      -------------------------
+2026-10-19     deeve        Create
+
+*******************************************************************************/
+#ifndef __ETOS_TRACE_H__
+#define __ETOS_TRACE_H__
+
+/******************************************************************************
+ *                                 Include Files                              *
+ ******************************************************************************/
+#include "etos_cfg.h"
+#include "etos_types.h"
+
+/******************************************************************************
+ *                                 Macros/Defines/Structures                  *
+ ******************************************************************************/
+
+#define ETOS_TRACE_VERSION            (1)
+
+/*task id in trace record, task base priority is used for normal task*/
+#define ETOS_TRACE_TASK_BOOT          (0xff)   /*boot code (idle)*/
+
+
+/*trace event define, do not change the value, host decoder depends on it*/
+#define ETOS_TRACE_EVT_SWITCH         (1)      /*task = from, arg = to task id*/
+#define ETOS_TRACE_EVT_READY          (2)      /*arg16 = resumed task id, arg = reason*/
+#define ETOS_TRACE_EVT_PEND           (3)      /*task = pending task, arg = reason*/
+#define ETOS_TRACE_EVT_ISR_ENTER      (4)      /*task = interrupted task*/
+#define ETOS_TRACE_EVT_ISR_EXIT       (5)      /*arg = isr return value*/
+#define ETOS_TRACE_EVT_MSGQ_SEND      (6)      /*arg = msg handle*/
+#define ETOS_TRACE_EVT_MSGQ_RECV      (7)      /*arg = msg handle*/
+#define ETOS_TRACE_EVT_MALLOC         (8)      /*arg16 = length, arg = pointer*/
+#define ETOS_TRACE_EVT_FREE           (9)      /*arg = pointer*/
+#define ETOS_TRACE_EVT_TASK_END       (10)     /*task = end task*/
+
+
+typedef struct _etos_trace_record {
+    u32 timestamp;     /*etos_sched_get_timestamp()*/
+    u8  event;         /*ETOS_TRACE_EVT_XXX*/
+    u8  task_id;       /*current task id*/
+    u16 arg16;
+    u32 arg;
+} etos_trace_record_t;
+
+
+#if (ETOS_TRACE_ENABLE)
+#define ETOS_TRACE(evt, a16, a)          etos_trace_record(evt, a16, a)
+#define ETOS_TRACE_IDIC(evt, a16, a)     etos_trace_record_idic(evt, a16, a)
+#else
+#define ETOS_TRACE(evt, a16, a)          ((void)0)
+#define ETOS_TRACE_IDIC(evt, a16, a)     ((void)0)
+#endif
+
+
+/******************************************************************************
+ *                                 Declar Functions                           *
+ ******************************************************************************/
+
+/**
+ * enable or disable trace.
+ * the record is dropped silently when trace is disabled
+ *
+ * @param[in]    enable    TRUE or FALSE
+ *
+ * @return   none
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+void etos_trace_enable(BOOL enable);
+
+
+
+/**
+ * clear trace ring buffer.
+ * reset write index and lost counter
+ *
+ * @param[in]    void
+ *
+ * @return   none
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+void etos_trace_reset(void);
+
+
+
+/**
+ * get trace task id.
+ * convert a task handle to the task id which is saved in trace record
+ *
+ * @param[in]    task_handle
+ *
+ * @return   task base priority, or ETOS_TRACE_TASK_BOOT if task_handle is 0
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+u8 etos_trace_task_id(etos_task_handle task_handle);
+
+
+
+/**
+ * record a trace event.
+ * write one record to trace ring buffer, the oldest record is overwritten
+ *
+ * @param[in]    event    ETOS_TRACE_EVT_XXX
+ * @param[in]    arg16    event argument
+ * @param[in]    arg      event argument
+ *
+ * @return   none
+ *
+ * @note  use ETOS_TRACE() instead of calling it directly
+ * @see   etos_trace_record_idic()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+void etos_trace_record(u8 event, u16 arg16, u32 arg);
+
+
+
+/**
+ * record a trace event in disable interrupt context.
+ * same as etos_trace_record(), but without critical section
+ *
+ * @param[in]    event    ETOS_TRACE_EVT_XXX
+ * @param[in]    arg16    event argument
+ * @param[in]    arg      event argument
+ *
+ * @return   none
+ *
+ * @note  use ETOS_TRACE_IDIC() instead of calling it directly
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+void etos_trace_record_idic(u8 event, u16 arg16, u32 arg);
+
+
+
+/**
+ * dump trace ring buffer.
+ * print all records from the oldest one as hex text lines,
+ * tools/etos_trace2json.py converts the output to chrome trace json
+ *
+ * @param[in]    output_handle    gioi handle, eg: xlog_get_output_handle()
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @note  trace is paused during dump
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_trace_dump(u32 output_handle);
+
+
+#endif  /* __ETOS_TRACE_H__ */
+
+/* EOF */
@@ -17,6 +17,8 @@ History:
 Date           Author       Notes
 ----------     -------      -------------------------
 2013-10-12     deeve        Create
+2026-10-19     deeve        Add timeout and busy return code
+2026-10-19     deeve        Add full return code
 
 *******************************************************************************/
 #ifndef __ETOS_TYPES_H__
@@ -59,12 +61,18 @@ Date           Author       Notes
 #define ETOS_NOT_SUPPORT             (-4)
 #define ETOS_NO_MEM                  (-8)
 #define ETOS_RET_FAIL                (-16)
+#define ETOS_RET_TIMEOUT             (-32)
+#define ETOS_RET_BUSY                (-64)
+#define ETOS_RET_FULL                (-128)
 
 
 typedef u32 etos_tick;
 typedef u32 etos_task_handle;
 
 
+#define ETOS_WAIT_FOREVER            (0xFFFFFFFF)   /*timeout ticks of blocking API*/
+
+
 
 /******************************************************************************
  *                                 Declar Functions                           *
@@ -0,0 +1,298 @@
+/******************************************************************************
+File    :  etos_waitq.h
+
+This file is part of the ETOS distribution
+Copyright (c) 2026, ETOS Development Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+(version 2) as published by the Free Software Foundation. See
+the LICENSE file in the top-level directory for more details.
+
+Description:
+		generic wait queue for all blocking objects
+		wait node嵌在tcb中(一个task同时只能等待一个对象)，按优先级排序，
+		队首是优先级最高的waiter; 超时由统一的按wakeup tick排序的timer list处理，
+		sleep就是不在任何wait queue上的超时等待
+
+History:
+
+Date           Author       Notes
+----------     -------      -------------------------
+2026-10-19     deeve        Create
+2026-10-19     deeve        Add etos_waitq_move_idic()
+
+*******************************************************************************/
+#ifndef __ETOS_WAITQ_H__
+#define __ETOS_WAITQ_H__
+
+/******************************************************************************
+ *                                 Include Files                              *
+ ******************************************************************************/
+#include "etos_cfg.h"
+#include "etos_types.h"
+#include "etos_listop.h"
+
+/******************************************************************************
+ *                                 Macros/Defines/Structures                  *
+ ******************************************************************************/
+
+struct _etos_tcb_t;
+struct _etos_waitq;
+
+/*
+ * it is called in tick ISR when a waiter of the queue times out, the waiter has been
+ * removed from the queue and it is resumed after the hook returns
+ */
+typedef void (*pfunc_waitq_timeout)(struct _etos_waitq *waitq, struct _etos_tcb_t *pt_os_task_tcb);
+
+
+typedef struct _etos_waitq {
+    list_t              list;             /*etos_wait_node_t, higher priority first*/
+    pfunc_waitq_timeout timeout_hook;     /*can be NULL*/
+} etos_waitq_t;
+
+
+typedef struct _etos_wait_node {
+    list_t              list;             /*in waitq*/
+    list_t              timer_list;       /*in timeout list, sorted by wakeup_tick*/
+    etos_waitq_t        *waitq;           /*NULL if it only waits timeout (sleep)*/
+    struct _etos_tcb_t  *pt_os_task_tcb;
+    u32                 priority;         /*waiting priority, the queue is sorted by it*/
+    u32                 reason;           /*etos_task_state_e pending reason*/
+    etos_tick           wakeup_tick;
+    s32                 result;           /*wake result, ETOS_RET_TIMEOUT if it times out*/
+    u32                 wait_arg;         /*object specific, eg: event bits to wait*/
+    u32                 wait_opt;         /*object specific, eg: event wait options*/
+    u32                 wake_value;       /*object specific, eg: event bits when it is woken up*/
+} etos_wait_node_t;
+
+
+/******************************************************************************
+ *                                 Declar Functions                           *
+ ******************************************************************************/
+
+/**
+ * init a wait queue.
+ *
+ * @param[in]    waitq
+ * @param[in]    timeout_hook    called when a waiter times out, can be NULL
+ *
+ * @return   none
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+void etos_waitq_init(etos_waitq_t *waitq, pfunc_waitq_timeout timeout_hook);
+
+
+
+/**
+ * check whether any task is waiting in the queue.
+ *
+ * @param[in]    waitq
+ *
+ * @return   TRUE or FALSE
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+BOOL etos_waitq_is_empty(etos_waitq_t *waitq);
+
+
+
+/**
+ * queue current task on a wait queue in disable interrupt context.
+ * the task is queued by its current priority and the timeout starts, but it is not pended,
+ * it is used when the object needs to do something between queue and pend,
+ * eg: priority inheritance of mutex
+ *
+ * @param[in]    waitq            NULL: only wait timeout, eg: sleep
+ * @param[in]    reason           ETOS_TASK_PENDING_XXX
+ * @param[in]    timeout_ticks    ETOS_WAIT_FOREVER: no timeout
+ * @param[in]    wait_arg         object specific, saved in wait node
+ * @param[in]    wait_opt         object specific, saved in wait node
+ *
+ * @return   wait node of current task, NULL if it is not called in a task
+ *
+ * @note   etos_waitq_wait_idic() must be called after it without enabling interrupt
+ * @see    etos_waitq_wait_idic()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+etos_wait_node_t *etos_waitq_prepare_idic(etos_waitq_t *waitq, u32 reason, u32 timeout_ticks,
+                                          u32 wait_arg, u32 wait_opt);
+
+
+
+/**
+ * pend current task which is queued by etos_waitq_prepare_idic().
+ *
+ * @param[in]    pt_node    returned by etos_waitq_prepare_idic()
+ *
+ * @return   wake result
+ * @retval ETOS_RET_TIMEOUT   timeout
+ * @retval other              the result given by waker
+ *
+ * @see    etos_waitq_prepare_idic()
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_waitq_wait_idic(etos_wait_node_t *pt_node);
+
+
+
+/**
+ * pend current task on a wait queue in disable interrupt context.
+ * the task is queued by its current priority and pended until it is woken up or timeout
+ *
+ * @param[in]    waitq            NULL: only wait timeout, eg: sleep
+ * @param[in]    reason           ETOS_TASK_PENDING_XXX
+ * @param[in]    timeout_ticks    ETOS_WAIT_FOREVER: no timeout
+ * @param[in]    wait_arg         object specific, saved in wait node
+ * @param[in]    wait_opt         object specific, saved in wait node
+ *
+ * @return   wake result
+ * @retval ETOS_RET_TIMEOUT   timeout
+ * @retval other              the result given by waker
+ *
+ * @note   it can not be called in ISR, etos_waitq_get_node() gets wake_value after it returns
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_waitq_pend_idic(etos_waitq_t *waitq, u32 reason, u32 timeout_ticks, u32 wait_arg, u32 wait_opt);
+
+
+
+/**
+ * get the wait node of a task.
+ *
+ * @param[in]    task_handle
+ *
+ * @return   wait node, NULL if the task handle is invalid
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+etos_wait_node_t *etos_waitq_get_node(etos_task_handle task_handle);
+
+
+
+/**
+ * get the highest priority waiter in disable interrupt context.
+ *
+ * @param[in]    waitq
+ *
+ * @return   wait node, NULL if there is no waiter
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+etos_wait_node_t *etos_waitq_peek_idic(etos_waitq_t *waitq);
+
+
+
+/**
+ * wake up a waiter in disable interrupt context.
+ * remove it from the wait queue and timeout list, then resume it
+ *
+ * @param[in]    pt_node      the waiter
+ * @param[in]    result       returned by etos_waitq_pend_idic()
+ * @param[in]    wake_value   object specific value for the waiter
+ *
+ * @return
+ * @retval 0       success
+ * @retval other   fail
+ *
+ * @note   it can be called in ISR
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+s32 etos_waitq_wake_node_idic(etos_wait_node_t *pt_node, s32 result, u32 wake_value);
+
+
+
+/**
+ * wake up the highest priority waiter in disable interrupt context.
+ *
+ * @param[in]    waitq
+ * @param[in]    result       returned by etos_waitq_pend_idic()
+ * @param[in]    wake_value   object specific value for the waiter
+ *
+ * @return   the woken task, 0 if there is no waiter
+ *
+ * @note   it can be called in ISR
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+etos_task_handle etos_waitq_wake_one_idic(etos_waitq_t *waitq, s32 result, u32 wake_value);
+
+
+
+/**
+ * wake up all waiters in disable interrupt context.
+ *
+ * @param[in]    waitq
+ * @param[in]    result       returned by etos_waitq_pend_idic()
+ * @param[in]    wake_value   object specific value for the waiters
+ *
+ * @return   the number of woken tasks
+ *
+ * @note   it can be called in ISR
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+u32 etos_waitq_wake_all_idic(etos_waitq_t *waitq, s32 result, u32 wake_value);
+
+
+
+/**
+ * change the waiting priority of a waiter in disable interrupt context.
+ * the waiter is requeued by the new priority
+ *
+ * @param[in]    pt_node
+ * @param[in]    priority
+ *
+ * @return   none
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+void etos_waitq_requeue_idic(etos_wait_node_t *pt_node, u32 priority);
+
+
+
+/**
+ * move a waiter to another wait queue in disable interrupt context.
+ * the task keeps pending and its timeout is not changed
+ *
+ * @param[in]    pt_node
+ * @param[in]    waitq      NULL: the waiter is not in any wait queue, it is only woken by etos_waitq_wake_node_idic()
+ *
+ * @return   none
+ *
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+void etos_waitq_move_idic(etos_wait_node_t *pt_node, etos_waitq_t *waitq);
+
+
+
+/**
+ * update tick for wait queue timeout in interrupt service routine.
+ * the waiters which time out are resumed with ETOS_RET_TIMEOUT
+ *
+ * @param[in]    current_tick
+ *
+ * @return   none
+ *
+ * @note   it is called in tick ISR
+ * @authors    deeve
+ * @date       2026/10/19
+ */
+void etos_waitq_update_tick_in_isr(etos_tick current_tick);
+
+
+#endif  /* __ETOS_WAITQ_H__ */
+
+/* EOF */
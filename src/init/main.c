@@ -17,6 +17,12 @@ History:
 Date           Author       Notes
 ----------     -------      -------------------------
 2015-2-13      deeve        Create
+2026-10-19     deeve        Register timestamp source
+2026-10-19     deeve        Run dispatcher as sporadic server
+2026-10-19     deeve        Dispatcher subscribes uart rx on bus
+2026-10-19     deeve        Run commands in command actor task
+2026-10-19     deeve        Add buddy memory pool, fewer 2K/4K fixed blocks
+2026-10-19     deeve        Place memory pool after the image, stop if it reaches boot stack
 
 *******************************************************************************/
 
@@ -36,14 +42,25 @@ Date           Author       Notes
 #define mb() __asm__ __volatile__ ("" : : : "memory")
 
 
-#define MEM_FREE_START_ADDR            (TEXT_BASE + 0x10000)  /*65k*/
+#define MEM_FREE_START_ALIGN           (4096)  /*memory pool starts at the first page after the image(_end)*/
+#define MEM_BUDDY_LEN                  (512 * 1024)  /*buddy pool after fixed block size pool*/
+
+#define DISPATCH_PRIORITY              (25)
+#define CMD_PRIORITY                   (26)
+
+/*command actor sporadic server: 2 ticks(~32ms) at priority 26 in each 16 ticks(~256ms)*/
+#define CMD_CAPACITY_TICKS             (2)
+#define CMD_PERIOD_TICKS               (16)
+#define CMD_LOW_PRIORITY               (1)
 
 /******************************************************************************
  *                                 Global Variables                           *
  ******************************************************************************/
 
 
+extern s32 input_dispatcher_init(void);
 extern void *input_task_dispatcher_main(void *arg);
+extern void *input_task_cmd_main(void *arg);
 
 extern u32 g_os_running_task_num;
 
@@ -64,15 +81,13 @@ static mem_pool_item_t _mem_pool_items[] = {
     {256,  512},
     {512,  256},
     {1024, 128},
-    {2048, 64},
-    {4096, 32},
+    {2048, 32},
+    {4096, 16},
     {0, 0} /*end flag*/
 };
 
 u32 g_count_num;
 
-etos_msg_handle g_msg_handle_dispatcher;
-
 /******************************************************************************
  *                                 Local Functions                            *
  ******************************************************************************/
@@ -111,9 +126,11 @@ void count_to_delay(u32 val)
  ******************************************************************************/
 void main(void)
 {
+    u8 *mem_pool_start;
     u8 *mem_pool_end;
     s32 ret;
     etos_task_handle dispatch_task_handle;
+    etos_task_handle cmd_task_handle;
 
     mb();
 
@@ -129,12 +146,23 @@ void main(void)
 
     xlogw(LOG_MODULE_BOOT, "etos-%u.%u build@%s\r\n", ETOS_VERSION_MAIN, ETOS_VERSION_SUB, build_time);
 
-    if (MEM_FREE_START_ADDR <= (u32)(&_end)) {
-        xlogf_d(LOG_MODULE_BOOT, "need adjust free memory address\r\n");
+    /*the image grows with the features, so the pool follows it instead of a fixed address*/
+    mem_pool_start = (u8 *)n_bits_align_up(&_end, MEM_FREE_START_ALIGN);
+
+    ret = etos_mem_pool_init(mem_pool_start, _mem_pool_items, &mem_pool_end);
+    if (ret || ((u32)mem_pool_end > (OS_BOOT_STACK - OS_BOOT_STACK_LEN))) {
+        panic(xlog_get_output_handle(), "mem pool(0x%x-0x%x) err:%d, stack_end(0x%x)\r\n",
+              mem_pool_start, mem_pool_end, ret, OS_BOOT_STACK - OS_BOOT_STACK_LEN);
     }
 
-    etos_mem_pool_init((u8 *)(MEM_FREE_START_ADDR), _mem_pool_items, &mem_pool_end);
-    xlogt(LOG_MODULE_BOOT, "mem_pool_end(0x%x) < stack_end(0x%x)\r\n", mem_pool_end, OS_BOOT_STACK - OS_BOOT_STACK_LEN);
+    if (((u32)mem_pool_end + MEM_BUDDY_LEN <= (OS_BOOT_STACK - OS_BOOT_STACK_LEN))
+        && (etos_mem_buddy_init(mem_pool_end, mem_pool_end + MEM_BUDDY_LEN) == ETOS_RET_OK)) {
+        mem_pool_end += MEM_BUDDY_LEN;
+    } else {
+        xloge(LOG_MODULE_BOOT, "no buddy pool after 0x%x\r\n", mem_pool_end);
+    }
+    xlogt(LOG_MODULE_BOOT, "_end(0x%x) mem_pool(0x%x-0x%x) < stack_end(0x%x)\r\n", &_end, mem_pool_start,
+          mem_pool_end, OS_BOOT_STACK - OS_BOOT_STACK_LEN);
 
     ret = uart_startup(PORT_0_UART_0);
     xlogt(LOG_MODULE_BOOT, "ret=%d, intmask=0x%x\r\n", ret, REG(INTMSK));
@@ -143,17 +171,29 @@ void main(void)
 
     timer_hw_config_timer(4);
     timer_hw_start_timer(4);
+    etos_sched_register_timestamp(timer_hw_get_timestamp, timer_hw_get_timestamp_freq());
 
     etos_enable_cpu_interrupt();
 
     etos_task_init();
 
-    ret = etos_msgq_create(0, &g_msg_handle_dispatcher);
-
+    ret = input_dispatcher_init();
     if (ret) {
-        xloge(LOG_MODULE_BOOT, "create msg err:%d\r\n", ret);
+        xloge(LOG_MODULE_BOOT, "init dispatcher err:%d\r\n", ret);
     } else {
-        ret = etos_task_create("DISPCH", 25, input_task_dispatcher_main, NULL, 1024, &dispatch_task_handle);
+        ret = etos_task_create("CMD", CMD_PRIORITY, input_task_cmd_main, NULL, 1024, &cmd_task_handle);
+        if (ret) {
+            xloge(LOG_MODULE_BOOT, "create task err:%d\r\n", ret);
+        } else {
+            /*bound the interference of command burst, run at background priority after capacity exhausted*/
+            ret = etos_sporadic_set(cmd_task_handle, CMD_CAPACITY_TICKS, CMD_PERIOD_TICKS, CMD_LOW_PRIORITY);
+            if (ret) {
+                xloge(LOG_MODULE_BOOT, "set sporadic server err:%d\r\n", ret);
+            }
+        }
+
+        ret = etos_task_create("DISPCH", DISPATCH_PRIORITY, input_task_dispatcher_main, NULL, 1024,
+                               &dispatch_task_handle);
         if (ret) {
             xloge(LOG_MODULE_BOOT, "create task err:%d\r\n", ret);
         }
@@ -0,0 +1,224 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# File    :  etos_prof.py
+#
+# This file is part of the ETOS distribution
+# Copyright (c) 2026, ETOS Development Team
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU General Public License
+# (version 2) as published by the Free Software Foundation. See
+# the LICENSE file in the top-level directory for more details.
+#
+# Description:
+#       map the samples of etos_prof_dump() (uart "prof:dump" command)
+#       to functions, output flat profile and per task profile
+#
+# Usage:
+#       python etos_prof.py uart.log --map etos.elf.map
+#       python etos_prof.py uart.log --elf etos.elf [--nm arm-linux-nm]
+#       python etos_prof.py uart.log --nm-output nm.txt     (output of nm -n etos.elf)
+#
+#       the symbols from nm include static functions, the map file only has
+#       global symbols, the samples in static functions are reported as <file.o>
+#
+# History:
+#
+# Date           Author       Notes
+# ----------     -------      -------------------------
+# 2026-10-19     deeve        Create
+#
+
+import re
+import sys
+import bisect
+import argparse
+import subprocess
+
+TASK_BOOT = 0xff
+
+RECORD_RE = re.compile(r"\b(EPRF|EPN|EPS)\s")
+MAP_SECTION_RE = re.compile(r"^\s*(\.text\S*)?\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S+\.o\S*)\s*$")
+MAP_SYMBOL_RE = re.compile(r"^\s+0x([0-9a-fA-F]+)\s+([A-Za-z_][\w\.]*)\s*$")
+NM_RE = re.compile(r"^([0-9a-fA-F]+)\s+([tTwW])\s+(\S+)\s*$")
+
+
+def parse_dump(lines):
+    """return (rate, dropped, task names, samples) of the last dump in lines"""
+    rate, dropped = 0, 0
+    names = {}
+    samples = []
+    in_dump = False
+
+    for line in lines:
+        match = RECORD_RE.search(line)
+        if match is None:
+            continue
+        fields = line[match.start():].split()
+
+        if fields[0] == "EPRF":
+            if len(fields) > 1 and fields[1] == "END":
+                in_dump = False
+            elif len(fields) >= 5:
+                rate, dropped = int(fields[2]), int(fields[4])
+                names = {}
+                samples = []
+                in_dump = True
+        elif not in_dump:
+            continue
+        elif fields[0] == "EPN" and len(fields) >= 3:
+            names[int(fields[1])] = fields[2]
+        elif fields[0] == "EPS" and len(fields) >= 3:
+            samples.append((int(fields[1], 16), int(fields[2])))
+
+    return rate, dropped, names, samples
+
+
+class SymbolTable(object):
+    def __init__(self):
+        self.symbols = []     # (addr, name)
+        self.sections = []    # (addr, end, object file)
+
+    def finish(self):
+        self.symbols.sort()
+        self.sections.sort()
+        self.sym_addrs = [s[0] for s in self.symbols]
+        self.sec_addrs = [s[0] for s in self.sections]
+
+    def _section(self, pc):
+        i = bisect.bisect_right(self.sec_addrs, pc) - 1
+        if i >= 0 and pc < self.sections[i][1]:
+            return self.sections[i]
+        return None
+
+    def lookup(self, pc):
+        i = bisect.bisect_right(self.sym_addrs, pc) - 1
+        section = self._section(pc)
+        if i >= 0:
+            addr, name = self.symbols[i]
+            # the nearest symbol must be in the same input section (map file)
+            if section is None or addr >= section[0]:
+                return name
+        if section is not None:
+            return "<%s>" % section[2].split("/")[-1]
+        return "<0x%08x>" % pc
+
+
+def load_map(path):
+    table = SymbolTable()
+    in_text = False
+    pending_section = None
+    with open(path, "r") as f:
+        for line in f:
+            if line.startswith(".text"):
+                in_text = True
+            elif line.startswith(".") and not line.startswith(".text"):
+                in_text = False
+            if not in_text:
+                continue
+
+            # long section name is printed in its own line
+            stripped = line.strip()
+            if stripped.startswith(".text") and len(stripped.split()) == 1:
+                pending_section = stripped
+                continue
+
+            match = MAP_SECTION_RE.match(line)
+            if match and (match.group(1) or pending_section):
+                addr, size = int(match.group(2), 16), int(match.group(3), 16)
+                if size:
+                    table.sections.append((addr, addr + size, match.group(4)))
+                pending_section = None
+                continue
+            pending_section = None
+
+            match = MAP_SYMBOL_RE.match(line)
+            if match:
+                table.symbols.append((int(match.group(1), 16), match.group(2)))
+    table.finish()
+    return table
+
+
+def load_nm(lines):
+    table = SymbolTable()
+    for line in lines:
+        match = NM_RE.match(line)
+        if match:
+            table.symbols.append((int(match.group(1), 16), match.group(3)))
+    table.finish()
+    return table
+
+
+def task_name(names, task_id):
+    if task_id == TASK_BOOT:
+        return "boot/idle"
+    return names.get(task_id, "task%d" % task_id)
+
+
+def print_profile(title, counter, total, top):
+    sys.stdout.write("\n%s (%d samples)\n" % (title, total))
+    sys.stdout.write("  %8s %7s  %s\n" % ("samples", "%", "function"))
+    items = sorted(counter.items(), key=lambda x: (-x[1], x[0]))
+    for name, cnt in items[:top]:
+        sys.stdout.write("  %8d %6.2f%%  %s\n" % (cnt, cnt * 100.0 / total, name))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="etos PC sampling profile")
+    parser.add_argument("input", help="uart log which contains the output of prof:dump")
+    parser.add_argument("--map", help="linker map file, eg: etos.elf.map")
+    parser.add_argument("--elf", help="elf file, symbols are read by nm")
+    parser.add_argument("--nm", default="arm-linux-nm", help="nm tool used with --elf")
+    parser.add_argument("--nm-output", help="saved output of 'nm -n etos.elf'")
+    parser.add_argument("--top", type=int, default=30, help="show top N functions")
+    args = parser.parse_args()
+
+    if args.nm_output:
+        with open(args.nm_output, "r") as f:
+            table = load_nm(f.readlines())
+    elif args.elf:
+        output = subprocess.check_output([args.nm, "-n", args.elf])
+        table = load_nm(output.decode("utf-8", "replace").splitlines())
+    elif args.map:
+        table = load_map(args.map)
+    else:
+        parser.error("one of --map, --elf, --nm-output is required")
+
+    with open(args.input, "r") as f:
+        rate, dropped, names, samples = parse_dump(f.readlines())
+
+    if not samples:
+        sys.stderr.write("no sample found\n")
+        return 1
+
+    total = len(samples)
+    sys.stdout.write("%d samples, %d dropped, rate=%dHz, ~%.2fs\n"
+                     % (total, dropped, rate, float(total) / rate if rate else 0))
+
+    flat = {}
+    per_task = {}
+    for pc, task in samples:
+        func = table.lookup(pc)
+        flat[func] = flat.get(func, 0) + 1
+        task_counter = per_task.setdefault(task, {})
+        task_counter[func] = task_counter.get(func, 0) + 1
+
+    print_profile("flat profile", flat, total, args.top)
+
+    tasks = sorted(per_task.items(), key=lambda x: -sum(x[1].values()))
+    sys.stdout.write("\ntask summary\n")
+    for task, counter in tasks:
+        cnt = sum(counter.values())
+        sys.stdout.write("  %8d %6.2f%%  %s(%d)\n"
+                         % (cnt, cnt * 100.0 / total, task_name(names, task), task))
+
+    for task, counter in tasks:
+        print_profile("task %s(%d)" % (task_name(names, task), task), counter,
+                      sum(counter.values()), args.top)
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,201 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# File    :  etos_trace2json.py
+#
+# This file is part of the ETOS distribution
+# Copyright (c) 2026, ETOS Development Team
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU General Public License
+# (version 2) as published by the Free Software Foundation. See
+# the LICENSE file in the top-level directory for more details.
+#
+# Description:
+#       convert the output of etos_trace_dump() (uart "trace:dump" command)
+#       to chrome trace json, open it in chrome://tracing or ui.perfetto.dev
+#
+# Usage:
+#       python etos_trace2json.py uart.log [-o trace.json]
+#
+# History:
+#
+# Date           Author       Notes
+# ----------     -------      -------------------------
+# 2026-10-19     deeve        Create
+#
+
+import re
+import sys
+import json
+import argparse
+
+# keep the same as etos_trace.h
+EVT_SWITCH = 1
+EVT_READY = 2
+EVT_PEND = 3
+EVT_ISR_ENTER = 4
+EVT_ISR_EXIT = 5
+EVT_MSGQ_SEND = 6
+EVT_MSGQ_RECV = 7
+EVT_MALLOC = 8
+EVT_FREE = 9
+EVT_TASK_END = 10
+
+TASK_BOOT = 0xff
+TID_ISR = 1000
+PID = 1
+
+RECORD_RE = re.compile(r"\b(ETRC|ETN|ETR)\s")
+
+INSTANT_NAMES = {
+    EVT_READY: "ready",
+    EVT_PEND: "pend",
+    EVT_MSGQ_SEND: "msgq_send",
+    EVT_MSGQ_RECV: "msgq_recv",
+    EVT_MALLOC: "malloc",
+    EVT_FREE: "free",
+    EVT_TASK_END: "task_end",
+}
+
+
+def parse_dump(lines):
+    """return (freq, lost, task names, records) of the last dump in lines"""
+    freq, lost = 0, 0
+    names = {}
+    records = []
+    in_dump = False
+
+    for line in lines:
+        # the uart log may have prefix, eg: timestamp of serial tool
+        match = RECORD_RE.search(line)
+        if match is None:
+            continue
+        fields = line[match.start():].split()
+
+        if fields[0] == "ETRC":
+            if len(fields) > 1 and fields[1] == "END":
+                in_dump = False
+            elif len(fields) >= 5:
+                freq, lost = int(fields[2]), int(fields[4])
+                names = {}
+                records = []
+                in_dump = True
+        elif not in_dump:
+            continue
+        elif fields[0] == "ETN" and len(fields) >= 3:
+            names[int(fields[1])] = fields[2]
+        elif fields[0] == "ETR" and len(fields) >= 6:
+            records.append((int(fields[1], 16), int(fields[2]), int(fields[3]),
+                            int(fields[4], 16), int(fields[5], 16)))
+
+    return freq, lost, names, records
+
+
+def unwrap_timestamp(records):
+    """32 bits timestamp wraps around, convert it to a monotonic 64 bits value"""
+    result = []
+    base, last = 0, None
+    for ts, evt, task, arg16, arg in records:
+        if last is not None and ts < last and (last - ts) > 0x80000000:
+            base += 1 << 32
+        last = ts
+        result.append((base + ts, evt, task, arg16, arg))
+    return result
+
+
+def task_name(names, task_id):
+    if task_id == TASK_BOOT:
+        return "boot/idle"
+    return names.get(task_id, "task%d" % task_id)
+
+
+def to_chrome_trace(freq, lost, names, records):
+    events = []
+    us_per_count = 1000000.0 / freq if freq else 1.0
+
+    def ts_us(ts):
+        return (ts - records[0][0]) * us_per_count
+
+    tids = set([TASK_BOOT])
+    for rec in records:
+        tids.add(rec[2])
+    for tid in tids:
+        events.append({"name": "thread_name", "ph": "M", "pid": PID, "tid": tid,
+                       "args": {"name": "%s(%d)" % (task_name(names, tid), tid)}})
+        # show high priority task at the top
+        events.append({"name": "thread_sort_index", "ph": "M", "pid": PID, "tid": tid,
+                       "args": {"sort_index": -tid if tid != TASK_BOOT else 1}})
+    events.append({"name": "thread_name", "ph": "M", "pid": PID, "tid": TID_ISR,
+                   "args": {"name": "ISR"}})
+    events.append({"name": "thread_sort_index", "ph": "M", "pid": PID, "tid": TID_ISR,
+                   "args": {"sort_index": -1000}})
+
+    running = None
+    isr_begin = None
+    for ts, evt, task, arg16, arg in records:
+        t = ts_us(ts)
+        if running is None:
+            running = task
+            events.append({"name": "run", "ph": "B", "pid": PID, "tid": running, "ts": t})
+
+        if evt == EVT_SWITCH:
+            if running != task:
+                # lost records, close the wrong slice
+                events.append({"name": "run", "ph": "E", "pid": PID, "tid": running, "ts": t})
+                events.append({"name": "run", "ph": "B", "pid": PID, "tid": task, "ts": t})
+            events.append({"name": "run", "ph": "E", "pid": PID, "tid": task, "ts": t,
+                           "args": {"to": task_name(names, arg)}})
+            running = arg
+            events.append({"name": "run", "ph": "B", "pid": PID, "tid": running, "ts": t,
+                           "args": {"from": task_name(names, task)}})
+        elif evt == EVT_ISR_ENTER:
+            isr_begin = t
+        elif evt == EVT_ISR_EXIT:
+            if isr_begin is not None:
+                events.append({"name": "isr", "ph": "X", "pid": PID, "tid": TID_ISR,
+                               "ts": isr_begin, "dur": t - isr_begin,
+                               "args": {"interrupted": task_name(names, task), "ret": arg}})
+            isr_begin = None
+        elif evt in INSTANT_NAMES:
+            args = {"arg": "0x%08x" % arg}
+            if evt == EVT_READY:
+                args = {"task": task_name(names, arg16), "reason": "0x%x" % arg}
+            elif evt == EVT_PEND:
+                args = {"reason": "0x%x" % arg}
+            elif evt == EVT_MALLOC:
+                args = {"len": arg16, "ptr": "0x%08x" % arg}
+            events.append({"name": INSTANT_NAMES[evt], "ph": "i", "s": "t", "pid": PID,
+                           "tid": task, "ts": t, "args": args})
+
+    if records and running is not None:
+        events.append({"name": "run", "ph": "E", "pid": PID, "tid": running,
+                       "ts": ts_us(records[-1][0])})
+
+    return {"traceEvents": events, "displayTimeUnit": "ns",
+            "otherData": {"timestamp_freq": freq, "lost_records": lost}}
+
+
+def main():
+    parser = argparse.ArgumentParser(description="convert etos trace dump to chrome trace json")
+    parser.add_argument("input", help="uart log which contains the output of trace:dump")
+    parser.add_argument("-o", "--output", default="etos_trace.json", help="output json file")
+    args = parser.parse_args()
+
+    with open(args.input, "r") as f:
+        freq, lost, names, records = parse_dump(f.readlines())
+
+    if not records:
+        sys.stderr.write("no trace record found\n")
+        return 1
+
+    records = unwrap_timestamp(records)
+    with open(args.output, "w") as f:
+        json.dump(to_chrome_trace(freq, lost, names, records), f, indent=1)
+
+    sys.stdout.write("%d records, %d lost, freq=%dHz -> %s\n" % (len(records), lost, freq, args.output))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())